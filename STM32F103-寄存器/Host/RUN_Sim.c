@@ -0,0 +1,1826 @@
+#define _GNU_SOURCE
+#include <signal.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <ucontext.h>
+#include <unistd.h>
+
+#include "RUN_Sim.h"
+
+// ===============================================================================
+// ԭ
+// -------------------------------------------------------------------------------
+// 1. /ںͬһ memfd ӳΣ
+//    - ̶ַ (0x40000000 / 0xE0000000) ӳƽʱΪ PROT_NONEʼ SIGSEGV
+//    - һ˽еַӳʼտɶдͨдĴᴥ쳣
+// 2. SIGSEGV Уƽʱ䡢ˢ¶ֵ (IDR/CNT/VAL...)ʱſҳ TF ־
+//    SIGTRAP Уִָϣ±ҳĴ崦д/
+//    (BSRR λλIFCR д 1 㡢 DR  RXNE ...)ɷжϡ
+// 3. ʱΪɢ¼ÿ"һ¼ʱ"ʻתʱʱ˳
+// 4. ֧ 64 λ Linux ҿִļ -no-pie ӣ
+//    ̬/ȫַֻ < 4GB MCU  uint32_t  DMA
+// ===============================================================================
+
+#define SIM_PERIPH_BASE   0x40000000u
+#define SIM_PERIPH_SIZE   0x00024000u          // APB1 + APB2 + AHB(DMA/RCC/FLASH/CRC)
+#define SIM_SCS_BASE      0xE0000000u          // ں˽ (DWT / SysTick / NVIC / SCB)
+#define SIM_SCS_SIZE      0x00010000u
+#define SIM_BB_BASE       0x42000000u
+#define SIM_BB_SIZE       (SIM_PERIPH_SIZE * 32)
+#define SIM_FLASH_BASE    0x08000000u
+#define SIM_FLASH_SIZE    0x00080000u          // ZET6: 512KB
+#define SIM_FLASH_PAGE    2048u
+
+#define SIM_PAGE          4096u
+#define SIM_NEVER         UINT64_MAX
+#define SIM_PS_PER_S      1000000000000ULL
+#define SIM_IRQ_NUM       60                   // STM32F10X_HD ж
+#define SIM_IRQ_SYSTICK   (-1)
+
+// ===============================================================================
+// ж ( startup_stm32f10x_hd.s ͬδʵֵ嶵)
+// ===============================================================================
+static void sim_default_handler(void) {}
+
+#define SIM_WEAK(name) void name(void) __attribute__((weak, alias("sim_default_handler")));
+SIM_WEAK(SysTick_Handler)
+SIM_WEAK(WWDG_IRQHandler)           SIM_WEAK(PVD_IRQHandler)            SIM_WEAK(TAMPER_IRQHandler)
+SIM_WEAK(RTC_IRQHandler)            SIM_WEAK(FLASH_IRQHandler)          SIM_WEAK(RCC_IRQHandler)
+SIM_WEAK(EXTI0_IRQHandler)          SIM_WEAK(EXTI1_IRQHandler)          SIM_WEAK(EXTI2_IRQHandler)
+SIM_WEAK(EXTI3_IRQHandler)          SIM_WEAK(EXTI4_IRQHandler)
+SIM_WEAK(DMA1_Channel1_IRQHandler)  SIM_WEAK(DMA1_Channel2_IRQHandler)  SIM_WEAK(DMA1_Channel3_IRQHandler)
+SIM_WEAK(DMA1_Channel4_IRQHandler)  SIM_WEAK(DMA1_Channel5_IRQHandler)  SIM_WEAK(DMA1_Channel6_IRQHandler)
+SIM_WEAK(DMA1_Channel7_IRQHandler)  SIM_WEAK(ADC1_2_IRQHandler)         SIM_WEAK(USB_HP_CAN1_TX_IRQHandler)
+SIM_WEAK(USB_LP_CAN1_RX0_IRQHandler) SIM_WEAK(CAN1_RX1_IRQHandler)      SIM_WEAK(CAN1_SCE_IRQHandler)
+SIM_WEAK(EXTI9_5_IRQHandler)        SIM_WEAK(TIM1_BRK_IRQHandler)       SIM_WEAK(TIM1_UP_IRQHandler)
+SIM_WEAK(TIM1_TRG_COM_IRQHandler)   SIM_WEAK(TIM1_CC_IRQHandler)        SIM_WEAK(TIM2_IRQHandler)
+SIM_WEAK(TIM3_IRQHandler)           SIM_WEAK(TIM4_IRQHandler)           SIM_WEAK(I2C1_EV_IRQHandler)
+SIM_WEAK(I2C1_ER_IRQHandler)        SIM_WEAK(I2C2_EV_IRQHandler)        SIM_WEAK(I2C2_ER_IRQHandler)
+SIM_WEAK(SPI1_IRQHandler)           SIM_WEAK(SPI2_IRQHandler)           SIM_WEAK(USART1_IRQHandler)
+SIM_WEAK(USART2_IRQHandler)         SIM_WEAK(USART3_IRQHandler)         SIM_WEAK(EXTI15_10_IRQHandler)
+SIM_WEAK(RTCAlarm_IRQHandler)       SIM_WEAK(USBWakeUp_IRQHandler)      SIM_WEAK(TIM8_BRK_IRQHandler)
+SIM_WEAK(TIM8_UP_IRQHandler)        SIM_WEAK(TIM8_TRG_COM_IRQHandler)   SIM_WEAK(TIM8_CC_IRQHandler)
+SIM_WEAK(ADC3_IRQHandler)           SIM_WEAK(FSMC_IRQHandler)           SIM_WEAK(SDIO_IRQHandler)
+SIM_WEAK(TIM5_IRQHandler)           SIM_WEAK(SPI3_IRQHandler)           SIM_WEAK(UART4_IRQHandler)
+SIM_WEAK(UART5_IRQHandler)          SIM_WEAK(TIM6_IRQHandler)           SIM_WEAK(TIM7_IRQHandler)
+SIM_WEAK(DMA2_Channel1_IRQHandler)  SIM_WEAK(DMA2_Channel2_IRQHandler)  SIM_WEAK(DMA2_Channel3_IRQHandler)
+SIM_WEAK(DMA2_Channel4_5_IRQHandler)
+
+static void (* const sim_vector[SIM_IRQ_NUM])(void) = {
+    WWDG_IRQHandler, PVD_IRQHandler, TAMPER_IRQHandler, RTC_IRQHandler, FLASH_IRQHandler,
+    RCC_IRQHandler, EXTI0_IRQHandler, EXTI1_IRQHandler, EXTI2_IRQHandler, EXTI3_IRQHandler,
+    EXTI4_IRQHandler, DMA1_Channel1_IRQHandler, DMA1_Channel2_IRQHandler, DMA1_Channel3_IRQHandler,
+    DMA1_Channel4_IRQHandler, DMA1_Channel5_IRQHandler, DMA1_Channel6_IRQHandler,
+    DMA1_Channel7_IRQHandler, ADC1_2_IRQHandler, USB_HP_CAN1_TX_IRQHandler,
+    USB_LP_CAN1_RX0_IRQHandler, CAN1_RX1_IRQHandler, CAN1_SCE_IRQHandler, EXTI9_5_IRQHandler,
+    TIM1_BRK_IRQHandler, TIM1_UP_IRQHandler, TIM1_TRG_COM_IRQHandler, TIM1_CC_IRQHandler,
+    TIM2_IRQHandler, TIM3_IRQHandler, TIM4_IRQHandler, I2C1_EV_IRQHandler, I2C1_ER_IRQHandler,
+    I2C2_EV_IRQHandler, I2C2_ER_IRQHandler, SPI1_IRQHandler, SPI2_IRQHandler, USART1_IRQHandler,
+    USART2_IRQHandler, USART3_IRQHandler, EXTI15_10_IRQHandler, RTCAlarm_IRQHandler,
+    USBWakeUp_IRQHandler, TIM8_BRK_IRQHandler, TIM8_UP_IRQHandler, TIM8_TRG_COM_IRQHandler,
+    TIM8_CC_IRQHandler, ADC3_IRQHandler, FSMC_IRQHandler, SDIO_IRQHandler, TIM5_IRQHandler,
+    SPI3_IRQHandler, UART4_IRQHandler, UART5_IRQHandler, TIM6_IRQHandler, TIM7_IRQHandler,
+    DMA2_Channel1_IRQHandler, DMA2_Channel2_IRQHandler, DMA2_Channel3_IRQHandler,
+    DMA2_Channel4_5_IRQHandler
+};
+
+// ===============================================================================
+// Ĵļʱ
+// ===============================================================================
+static uint8_t* sim_periph_view;   // ķͼ (쳣)
+static uint8_t* sim_scs_view;      // ںķͼ
+
+static uint64_t sim_now_ps;        // ǰʱ (Ƥ)
+static uint64_t sim_cycle;         // ǰʱ (HCLK )
+static unsigned __int128 sim_cycle_rem;
+
+static uint32_t sim_sysclk_hz, sim_hclk_hz, sim_pclk1_hz, sim_pclk2_hz, sim_adcclk_hz;
+static RUN_sim_stat_t sim_stat;
+
+static void* sim_ptr(uint32_t addr)
+{
+    if (addr >= SIM_PERIPH_BASE && addr < SIM_PERIPH_BASE + SIM_PERIPH_SIZE)
+        return sim_periph_view + (addr - SIM_PERIPH_BASE);
+    if (addr >= SIM_SCS_BASE && addr < SIM_SCS_BASE + SIM_SCS_SIZE)
+        return sim_scs_view + (addr - SIM_SCS_BASE);
+    return (void*)(uintptr_t)addr;  // RAM/Flash: ַߵַ
+}
+
+static int sim_is_reg(uint32_t addr)
+{
+    return (addr >= SIM_PERIPH_BASE && addr < SIM_PERIPH_BASE + SIM_PERIPH_SIZE) ||
+           (addr >= SIM_SCS_BASE && addr < SIM_SCS_BASE + SIM_SCS_SIZE);
+}
+
+#define SIM_REG32(addr)       (*(volatile uint32_t*)sim_ptr(addr))
+#define SIM_PERIPH(type, a)   ((type*)sim_ptr((uint32_t)(uintptr_t)(a)))
+
+static uint64_t sim_ps(uint64_t n, uint32_t hz)
+{
+    if (hz == 0) return SIM_NEVER;
+    return (uint64_t)(((unsigned __int128)n * SIM_PS_PER_S) / hz);
+}
+
+static void sim_set_now(uint64_t t)
+{
+    if (t <= sim_now_ps) return;
+    sim_cycle_rem += (unsigned __int128)(t - sim_now_ps) * sim_hclk_hz;
+    sim_cycle     += (uint64_t)(sim_cycle_rem / SIM_PS_PER_S);
+    sim_cycle_rem %= SIM_PS_PER_S;
+    sim_now_ps = t;
+}
+
+// ===============================================================================
+// ģ״̬
+// ===============================================================================
+
+// --- DMA ͨ (DMA1 Ch1~7 -> 0~6, DMA2 Ch1~5 -> 7~11) ---
+#define SIM_DMA_CH_NUM 12
+#define SIM_DMA_NONE   0xFF
+typedef struct {
+    uint32_t dma_base;     // DMA1_BASE / DMA2_BASE
+    uint32_t ch_base;      // DMAx_Channely_BASE
+    uint8_t  flag_shift;   // ISR/IFCR иͨ־λʼλ
+    IRQn_Type irqn;
+    uint8_t  active;       // EN һδ
+    uint32_t reload;       // ʱ CNDTR (ѭģʽװ)
+    uint32_t p_addr, m_addr;
+    uint64_t next_m2m;     // 洢洢ģʽһʱ
+} sim_dma_t;
+static sim_dma_t sim_dma[SIM_DMA_CH_NUM];
+
+#define SIM_DMA1(ch)  ((ch) - 1)
+#define SIM_DMA2(ch)  (7 + (ch) - 1)
+
+// --- GPIO A~G ---
+typedef struct {
+    uint32_t base;
+    uint16_t ext_level;    // ⲿƽ
+    uint16_t ext_driven;   // Щűⲿ
+    uint16_t last_odr;
+} sim_gpio_t;
+static sim_gpio_t sim_gpio[7];
+
+// --- SysTick ---
+static struct {
+    uint64_t base_ps, tick_ps, next_zero;
+    uint32_t base_val, load;
+    uint8_t  pending;
+} sim_st;
+
+// --- DWT ڼ (CYCCNT = sim_cycle - sim_dwt_baseCYCCNTENA Ϊ 0 ʱͣ CYCCNT Ĵֵ) ---
+#define SIM_DWT_CTRL      0xE0001000u
+#define SIM_DWT_CYCCNT    0xE0001004u
+static uint64_t sim_dwt_base;
+
+// --- ʱ ---
+typedef struct {
+    uint32_t  base;
+    uint8_t   is_apb2;
+    IRQn_Type irqn;        // жڵжͨ
+    uint8_t   up_dma;      // TIMx_UP  DMA ͨ
+    uint8_t   dma_req;     //  DMA ѹ𡢵ȴͨӦ (ͨرڼ󲻶)
+    uint8_t   running;
+    uint64_t  base_ps, tick_ps, next_upd;
+    uint32_t  base_cnt, arr;
+} sim_tim_t;
+static sim_tim_t sim_tim[8];
+
+// --- USART ---
+#define SIM_UART_FIFO 4096
+typedef struct {
+    uint32_t  base;
+    uint8_t   is_apb2;
+    IRQn_Type irqn;
+    uint8_t   tx_dma, rx_dma;
+    uint16_t  tdr, shift, rdr;
+    uint8_t   tdr_full, shifting;
+    uint64_t  shift_end, rx_next, idle_at;
+    uint8_t   rx_fifo[SIM_UART_FIFO];
+    uint32_t  rx_head, rx_tail;
+    uint8_t   tx_log[SIM_UART_FIFO];
+    uint32_t  tx_head, tx_tail;
+} sim_uart_t;
+static sim_uart_t sim_uart[5];
+
+// --- SPI ---
+typedef struct {
+    uint32_t  base;
+    uint8_t   is_apb2;
+    IRQn_Type irqn;
+    uint8_t   tx_dma, rx_dma;
+    uint16_t  tdr, shift, rdr;
+    uint8_t   tdr_full, shifting;
+    uint64_t  shift_end;
+} sim_spi_t;
+static sim_spi_t sim_spi[3];
+
+// --- ADC1 ---
+static struct {
+    uint16_t input[18];
+    uint8_t  converting, rank;
+    uint64_t conv_end, cal_end;
+    uint64_t jconv_end;    // עʱ
+} sim_adc;
+
+// --- CAN1 (ػģʽշ) ---
+static struct {
+    uint32_t fifo[3][4];   // RIR, RDTR, RDLR, RDHR
+    uint8_t  count;
+} sim_can;
+
+// --- FLASH  ---
+static uint8_t sim_flash_key;
+
+// --- NVIC ---
+static uint32_t sim_nvic_enable[2], sim_nvic_pending[2], sim_nvic_active[2];
+static uint16_t sim_exec_prio = 0x100;   // ǰִȼ (0x100 = ߳ģʽ)
+static uint32_t sim_primask = 0;         // PRIMASK (1: ȫж)
+
+// --- ⲿص ---
+static RUN_sim_gpio_hook_t sim_gpio_hook;
+static RUN_sim_uart_hook_t sim_uart_hook;
+static RUN_sim_spi_slave_t sim_spi_slave;
+
+// ===============================================================================
+// ʱ ( RCC Ĵʵݼ)
+// ===============================================================================
+static void sim_clock_update(void)
+{
+    RCC_TypeDef* rcc = SIM_PERIPH(RCC_TypeDef, RCC_BASE);
+    uint32_t cfgr = rcc->CFGR;
+    uint32_t sws  = (cfgr >> 2) & 0x3;
+    uint32_t sys  = HSI_VALUE;
+
+    if (sws == 1) sys = RUN_SIM_HSE_HZ;
+    else if (sws == 2)
+    {
+        uint32_t mul = ((cfgr >> 18) & 0xF) + 2;
+        uint32_t src;
+        if (mul > 16) mul = 16;
+        if (cfgr & RCC_CFGR_PLLSRC) src = (cfgr & RCC_CFGR_PLLXTPRE) ? RUN_SIM_HSE_HZ / 2 : RUN_SIM_HSE_HZ;
+        else                        src = HSI_VALUE / 2;
+        sys = src * mul;
+    }
+
+    static const uint16_t ahb_div[16] = {1,1,1,1,1,1,1,1, 2,4,8,16,64,128,256,512};
+    static const uint8_t  apb_div[8]  = {1,1,1,1, 2,4,8,16};
+    static const uint8_t  adc_div[4]  = {2,4,6,8};
+
+    sim_sysclk_hz = sys;
+    sim_hclk_hz   = sys / ahb_div[(cfgr >> 4) & 0xF];
+    sim_pclk1_hz  = sim_hclk_hz / apb_div[(cfgr >> 8) & 0x7];
+    sim_pclk2_hz  = sim_hclk_hz / apb_div[(cfgr >> 11) & 0x7];
+    sim_adcclk_hz = sim_pclk2_hz / adc_div[(cfgr >> 14) & 0x3];
+}
+
+static uint32_t sim_pclk(uint8_t is_apb2) { return is_apb2 ? sim_pclk2_hz : sim_pclk1_hz; }
+
+static uint32_t sim_timclk(uint8_t is_apb2)
+{
+    uint32_t cfgr = SIM_PERIPH(RCC_TypeDef, RCC_BASE)->CFGR;
+    uint32_t ppre = is_apb2 ? ((cfgr >> 11) & 0x7) : ((cfgr >> 8) & 0x7);
+    return (ppre < 4) ? sim_pclk(is_apb2) : sim_pclk(is_apb2) * 2;
+}
+
+// ===============================================================================
+// DMA 
+// ===============================================================================
+static void sim_bus_write(uint32_t addr, uint32_t val, uint8_t size);
+static uint32_t sim_bus_read(uint32_t addr, uint8_t size);
+
+static void sim_dma_flag(sim_dma_t* d, uint32_t flags)
+{
+    SIM_REG32(d->dma_base) |= (flags | 0x1) << d->flag_shift;   // GIF + TC/HT/TE
+}
+
+static uint8_t sim_dma_ready(uint8_t idx)
+{
+    if (idx == SIM_DMA_NONE) return 0;
+    sim_dma_t* d = &sim_dma[idx];
+    DMA_Channel_TypeDef* c = SIM_PERIPH(DMA_Channel_TypeDef, d->ch_base);
+    return d->active && (c->CCR & DMA_CCR1_EN) && c->CNDTR != 0;
+}
+
+static void sim_dma_item(uint8_t idx)
+{
+    sim_dma_t* d = &sim_dma[idx];
+    DMA_Channel_TypeDef* c = SIM_PERIPH(DMA_Channel_TypeDef, d->ch_base);
+    uint32_t ccr   = c->CCR;
+    uint8_t  psize = 1 << ((ccr >> 8) & 0x3);
+    uint8_t  msize = 1 << ((ccr >> 10) & 0x3);
+    uint32_t val;
+
+    if (ccr & DMA_CCR1_DIR) { val = sim_bus_read(d->m_addr, msize); sim_bus_write(d->p_addr, val, psize); }
+    else                    { val = sim_bus_read(d->p_addr, psize); sim_bus_write(d->m_addr, val, msize); }
+
+    if (ccr & DMA_CCR1_PINC) d->p_addr += psize;
+    if (ccr & DMA_CCR1_MINC) d->m_addr += msize;
+    sim_stat.dma_items++;
+
+    uint32_t left = --c->CNDTR;
+    if (left == d->reload - d->reload / 2) sim_dma_flag(d, 0x4);   // HTIF
+    if (left == 0)
+    {
+        sim_dma_flag(d, 0x2);                                       // TCIF
+        if (ccr & DMA_CCR1_CIRC)
+        {
+            c->CNDTR = d->reload;
+            d->p_addr = c->CPAR;
+            d->m_addr = c->CMAR;
+        }
+        else d->active = 0;
+    }
+}
+
+// 跢һ DMA  (綨ʱ¼)
+static void sim_dma_request(uint8_t idx)
+{
+    if (sim_dma_ready(idx) && !(SIM_PERIPH(DMA_Channel_TypeDef, sim_dma[idx].ch_base)->CCR & DMA_CCR1_MEM2MEM))
+        sim_dma_item(idx);
+}
+
+// ƽ (USART/SPI  TXE/RXNEADC  EOC)ڼ
+static void sim_dma_service(void)
+{
+    static uint8_t busy = 0;
+    uint32_t guard = 0;
+    uint8_t progress = 1;
+
+    if (busy) return;
+    busy = 1;
+    while (progress && guard++ < 0x10000)
+    {
+        progress = 0;
+        for (int i = 0; i < 5; i++)
+        {
+            USART_TypeDef* u = SIM_PERIPH(USART_TypeDef, sim_uart[i].base);
+            if ((u->CR3 & USART_CR3_DMAT) && (u->SR & USART_SR_TXE) && sim_dma_ready(sim_uart[i].tx_dma))
+            { sim_dma_item(sim_uart[i].tx_dma); progress = 1; }
+            if ((u->CR3 & USART_CR3_DMAR) && (u->SR & USART_SR_RXNE) && sim_dma_ready(sim_uart[i].rx_dma))
+            { sim_dma_item(sim_uart[i].rx_dma); progress = 1; }
+        }
+        for (int i = 0; i < 3; i++)
+        {
+            SPI_TypeDef* s = SIM_PERIPH(SPI_TypeDef, sim_spi[i].base);
+            if ((s->CR2 & SPI_CR2_TXDMAEN) && (s->SR & SPI_SR_TXE) && sim_dma_ready(sim_spi[i].tx_dma))
+            { sim_dma_item(sim_spi[i].tx_dma); progress = 1; }
+            if ((s->CR2 & SPI_CR2_RXDMAEN) && (s->SR & SPI_SR_RXNE) && sim_dma_ready(sim_spi[i].rx_dma))
+            { sim_dma_item(sim_spi[i].rx_dma); progress = 1; }
+        }
+        ADC_TypeDef* adc = SIM_PERIPH(ADC_TypeDef, ADC1_BASE);
+        if ((adc->CR2 & ADC_CR2_DMA) && (adc->SR & ADC_SR_EOC) && sim_dma_ready(SIM_DMA1(1)))
+        { sim_dma_item(SIM_DMA1(1)); progress = 1; }
+    }
+    busy = 0;
+}
+
+static void sim_tim_dma_ack(uint8_t idx);
+
+static void sim_dma_ccr_written(sim_dma_t* d, uint32_t old)
+{
+    DMA_Channel_TypeDef* c = SIM_PERIPH(DMA_Channel_TypeDef, d->ch_base);
+
+    if (!(old & DMA_CCR1_EN) && (c->CCR & DMA_CCR1_EN))
+    {
+        d->reload = c->CNDTR;
+        d->p_addr = c->CPAR;
+        d->m_addr = c->CMAR;
+        d->active = (d->reload != 0);
+        d->next_m2m = (d->active && (c->CCR & DMA_CCR1_MEM2MEM)) ? sim_now_ps + sim_ps(4, sim_hclk_hz) : SIM_NEVER;
+        sim_tim_dma_ack((uint8_t)(d - sim_dma));
+    }
+    else if (!(c->CCR & DMA_CCR1_EN))
+    {
+        d->active = 0;
+        d->next_m2m = SIM_NEVER;
+    }
+}
+
+// ===============================================================================
+// GPIO / EXTI
+// ===============================================================================
+//  IDRŶ ODRŶⲿƽ (δʱ)
+static uint16_t sim_gpio_idr(int idx)
+{
+    GPIO_TypeDef* g = SIM_PERIPH(GPIO_TypeDef, sim_gpio[idx].base);
+    uint16_t idr = 0;
+
+    for (int pin = 0; pin < 16; pin++)
+    {
+        uint32_t cfg  = ((pin < 8 ? g->CRL : g->CRH) >> ((pin & 7) * 4)) & 0xF;
+        uint16_t bit  = 1 << pin;
+        uint8_t  mode = cfg & 0x3, cnf = cfg >> 2;
+        uint8_t  level;
+
+        if (mode != 0)  // 
+        {
+            if ((cnf & 0x1) && (g->ODR & bit))        // © = ͷţⲿ/
+                level = (sim_gpio[idx].ext_driven & bit) ? !!(sim_gpio[idx].ext_level & bit) : 1;
+            else
+                level = !!(g->ODR & bit);
+        }
+        else if (sim_gpio[idx].ext_driven & bit) level = !!(sim_gpio[idx].ext_level & bit);
+        else if (cnf == 2) level = !!(g->ODR & bit);  // /
+        else level = 0;
+
+        if (level) idr |= bit;
+    }
+    return idr;
+}
+
+static void sim_gpio_odr_changed(int idx)
+{
+    GPIO_TypeDef* g = SIM_PERIPH(GPIO_TypeDef, sim_gpio[idx].base);
+    uint16_t odr = (uint16_t)g->ODR;
+
+    if (odr != sim_gpio[idx].last_odr)
+    {
+        sim_gpio[idx].last_odr = odr;
+        if (sim_gpio_hook) sim_gpio_hook((GPIO_TypeDef*)(uintptr_t)sim_gpio[idx].base, odr, sim_cycle);
+    }
+}
+
+static void sim_exti_edge(int port_idx, uint16_t old_idr, uint16_t new_idr)
+{
+    EXTI_TypeDef* e = SIM_PERIPH(EXTI_TypeDef, EXTI_BASE);
+    AFIO_TypeDef* a = SIM_PERIPH(AFIO_TypeDef, AFIO_BASE);
+    uint16_t changed = old_idr ^ new_idr;
+
+    for (int line = 0; line < 16; line++)
+    {
+        uint16_t bit = 1 << line;
+        if (!(changed & bit)) continue;
+        if (((a->EXTICR[line >> 2] >> ((line & 3) * 4)) & 0xF) != (uint32_t)port_idx) continue;
+
+        if ((new_idr & bit) ? (e->RTSR & bit) : (e->FTSR & bit))
+            if (e->IMR & bit) e->PR |= bit;
+    }
+}
+
+// ===============================================================================
+// SysTick
+// ===============================================================================
+static uint32_t sim_st_val(uint64_t t)
+{
+    SysTick_Type* st = SIM_PERIPH(SysTick_Type, SysTick_BASE);
+    if (!(st->CTRL & SysTick_CTRL_ENABLE_Msk) || sim_st.tick_ps == 0) return sim_st.base_val;
+
+    uint64_t ticks = (t - sim_st.base_ps) / sim_st.tick_ps;
+    if (ticks <= sim_st.base_val) return sim_st.base_val - (uint32_t)ticks;
+    return sim_st.load - (uint32_t)((ticks - sim_st.base_val - 1) % ((uint64_t)sim_st.load + 1));
+}
+
+static void sim_st_rebase(uint32_t val)
+{
+    SysTick_Type* st = SIM_PERIPH(SysTick_Type, SysTick_BASE);
+
+    sim_st.base_val = val;
+    sim_st.base_ps  = sim_now_ps;
+    sim_st.load     = st->LOAD & 0xFFFFFF;
+    sim_st.tick_ps  = sim_ps((st->CTRL & SysTick_CTRL_CLKSOURCE_Msk) ? 1 : 8, sim_hclk_hz);
+
+    if (!(st->CTRL & SysTick_CTRL_ENABLE_Msk)) sim_st.next_zero = SIM_NEVER;
+    else if (val) sim_st.next_zero = sim_now_ps + val * sim_st.tick_ps;
+    else if (sim_st.load) sim_st.next_zero = sim_now_ps + ((uint64_t)sim_st.load + 1) * sim_st.tick_ps;
+    else sim_st.next_zero = SIM_NEVER;
+}
+
+// ===============================================================================
+// ʱ
+// ===============================================================================
+static uint32_t sim_tim_cnt(sim_tim_t* t, uint64_t now)
+{
+    if (!t->running || t->tick_ps == 0) return t->base_cnt;
+    uint64_t c = t->base_cnt + (now - t->base_ps) / t->tick_ps;
+    return (uint32_t)(c % ((uint64_t)t->arr + 1));
+}
+
+static void sim_tim_rebase(sim_tim_t* t, uint32_t cnt)
+{
+    TIM_TypeDef* r = SIM_PERIPH(TIM_TypeDef, t->base);
+
+    t->base_cnt = cnt & 0xFFFF;
+    t->base_ps  = sim_now_ps;
+    t->arr      = r->ARR;
+    t->tick_ps  = sim_ps((uint64_t)r->PSC + 1, sim_timclk(t->is_apb2));
+    t->running  = (r->CR1 & TIM_CR1_CEN) != 0;
+
+    if (!t->running || t->tick_ps == 0) t->next_upd = SIM_NEVER;
+    else if (t->base_cnt <= t->arr) t->next_upd = sim_now_ps + ((uint64_t)t->arr + 1 - t->base_cnt) * t->tick_ps;
+    else t->next_upd = sim_now_ps + ((uint64_t)0x10000 - t->base_cnt + t->arr + 1) * t->tick_ps;
+}
+
+// ʱ DMA 󱣳ֵͨӦΪֹͨʱرʱʹܺ
+static void sim_tim_dma_request(sim_tim_t* t)
+{
+    if (sim_dma_ready(t->up_dma)) { t->dma_req = 0; sim_dma_request(t->up_dma); }
+    else t->dma_req = 1;
+}
+
+static void sim_tim_dma_ack(uint8_t idx)
+{
+    for (int i = 0; i < 8; i++)
+    {
+        sim_tim_t* t = &sim_tim[i];
+        if (t->up_dma == idx && t->dma_req && (SIM_PERIPH(TIM_TypeDef, t->base)->DIER & TIM_DIER_UDE))
+            sim_tim_dma_request(t);
+    }
+}
+
+static void sim_tim_update_event(sim_tim_t* t)
+{
+    TIM_TypeDef* r = SIM_PERIPH(TIM_TypeDef, t->base);
+    r->SR |= TIM_SR_UIF;
+    if (r->DIER & TIM_DIER_UDE) sim_tim_dma_request(t);
+}
+
+// ===============================================================================
+// USART / SPI
+// ===============================================================================
+static uint64_t sim_uart_char_ps(sim_uart_t* u)
+{
+    uint32_t brr = SIM_PERIPH(USART_TypeDef, u->base)->BRR;
+    return sim_ps((uint64_t)(brr ? brr : 1) * 10, sim_pclk(u->is_apb2));
+}
+
+static uint64_t sim_spi_byte_ps(sim_spi_t* s)
+{
+    uint32_t cr1  = SIM_PERIPH(SPI_TypeDef, s->base)->CR1;
+    uint32_t bits = (cr1 & SPI_CR1_DFF) ? 16 : 8;
+    return sim_ps((uint64_t)bits * (2u << ((cr1 >> 3) & 0x7)), sim_pclk(s->is_apb2));
+}
+
+// ===============================================================================
+// ɢ¼ƽ
+// ===============================================================================
+typedef enum { EV_NONE, EV_SYSTICK, EV_TIM, EV_UART_TX, EV_UART_RX, EV_UART_IDLE, EV_SPI, EV_ADC, EV_ADC_CAL, EV_ADC_INJ, EV_DMA } sim_ev_t;
+
+static void sim_adc_start(uint64_t t);
+
+//  rank תͨ
+static uint32_t sim_adc_rank_ch(ADC_TypeDef* r, uint32_t rank)
+{
+    if (rank < 6)  return (r->SQR3 >> (5 * rank)) & 0x1F;
+    if (rank < 12) return (r->SQR2 >> (5 * (rank - 6))) & 0x1F;
+    return (r->SQR1 >> (5 * (rank - 12))) & 0x1F;
+}
+
+// ģ⿴Ź (AWDEN) / ע (JAWDEN) ת [LTR, HTR] ʱ AWDAWDSGL ʱֻ AWDCH ͨ
+static void sim_adc_awd_check(ADC_TypeDef* r, uint32_t ch, uint16_t v, uint8_t injected)
+{
+    if (!(r->CR1 & (injected ? ADC_CR1_JAWDEN : ADC_CR1_AWDEN))) return;
+    if ((r->CR1 & ADC_CR1_AWDSGL) && (r->CR1 & ADC_CR1_AWDCH) != ch) return;
+    if (v > (r->HTR & 0xFFF) || v < (r->LTR & 0xFFF)) r->SR |= ADC_SR_AWD;
+}
+
+// ע飺ͨʱʱ
+static void sim_adc_inj_start(uint64_t t)
+{
+    static const uint16_t smp_x2[8] = {3, 15, 27, 57, 83, 111, 143, 479};
+    ADC_TypeDef* r = SIM_PERIPH(ADC_TypeDef, ADC1_BASE);
+    uint32_t jl = (r->JSQR >> 20) & 0x3, half_cycles = 0;
+
+    for (uint32_t k = 0; k <= jl; k++)
+    {
+        uint32_t ch  = (r->JSQR >> (5 * (3 - jl + k))) & 0x1F;
+        uint32_t smp = (ch < 10) ? (r->SMPR2 >> (3 * ch)) & 0x7 : (r->SMPR1 >> (3 * (ch - 10))) & 0x7;
+        half_cycles += smp_x2[smp] + 25;
+    }
+    r->SR |= ADC_SR_JSTRT;
+    sim_adc.jconv_end = t + sim_ps(half_cycles, sim_adcclk_hz * 2);
+}
+
+// ʱ¼ǷǸ ADC ԴMMS = 010 ʱ TRGO˱Ƚ CCx
+static uint8_t sim_adc_trig_match(sim_tim_t* tm, uint32_t base, uint16_t ccer)
+{
+    TIM_TypeDef* tr = SIM_PERIPH(TIM_TypeDef, tm->base);
+    if (base != tm->base) return 0;
+    return ccer ? (tr->CCER & ccer) != 0 : (tr->CR2 & TIM_CR2_MMS) == TIM_CR2_MMS_1;
+}
+
+// ʱ ADC1  (CR2.EXTSEL) ע (CR2.JEXTSELTIM8_CC4  ADC1_ETRGINJ_REMAP Ѵ򿪴)
+// CC ¼ʱ̽ƣƵ׼ȷλ CCR 
+static void sim_adc_timer_trigger(sim_tim_t* tm, uint64_t t)
+{
+    static const uint32_t src[6]   = {TIM1_BASE, TIM1_BASE, TIM1_BASE, TIM2_BASE, TIM3_BASE, TIM4_BASE};
+    static const uint16_t ccer[6]  = {TIM_CCER_CC1E, TIM_CCER_CC2E, TIM_CCER_CC3E, TIM_CCER_CC2E, 0, TIM_CCER_CC4E};
+    static const uint32_t jsrc[7]  = {TIM1_BASE, TIM1_BASE, TIM2_BASE, TIM2_BASE, TIM3_BASE, TIM4_BASE, TIM8_BASE};
+    static const uint16_t jccer[7] = {0, TIM_CCER_CC4E, 0, TIM_CCER_CC1E, TIM_CCER_CC4E, 0, TIM_CCER_CC4E};
+    ADC_TypeDef* r = SIM_PERIPH(ADC_TypeDef, ADC1_BASE);
+    uint32_t sel  = (r->CR2 & ADC_CR2_EXTSEL) >> 17;
+    uint32_t jsel = (r->CR2 & ADC_CR2_JEXTSEL) >> 12;
+
+    if (!(r->CR2 & ADC_CR2_ADON)) return;
+
+    if ((r->CR2 & ADC_CR2_JEXTTRIG) && jsel < 7 && sim_adc_trig_match(tm, jsrc[jsel], jccer[jsel])
+        && sim_adc.jconv_end == SIM_NEVER)
+        sim_adc_inj_start(t);
+
+    if (!(r->CR2 & ADC_CR2_EXTTRIG) || sel > 5 || !sim_adc_trig_match(tm, src[sel], ccer[sel])) return;
+    if (sim_adc.converting) return;                            // תеĴ
+
+    sim_adc.rank = 0;
+    sim_adc_start(t);
+}
+
+static void sim_process_event(sim_ev_t ev, int i, uint64_t t)
+{
+    switch (ev)
+    {
+        case EV_SYSTICK:
+        {
+            SysTick_Type* st = SIM_PERIPH(SysTick_Type, SysTick_BASE);
+            st->CTRL |= SysTick_CTRL_COUNTFLAG_Msk;
+            if (st->CTRL & SysTick_CTRL_TICKINT_Msk) sim_st.pending = 1;
+            sim_st.next_zero = sim_st.load ? t + ((uint64_t)sim_st.load + 1) * sim_st.tick_ps : SIM_NEVER;
+            break;
+        }
+        case EV_TIM:
+        {
+            sim_tim_t* tm = &sim_tim[i];
+            tm->base_ps  = t;
+            tm->base_cnt = 0;
+            tm->next_upd = t + ((uint64_t)tm->arr + 1) * tm->tick_ps;
+            sim_tim_update_event(tm);
+            sim_adc_timer_trigger(tm, t);
+            break;
+        }
+        case EV_UART_TX:
+        {
+            sim_uart_t* u = &sim_uart[i];
+            USART_TypeDef* r = SIM_PERIPH(USART_TypeDef, u->base);
+
+            u->tx_log[u->tx_head] = (uint8_t)u->shift;
+            u->tx_head = (u->tx_head + 1) % SIM_UART_FIFO;
+            if (u->tx_head == u->tx_tail) u->tx_tail = (u->tx_tail + 1) % SIM_UART_FIFO;
+            if (sim_uart_hook) sim_uart_hook((USART_TypeDef*)(uintptr_t)u->base, (uint8_t)u->shift, sim_cycle);
+
+            if (u->tdr_full)
+            {
+                u->shift = u->tdr;
+                u->tdr_full = 0;
+                r->SR |= USART_SR_TXE;
+                u->shift_end = t + sim_uart_char_ps(u);
+            }
+            else
+            {
+                u->shifting = 0;
+                r->SR |= USART_SR_TC;
+                u->shift_end = SIM_NEVER;
+            }
+            break;
+        }
+        case EV_UART_RX:
+        {
+            sim_uart_t* u = &sim_uart[i];
+            USART_TypeDef* r = SIM_PERIPH(USART_TypeDef, u->base);
+            uint8_t dat = u->rx_fifo[u->rx_tail];
+            u->rx_tail = (u->rx_tail + 1) % SIM_UART_FIFO;
+
+            if ((r->CR1 & USART_CR1_UE) && (r->CR1 & USART_CR1_RE))
+            {
+                if (r->SR & USART_SR_RXNE) r->SR |= USART_SR_ORE;
+                else { u->rdr = dat; r->DR = dat; r->SR |= USART_SR_RXNE; }
+            }
+            u->rx_next = (u->rx_head != u->rx_tail) ? t + sim_uart_char_ps(u) : SIM_NEVER;
+            u->idle_at = t + sim_uart_char_ps(u);
+            break;
+        }
+        case EV_UART_IDLE:
+        {
+            sim_uart_t* u = &sim_uart[i];
+            if (u->rx_next == SIM_NEVER) SIM_PERIPH(USART_TypeDef, u->base)->SR |= USART_SR_IDLE;
+            u->idle_at = SIM_NEVER;
+            break;
+        }
+        case EV_SPI:
+        {
+            sim_spi_t* s = &sim_spi[i];
+            SPI_TypeDef* r = SIM_PERIPH(SPI_TypeDef, s->base);
+            uint8_t miso = sim_spi_slave ? sim_spi_slave((SPI_TypeDef*)(uintptr_t)s->base, (uint8_t)s->shift) : 0xFF;
+
+            if (r->SR & SPI_SR_RXNE) r->SR |= SPI_SR_OVR;
+            else { s->rdr = miso; r->DR = miso; r->SR |= SPI_SR_RXNE; }
+
+            if (s->tdr_full)
+            {
+                s->shift = s->tdr;
+                s->tdr_full = 0;
+                r->SR |= SPI_SR_TXE;
+                s->shift_end = t + sim_spi_byte_ps(s);
+            }
+            else
+            {
+                s->shifting = 0;
+                r->SR &= ~SPI_SR_BSY;
+                s->shift_end = SIM_NEVER;
+            }
+            break;
+        }
+        case EV_ADC:
+        {
+            ADC_TypeDef* r = SIM_PERIPH(ADC_TypeDef, ADC1_BASE);
+            uint32_t len = ((r->SQR1 >> 20) & 0xF) + 1;
+            uint32_t rank = sim_adc.rank;
+            uint32_t ch;
+
+            ch = sim_adc_rank_ch(r, rank);
+
+            uint16_t v = (ch < 18) ? (sim_adc.input[ch] & 0xFFF) : 0;
+            r->DR = (r->CR2 & ADC_CR2_ALIGN) ? (uint32_t)(v << 4) : v;
+            sim_adc_awd_check(r, ch, v, 0);
+
+            // ˫ ADCADC2 Ľ ADC1->DR  16 λ (ͬ = ͬһţٽ = ADC2 һͨ)
+            uint32_t dual = (r->CR1 & ADC_CR1_DUALMOD) >> 16;
+            if (dual == 6 || dual == 7)
+            {
+                ADC_TypeDef* r2 = SIM_PERIPH(ADC_TypeDef, ADC2_BASE);
+                uint32_t ch2 = sim_adc_rank_ch(r2, (dual == 6) ? rank : 0);
+                uint16_t v2  = (ch2 < 18 && (r2->CR2 & ADC_CR2_ADON)) ? (sim_adc.input[ch2] & 0xFFF) : 0;
+                r->DR |= (uint32_t)((r2->CR2 & ADC_CR2_ALIGN) ? (v2 << 4) : v2) << 16;
+            }
+            r->SR |= ADC_SR_EOC;
+
+            sim_adc.conv_end = SIM_NEVER;
+            sim_adc.converting = 0;
+            if ((r->CR1 & ADC_CR1_SCAN) && rank + 1 < len) { sim_adc.rank = rank + 1; sim_adc_start(t); }
+            else if (r->CR2 & ADC_CR2_CONT)                { sim_adc.rank = 0;        sim_adc_start(t); }
+            break;
+        }
+        case EV_ADC_INJ:
+        {
+            ADC_TypeDef* r = SIM_PERIPH(ADC_TypeDef, ADC1_BASE);
+            volatile uint32_t* jdr = &r->JDR1;
+            volatile uint32_t* jofr = &r->JOFR1;
+            uint32_t jl = (r->JSQR >> 20) & 0x3;
+
+            for (uint32_t k = 0; k <= jl; k++)
+            {
+                uint32_t ch = (r->JSQR >> (5 * (3 - jl + k))) & 0x1F;
+                int32_t  v  = (ch < 18) ? (int32_t)(sim_adc.input[ch] & 0xFFF) - (int32_t)(jofr[k] & 0xFFF) : 0;
+                jdr[k] = (uint16_t)(int16_t)v;
+                if (ch < 18) sim_adc_awd_check(r, ch, sim_adc.input[ch] & 0xFFF, 1);
+            }
+            r->SR |= ADC_SR_JEOC;
+            sim_adc.jconv_end = SIM_NEVER;
+            break;
+        }
+        case EV_ADC_CAL:
+            SIM_PERIPH(ADC_TypeDef, ADC1_BASE)->CR2 &= ~(ADC_CR2_CAL | ADC_CR2_RSTCAL);
+            sim_adc.cal_end = SIM_NEVER;
+            break;
+        case EV_DMA:
+        {
+            sim_dma_t* d = &sim_dma[i];
+            if (sim_dma_ready((uint8_t)i)) sim_dma_item((uint8_t)i);
+            d->next_m2m = sim_dma_ready((uint8_t)i) ? t + sim_ps(4, sim_hclk_hz) : SIM_NEVER;
+            break;
+        }
+        default: break;
+    }
+}
+
+static void sim_adc_start(uint64_t t)
+{
+    static const uint16_t smp_x2[8] = {3, 15, 27, 57, 83, 111, 143, 479};  //  x2
+    ADC_TypeDef* r = SIM_PERIPH(ADC_TypeDef, ADC1_BASE);
+    uint32_t rank = sim_adc.rank, ch;
+
+    ch = sim_adc_rank_ch(r, rank);
+
+    uint32_t smp = (ch < 10) ? (r->SMPR2 >> (3 * ch)) & 0x7 : (r->SMPR1 >> (3 * (ch - 10))) & 0x7;
+    r->SR |= ADC_SR_STRT;
+    sim_adc.converting = 1;
+    sim_adc.conv_end = t + sim_ps(smp_x2[smp] + 25, sim_adcclk_hz * 2);
+}
+
+// е (<= ǰʱ) ¼
+static void sim_catch_up(void)
+{
+    for (;;)
+    {
+        uint64_t best = SIM_NEVER;
+        sim_ev_t ev = EV_NONE;
+        int idx = 0;
+
+#define SIM_CAND(time, e, i) do { if ((time) < best) { best = (time); ev = (e); idx = (i); } } while (0)
+        SIM_CAND(sim_st.next_zero, EV_SYSTICK, 0);
+        for (int i = 0; i < 8; i++)  SIM_CAND(sim_tim[i].next_upd, EV_TIM, i);
+        for (int i = 0; i < 5; i++)
+        {
+            SIM_CAND(sim_uart[i].shift_end, EV_UART_TX, i);
+            SIM_CAND(sim_uart[i].rx_next,   EV_UART_RX, i);
+            SIM_CAND(sim_uart[i].idle_at,   EV_UART_IDLE, i);
+        }
+        for (int i = 0; i < 3; i++)  SIM_CAND(sim_spi[i].shift_end, EV_SPI, i);
+        SIM_CAND(sim_adc.conv_end, EV_ADC, 0);
+        SIM_CAND(sim_adc.cal_end,  EV_ADC_CAL, 0);
+        SIM_CAND(sim_adc.jconv_end, EV_ADC_INJ, 0);
+        for (int i = 0; i < SIM_DMA_CH_NUM; i++) SIM_CAND(sim_dma[i].next_m2m, EV_DMA, i);
+#undef SIM_CAND
+
+        if (ev == EV_NONE || best > sim_now_ps) break;
+        sim_process_event(ev, idx, best);
+        sim_dma_service();
+    }
+}
+
+static uint64_t sim_next_event(void)
+{
+    uint64_t best = sim_st.next_zero;
+    for (int i = 0; i < 8; i++) if (sim_tim[i].next_upd < best) best = sim_tim[i].next_upd;
+    for (int i = 0; i < 5; i++)
+    {
+        if (sim_uart[i].shift_end < best) best = sim_uart[i].shift_end;
+        if (sim_uart[i].rx_next   < best) best = sim_uart[i].rx_next;
+        if (sim_uart[i].idle_at   < best) best = sim_uart[i].idle_at;
+    }
+    for (int i = 0; i < 3; i++) if (sim_spi[i].shift_end < best) best = sim_spi[i].shift_end;
+    if (sim_adc.conv_end < best) best = sim_adc.conv_end;
+    if (sim_adc.cal_end  < best) best = sim_adc.cal_end;
+    if (sim_adc.jconv_end < best) best = sim_adc.jconv_end;
+    for (int i = 0; i < SIM_DMA_CH_NUM; i++) if (sim_dma[i].next_m2m < best) best = sim_dma[i].next_m2m;
+    return best;
+}
+
+// ʱıаʱƽ趼ҪƵ
+static void sim_retime_all(void)
+{
+    sim_st_rebase(sim_st_val(sim_now_ps));
+    for (int i = 0; i < 8; i++) sim_tim_rebase(&sim_tim[i], sim_tim_cnt(&sim_tim[i], sim_now_ps));
+}
+
+// ===============================================================================
+// Ĵд
+// ===============================================================================
+#define SIM_IN(a, base, type)  ((a) >= (uint32_t)(base) && (a) < (uint32_t)(base) + sizeof(type))
+#define SIM_OFF(type, field)   ((uint32_t)offsetof(type, field))
+
+// ֮ǰ""ĴֵˢµĴļ
+static void sim_read_pre(uint32_t a)
+{
+    for (int i = 0; i < 7; i++)
+    {
+        if (a == sim_gpio[i].base + SIM_OFF(GPIO_TypeDef, IDR))
+        {
+            SIM_PERIPH(GPIO_TypeDef, sim_gpio[i].base)->IDR = sim_gpio_idr(i);
+            return;
+        }
+    }
+    for (int i = 0; i < 8; i++)
+    {
+        if (a == sim_tim[i].base + SIM_OFF(TIM_TypeDef, CNT))
+        {
+            SIM_PERIPH(TIM_TypeDef, sim_tim[i].base)->CNT = (uint16_t)sim_tim_cnt(&sim_tim[i], sim_now_ps);
+            return;
+        }
+    }
+    for (int i = 0; i < 5; i++)
+    {
+        if (a == sim_uart[i].base + SIM_OFF(USART_TypeDef, DR))
+        { SIM_PERIPH(USART_TypeDef, sim_uart[i].base)->DR = sim_uart[i].rdr; return; }
+    }
+    for (int i = 0; i < 3; i++)
+    {
+        if (a == sim_spi[i].base + SIM_OFF(SPI_TypeDef, DR))
+        { SIM_PERIPH(SPI_TypeDef, sim_spi[i].base)->DR = sim_spi[i].rdr; return; }
+    }
+    if (a == SysTick_BASE + SIM_OFF(SysTick_Type, VAL))
+        SIM_PERIPH(SysTick_Type, SysTick_BASE)->VAL = sim_st_val(sim_now_ps);
+    if (a == SIM_DWT_CYCCNT && (SIM_REG32(SIM_DWT_CTRL) & 1))
+        SIM_REG32(SIM_DWT_CYCCNT) = (uint32_t)(sim_cycle - sim_dwt_base);
+}
+
+// ֮󣺶ั
+static void sim_read_post(uint32_t a)
+{
+    for (int i = 0; i < 5; i++)
+    {
+        if (a == sim_uart[i].base + SIM_OFF(USART_TypeDef, DR))
+        {
+            SIM_PERIPH(USART_TypeDef, sim_uart[i].base)->SR &= ~(USART_SR_RXNE | USART_SR_ORE | USART_SR_IDLE);
+            return;
+        }
+    }
+    for (int i = 0; i < 3; i++)
+    {
+        if (a == sim_spi[i].base + SIM_OFF(SPI_TypeDef, DR))
+        { SIM_PERIPH(SPI_TypeDef, sim_spi[i].base)->SR &= ~SPI_SR_RXNE; return; }
+    }
+    if (a == ADC1_BASE + SIM_OFF(ADC_TypeDef, DR))
+        SIM_PERIPH(ADC_TypeDef, ADC1_BASE)->SR &= ~ADC_SR_EOC;
+    else if (a == SysTick_BASE + SIM_OFF(SysTick_Type, CTRL))
+        SIM_PERIPH(SysTick_Type, SysTick_BASE)->CTRL &= ~SysTick_CTRL_COUNTFLAG_Msk;
+}
+
+static void sim_can_update_fifo(void)
+{
+    CAN_TypeDef* c = SIM_PERIPH(CAN_TypeDef, CAN1_BASE);
+    c->RF0R = (c->RF0R & ~CAN_RF0R_FMP0) | sim_can.count;
+    if (sim_can.count)
+    {
+        c->sFIFOMailBox[0].RIR  = sim_can.fifo[0][0];
+        c->sFIFOMailBox[0].RDTR = sim_can.fifo[0][1];
+        c->sFIFOMailBox[0].RDLR = sim_can.fifo[0][2];
+        c->sFIFOMailBox[0].RDHR = sim_can.fifo[0][3];
+    }
+}
+
+// д֮󣺰ĴĴļ (old Ϊд֮ǰֵ)
+static void sim_write_post(uint32_t a, uint32_t old)
+{
+    uint32_t now = SIM_REG32(a);
+
+    // --- GPIO ---
+    for (int i = 0; i < 7; i++)
+    {
+        uint32_t b = sim_gpio[i].base;
+        if (!SIM_IN(a, b, GPIO_TypeDef)) continue;
+        GPIO_TypeDef* g = SIM_PERIPH(GPIO_TypeDef, b);
+        uint16_t idr_old = sim_gpio_idr(i);
+
+        if (a == b + SIM_OFF(GPIO_TypeDef, BSRR))
+        {
+            g->ODR  = (g->ODR & ~(now >> 16)) | (now & 0xFFFF);
+            g->BSRR = 0;
+        }
+        else if (a == b + SIM_OFF(GPIO_TypeDef, BRR))
+        {
+            g->ODR &= ~(now & 0xFFFF);
+            g->BRR  = 0;
+        }
+        else if (a == b + SIM_OFF(GPIO_TypeDef, IDR)) g->IDR = old;
+        sim_gpio_odr_changed(i);
+        sim_exti_edge(i, idr_old, sim_gpio_idr(i));
+        return;
+    }
+
+    // --- EXTI ---
+    if (a == EXTI_BASE + SIM_OFF(EXTI_TypeDef, PR))  { SIM_REG32(a) = old & ~now; return; }
+    if (a == EXTI_BASE + SIM_OFF(EXTI_TypeDef, SWIER))
+    {
+        EXTI_TypeDef* e = SIM_PERIPH(EXTI_TypeDef, EXTI_BASE);
+        e->PR |= (now & ~old) & e->IMR;
+        return;
+    }
+
+    // --- RCC ---
+    if (a == RCC_BASE + SIM_OFF(RCC_TypeDef, CR))
+    {
+        uint32_t rdy = 0;
+        if (now & RCC_CR_HSION) rdy |= RCC_CR_HSIRDY;
+        if (now & RCC_CR_HSEON) rdy |= RCC_CR_HSERDY;
+        if (now & RCC_CR_PLLON) rdy |= RCC_CR_PLLRDY;
+        SIM_REG32(a) = (now & ~(RCC_CR_HSIRDY | RCC_CR_HSERDY | RCC_CR_PLLRDY)) | rdy;
+        return;
+    }
+    if (a == RCC_BASE + SIM_OFF(RCC_TypeDef, CFGR))
+    {
+        SIM_REG32(a) = (now & ~RCC_CFGR_SWS) | ((now & RCC_CFGR_SW) << 2);
+        sim_clock_update();
+        sim_retime_all();
+        return;
+    }
+
+    // --- FLASH  ---
+    if (a == FLASH_R_BASE + SIM_OFF(FLASH_TypeDef, KEYR))
+    {
+        FLASH_TypeDef* f = SIM_PERIPH(FLASH_TypeDef, FLASH_R_BASE);
+        if (now == 0x45670123) sim_flash_key = 1;
+        else if (now == 0xCDEF89AB && sim_flash_key == 1) { f->CR &= ~FLASH_CR_LOCK; sim_flash_key = 0; }
+        else sim_flash_key = 0;
+        f->KEYR = 0;
+        return;
+    }
+    if (a == FLASH_R_BASE + SIM_OFF(FLASH_TypeDef, SR)) { SIM_REG32(a) = old & ~(now & 0x34); return; }
+    if (a == FLASH_R_BASE + SIM_OFF(FLASH_TypeDef, CR))
+    {
+        FLASH_TypeDef* f = SIM_PERIPH(FLASH_TypeDef, FLASH_R_BASE);
+        if (old & FLASH_CR_LOCK) { f->CR = old | (now & FLASH_CR_LOCK); return; }
+        if (now & FLASH_CR_STRT)
+        {
+            if (now & FLASH_CR_MER) memset((void*)(uintptr_t)SIM_FLASH_BASE, 0xFF, SIM_FLASH_SIZE);
+            else if ((now & FLASH_CR_PER) && f->AR >= SIM_FLASH_BASE && f->AR < SIM_FLASH_BASE + SIM_FLASH_SIZE)
+                memset((void*)(uintptr_t)(f->AR & ~(SIM_FLASH_PAGE - 1)), 0xFF, SIM_FLASH_PAGE);
+            f->CR &= ~FLASH_CR_STRT;
+            f->SR |= FLASH_SR_EOP;
+        }
+        return;
+    }
+
+    // --- DMA ---
+    for (int i = 0; i < SIM_DMA_CH_NUM; i++)
+    {
+        sim_dma_t* d = &sim_dma[i];
+        if (a == d->ch_base + SIM_OFF(DMA_Channel_TypeDef, CCR)) { sim_dma_ccr_written(d, old); return; }
+        if (a == d->ch_base + SIM_OFF(DMA_Channel_TypeDef, CNDTR) && d->active) { SIM_REG32(a) = old; return; }
+    }
+    if (a == DMA1_BASE + SIM_OFF(DMA_TypeDef, IFCR) || a == DMA2_BASE + SIM_OFF(DMA_TypeDef, IFCR))
+    {
+        uint32_t isr = a - SIM_OFF(DMA_TypeDef, IFCR);
+        uint32_t clr = now;
+        for (int ch = 0; ch < 7; ch++) if (clr & (1u << (4 * ch))) clr |= 0xFu << (4 * ch);  // CGIF ͨȫ
+        SIM_REG32(isr) &= ~clr;
+        SIM_REG32(a) = 0;
+        return;
+    }
+    if (a == DMA1_BASE + SIM_OFF(DMA_TypeDef, ISR) || a == DMA2_BASE + SIM_OFF(DMA_TypeDef, ISR))
+    { SIM_REG32(a) = old; return; }
+
+    // --- ʱ ---
+    for (int i = 0; i < 8; i++)
+    {
+        sim_tim_t* t = &sim_tim[i];
+        if (!SIM_IN(a, t->base, TIM_TypeDef)) continue;
+        TIM_TypeDef* r = SIM_PERIPH(TIM_TypeDef, t->base);
+        uint32_t off = a - t->base;
+
+        if (off == SIM_OFF(TIM_TypeDef, SR)) r->SR = old & now;               // rc_w0
+        else if (off == SIM_OFF(TIM_TypeDef, EGR))
+        {
+            r->EGR = 0;
+            if (now & TIM_EGR_UG)
+            {
+                sim_tim_rebase(t, 0);
+                if (!(r->CR1 & TIM_CR1_URS)) r->SR |= TIM_SR_UIF;
+                if (r->DIER & TIM_DIER_UDE) sim_tim_dma_request(t);
+            }
+        }
+        else if (off == SIM_OFF(TIM_TypeDef, DIER)) { if (!(now & TIM_DIER_UDE)) t->dma_req = 0; }
+        else if (off == SIM_OFF(TIM_TypeDef, CNT)) sim_tim_rebase(t, now);
+        else if (off == SIM_OFF(TIM_TypeDef, CR1) || off == SIM_OFF(TIM_TypeDef, PSC) || off == SIM_OFF(TIM_TypeDef, ARR))
+        {
+            uint32_t cnt = t->base_cnt;
+            if (t->running && t->tick_ps) cnt = (uint32_t)((t->base_cnt + (sim_now_ps - t->base_ps) / t->tick_ps) % ((uint64_t)t->arr + 1));
+            sim_tim_rebase(t, cnt);
+        }
+        return;
+    }
+
+    // --- USART ---
+    for (int i = 0; i < 5; i++)
+    {
+        sim_uart_t* u = &sim_uart[i];
+        if (!SIM_IN(a, u->base, USART_TypeDef)) continue;
+        USART_TypeDef* r = SIM_PERIPH(USART_TypeDef, u->base);
+        uint32_t off = a - u->base;
+
+        if (off == SIM_OFF(USART_TypeDef, SR))
+            r->SR = old & (now | ~(USART_SR_CTS | USART_SR_LBD | USART_SR_TC | USART_SR_RXNE));
+        else if (off == SIM_OFF(USART_TypeDef, DR))
+        {
+            uint16_t dat = now & 0x1FF;
+            r->DR = u->rdr;
+            if (!(r->CR1 & USART_CR1_UE) || !(r->CR1 & USART_CR1_TE)) return;
+            r->SR &= ~USART_SR_TC;
+            if (!u->shifting)
+            {
+                u->shift = dat;
+                u->shifting = 1;
+                u->shift_end = sim_now_ps + sim_uart_char_ps(u);
+            }
+            else
+            {
+                u->tdr = dat;
+                u->tdr_full = 1;
+                r->SR &= ~USART_SR_TXE;
+            }
+        }
+        return;
+    }
+
+    // --- SPI ---
+    for (int i = 0; i < 3; i++)
+    {
+        sim_spi_t* s = &sim_spi[i];
+        if (!SIM_IN(a, s->base, SPI_TypeDef)) continue;
+        SPI_TypeDef* r = SIM_PERIPH(SPI_TypeDef, s->base);
+        uint32_t off = a - s->base;
+
+        if (off == SIM_OFF(SPI_TypeDef, SR)) r->SR = old & (now | ~SPI_SR_CRCERR);
+        else if (off == SIM_OFF(SPI_TypeDef, DR))
+        {
+            uint16_t dat = (uint16_t)now;
+            r->DR = s->rdr;
+            if (!(r->CR1 & SPI_CR1_SPE)) return;
+            r->SR |= SPI_SR_BSY;
+            if (!s->shifting)
+            {
+                s->shift = dat;
+                s->shifting = 1;
+                s->shift_end = sim_now_ps + sim_spi_byte_ps(s);
+            }
+            else
+            {
+                s->tdr = dat;
+                s->tdr_full = 1;
+                r->SR &= ~SPI_SR_TXE;
+            }
+        }
+        return;
+    }
+
+    // --- ADC1 ---
+    if (SIM_IN(a, ADC1_BASE, ADC_TypeDef))
+    {
+        ADC_TypeDef* r = SIM_PERIPH(ADC_TypeDef, ADC1_BASE);
+        if (a == ADC1_BASE + SIM_OFF(ADC_TypeDef, SR)) r->SR = old & now;
+        else if (a == ADC1_BASE + SIM_OFF(ADC_TypeDef, CR2))
+        {
+            if (now & (ADC_CR2_CAL | ADC_CR2_RSTCAL))
+                sim_adc.cal_end = sim_now_ps + sim_ps(83, sim_adcclk_hz);
+
+            uint8_t sw_trig = (now & ADC_CR2_SWSTART) && (now & ADC_CR2_EXTTRIG) && ((now & ADC_CR2_EXTSEL) == ADC_CR2_EXTSEL);
+            uint8_t re_adon = (old & ADC_CR2_ADON) && now == old;   // ٴд ADON Ҳת
+            uint8_t jsw_trig = (now & ADC_CR2_JSWSTART) && (now & ADC_CR2_JEXTTRIG) && ((now & ADC_CR2_JEXTSEL) == ADC_CR2_JEXTSEL);
+            if ((now & ADC_CR2_ADON) && jsw_trig && sim_adc.jconv_end == SIM_NEVER) sim_adc_inj_start(sim_now_ps);
+            r->CR2 &= ~ADC_CR2_JSWSTART;
+
+            if (!(now & ADC_CR2_ADON)) { sim_adc.converting = 0; sim_adc.conv_end = sim_adc.jconv_end = SIM_NEVER; }
+            else if ((sw_trig || re_adon) && !sim_adc.converting)
+            {
+                sim_adc.rank = 0;
+                sim_adc_start(sim_now_ps);
+            }
+            r->CR2 &= ~ADC_CR2_SWSTART;
+        }
+        return;
+    }
+
+    // --- ADC2 (ֻΪ˫ ADC ģʽĴ ADCУ׼ɣת ADC1 ADC1->DR  16 λ) ---
+    if (SIM_IN(a, ADC2_BASE, ADC_TypeDef))
+    {
+        if (a == ADC2_BASE + SIM_OFF(ADC_TypeDef, CR2))
+            SIM_PERIPH(ADC_TypeDef, ADC2_BASE)->CR2 &= ~(ADC_CR2_CAL | ADC_CR2_RSTCAL | ADC_CR2_SWSTART);
+        return;
+    }
+
+    // --- CAN1 ---
+    if (SIM_IN(a, CAN1_BASE, CAN_TypeDef))
+    {
+        CAN_TypeDef* c = SIM_PERIPH(CAN_TypeDef, CAN1_BASE);
+        uint32_t off = a - CAN1_BASE;
+
+        if (off == SIM_OFF(CAN_TypeDef, MCR))
+        {
+            uint32_t msr = c->MSR & ~(CAN_MSR_INAK | CAN_MSR_SLAK);
+            if (now & CAN_MCR_INRQ) msr |= CAN_MSR_INAK;
+            else if (now & CAN_MCR_SLEEP) msr |= CAN_MSR_SLAK;
+            c->MSR = msr;
+        }
+        else if (off == SIM_OFF(CAN_TypeDef, TSR)) c->TSR = old & ~(now & 0x000F0F0F);
+        else if (off == SIM_OFF(CAN_TypeDef, RF0R))
+        {
+            if ((now & CAN_RF0R_RFOM0) && sim_can.count)
+            {
+                memmove(sim_can.fifo[0], sim_can.fifo[1], sizeof(sim_can.fifo[0]) * 2);
+                sim_can.count--;
+            }
+            c->RF0R = old & ~(now & (CAN_RF0R_FULL0 | CAN_RF0R_FOVR0));
+            sim_can_update_fifo();
+        }
+        else
+        {
+            for (int m = 0; m < 3; m++)
+            {
+                if (off != SIM_OFF(CAN_TypeDef, sTxMailBox[m].TIR) || !(now & CAN_TI0R_TXRQ)) continue;
+                c->sTxMailBox[m].TIR &= ~CAN_TI0R_TXRQ;
+                c->TSR |= (CAN_TSR_RQCP0 | CAN_TSR_TXOK0) << (8 * m);
+                if ((c->BTR & CAN_BTR_LBKM) && sim_can.count < 3)
+                {
+                    uint32_t* slot = sim_can.fifo[sim_can.count++];
+                    slot[0] = c->sTxMailBox[m].TIR;
+                    slot[1] = c->sTxMailBox[m].TDTR & 0xF;
+                    slot[2] = c->sTxMailBox[m].TDLR;
+                    slot[3] = c->sTxMailBox[m].TDHR;
+                    sim_can_update_fifo();
+                }
+            }
+        }
+        return;
+    }
+
+    // --- SysTick ---
+    if (a == SysTick_BASE + SIM_OFF(SysTick_Type, CTRL) || a == SysTick_BASE + SIM_OFF(SysTick_Type, LOAD))
+    {
+        // Ծǰֵ
+        SysTick_Type* st = SIM_PERIPH(SysTick_Type, SysTick_BASE);
+        uint32_t ctrl_new = st->CTRL;
+        uint32_t val;
+        if (a == SysTick_BASE + SIM_OFF(SysTick_Type, CTRL)) st->CTRL = old;
+        val = sim_st_val(sim_now_ps);
+        st->CTRL = ctrl_new;
+        sim_st_rebase(val);
+        return;
+    }
+    if (a == SysTick_BASE + SIM_OFF(SysTick_Type, VAL))
+    {
+        SysTick_Type* st = SIM_PERIPH(SysTick_Type, SysTick_BASE);
+        st->VAL = 0;
+        st->CTRL &= ~SysTick_CTRL_COUNTFLAG_Msk;
+        sim_st_rebase(0);
+        return;
+    }
+
+    // --- DWTд CYCCNT  CYCCNTENA ʱӼĴֵż ---
+    if (a == SIM_DWT_CYCCNT || (a == SIM_DWT_CTRL && !(old & 1) && (SIM_REG32(a) & 1)))
+    {
+        sim_dwt_base = sim_cycle - SIM_REG32(SIM_DWT_CYCCNT);
+        return;
+    }
+    if (a == SIM_DWT_CTRL && (old & 1) && !(SIM_REG32(a) & 1))
+    {
+        SIM_REG32(SIM_DWT_CYCCNT) = (uint32_t)(sim_cycle - sim_dwt_base);
+        return;
+    }
+
+    // --- NVIC (д 1 Чλ/Ĵ) ---
+    for (int n = 0; n < 2; n++)
+    {
+        NVIC_Type* nv = SIM_PERIPH(NVIC_Type, NVIC_BASE);
+        if (a == NVIC_BASE + SIM_OFF(NVIC_Type, ISER[n])) sim_nvic_enable[n]  |= now;
+        else if (a == NVIC_BASE + SIM_OFF(NVIC_Type, ICER[n])) sim_nvic_enable[n]  &= ~now;
+        else if (a == NVIC_BASE + SIM_OFF(NVIC_Type, ISPR[n])) sim_nvic_pending[n] |= now;
+        else if (a == NVIC_BASE + SIM_OFF(NVIC_Type, ICPR[n])) sim_nvic_pending[n] &= ~now;
+        else continue;
+        nv->ISER[n] = nv->ICER[n] = sim_nvic_enable[n];
+        nv->ISPR[n] = nv->ICPR[n] = sim_nvic_pending[n];
+        return;
+    }
+}
+
+// ڲ (DMA) ߷ʣ CPU ͬһ׼Ĵ
+static uint32_t sim_bus_read(uint32_t addr, uint8_t size)
+{
+    uint32_t v;
+    if (sim_is_reg(addr)) sim_read_pre(addr & ~3u);
+    void* p = sim_ptr(addr);
+    if (size == 1)      v = *(volatile uint8_t*)p;
+    else if (size == 2) v = *(volatile uint16_t*)p;
+    else                v = *(volatile uint32_t*)p;
+    if (sim_is_reg(addr)) sim_read_post(addr & ~3u);
+    return v;
+}
+
+static void sim_bus_write(uint32_t addr, uint32_t val, uint8_t size)
+{
+    uint32_t old = 0;
+    if (sim_is_reg(addr)) { sim_read_pre(addr & ~3u); old = SIM_REG32(addr & ~3u); }
+    void* p = sim_ptr(addr);
+    if (size == 1)      *(volatile uint8_t*)p  = (uint8_t)val;
+    else if (size == 2) *(volatile uint16_t*)p = (uint16_t)val;
+    else                *(volatile uint32_t*)p = val;
+    if (sim_is_reg(addr)) sim_write_post(addr & ~3u, old);
+}
+
+// ===============================================================================
+// жɷ
+// ===============================================================================
+static uint8_t sim_irq_level(int irq)
+{
+    switch (irq)
+    {
+        case EXTI0_IRQn: case EXTI1_IRQn: case EXTI2_IRQn: case EXTI3_IRQn: case EXTI4_IRQn:
+        {
+            EXTI_TypeDef* e = SIM_PERIPH(EXTI_TypeDef, EXTI_BASE);
+            return (e->PR & e->IMR & (1u << (irq - EXTI0_IRQn))) != 0;
+        }
+        case EXTI9_5_IRQn:   { EXTI_TypeDef* e = SIM_PERIPH(EXTI_TypeDef, EXTI_BASE); return (e->PR & e->IMR & 0x03E0) != 0; }
+        case EXTI15_10_IRQn: { EXTI_TypeDef* e = SIM_PERIPH(EXTI_TypeDef, EXTI_BASE); return (e->PR & e->IMR & 0xFC00) != 0; }
+        case ADC1_2_IRQn:
+        {
+            ADC_TypeDef* r = SIM_PERIPH(ADC_TypeDef, ADC1_BASE);
+            return ((r->CR1 & ADC_CR1_EOCIE)  && (r->SR & ADC_SR_EOC))  ||
+                   ((r->CR1 & ADC_CR1_AWDIE)  && (r->SR & ADC_SR_AWD))  ||
+                   ((r->CR1 & ADC_CR1_JEOCIE) && (r->SR & ADC_SR_JEOC));
+        }
+        case USB_HP_CAN1_TX_IRQn:
+        {
+            CAN_TypeDef* c = SIM_PERIPH(CAN_TypeDef, CAN1_BASE);
+            return (c->IER & CAN_IER_TMEIE) && (c->TSR & (CAN_TSR_RQCP0 | CAN_TSR_RQCP1 | CAN_TSR_RQCP2));
+        }
+        case USB_LP_CAN1_RX0_IRQn:
+        {
+            CAN_TypeDef* c = SIM_PERIPH(CAN_TypeDef, CAN1_BASE);
+            return (c->IER & CAN_IER_FMPIE0) && (c->RF0R & CAN_RF0R_FMP0);
+        }
+        default: break;
+    }
+    for (int i = 0; i < SIM_DMA_CH_NUM; i++)
+    {
+        if (sim_dma[i].irqn != irq) continue;
+        uint32_t ccr = SIM_PERIPH(DMA_Channel_TypeDef, sim_dma[i].ch_base)->CCR;
+        uint32_t isr = SIM_REG32(sim_dma[i].dma_base) >> sim_dma[i].flag_shift;
+        if ((ccr & isr & 0xE) != 0) return 1;   // TCIE/HTIE/TEIE  TCIF/HTIF/TEIF λһ
+    }
+    for (int i = 0; i < 8; i++)
+    {
+        if (sim_tim[i].irqn != irq) continue;
+        TIM_TypeDef* r = SIM_PERIPH(TIM_TypeDef, sim_tim[i].base);
+        uint16_t mask = (sim_tim[i].base == TIM1_BASE || sim_tim[i].base == TIM8_BASE) ? TIM_SR_UIF : 0x5F;
+        return (r->SR & r->DIER & mask) != 0;
+    }
+    for (int i = 0; i < 5; i++)
+    {
+        if (sim_uart[i].irqn != irq) continue;
+        USART_TypeDef* r = SIM_PERIPH(USART_TypeDef, sim_uart[i].base);
+        uint16_t sr = r->SR, cr1 = r->CR1;
+        return ((cr1 & USART_CR1_RXNEIE) && (sr & (USART_SR_RXNE | USART_SR_ORE))) ||
+               ((cr1 & USART_CR1_TXEIE)  && (sr & USART_SR_TXE)) ||
+               ((cr1 & USART_CR1_TCIE)   && (sr & USART_SR_TC))  ||
+               ((cr1 & USART_CR1_IDLEIE) && (sr & USART_SR_IDLE));
+    }
+    for (int i = 0; i < 3; i++)
+    {
+        if (sim_spi[i].irqn != irq) continue;
+        SPI_TypeDef* r = SIM_PERIPH(SPI_TypeDef, sim_spi[i].base);
+        return ((r->CR2 & SPI_CR2_TXEIE) && (r->SR & SPI_SR_TXE)) || ((r->CR2 & SPI_CR2_RXNEIE) && (r->SR & SPI_SR_RXNE));
+    }
+    return 0;
+}
+
+static uint8_t sim_group_prio(uint16_t prio)
+{
+    uint32_t prigroup = (SIM_PERIPH(SCB_Type, SCB_BASE)->AIRCR >> 8) & 0x7;
+    return (uint8_t)(prio >> (prigroup + 1));
+}
+
+static void sim_dispatch(void)
+{
+    static uint8_t depth = 0;
+    if (depth > 8) return;
+
+    for (int guard = 0; guard < 64; guard++)
+    {
+        int      best = -2;
+        uint16_t best_prio = 0x100;
+        NVIC_Type* nv = SIM_PERIPH(NVIC_Type, NVIC_BASE);
+
+        if (sim_st.pending)
+        {
+            uint16_t p = SIM_PERIPH(SCB_Type, SCB_BASE)->SHP[11];
+            if (p < best_prio) { best = SIM_IRQ_SYSTICK; best_prio = p; }
+        }
+        for (int irq = 0; irq < SIM_IRQ_NUM; irq++)
+        {
+            uint32_t bit = 1u << (irq & 31);
+            if (!(sim_nvic_enable[irq >> 5] & bit) || (sim_nvic_active[irq >> 5] & bit)) continue;
+            if (!(sim_nvic_pending[irq >> 5] & bit) && !sim_irq_level(irq)) continue;
+            if (nv->IP[irq] < best_prio) { best = irq; best_prio = nv->IP[irq]; }
+        }
+        if (best == -2 || sim_primask) return;
+        if (sim_exec_prio != 0x100 && sim_group_prio(best_prio) >= sim_group_prio(sim_exec_prio)) return;
+
+        uint16_t saved = sim_exec_prio;
+        sim_exec_prio = best_prio;
+        sim_stat.irq_count++;
+        depth++;
+        sim_set_now(sim_now_ps + sim_ps(RUN_SIM_COST_IRQ, sim_hclk_hz));
+
+        if (best == SIM_IRQ_SYSTICK)
+        {
+            sim_st.pending = 0;
+            SysTick_Handler();
+        }
+        else
+        {
+            uint32_t bit = 1u << (best & 31);
+            sim_nvic_pending[best >> 5] &= ~bit;
+            nv->ISPR[best >> 5] = nv->ICPR[best >> 5] = sim_nvic_pending[best >> 5];
+            sim_nvic_active[best >> 5] |= bit;
+            nv->IABR[best >> 5] = sim_nvic_active[best >> 5];
+            sim_vector[best]();
+            sim_nvic_active[best >> 5] &= ~bit;
+            nv->IABR[best >> 5] = sim_nvic_active[best >> 5];
+        }
+
+        sim_set_now(sim_now_ps + sim_ps(RUN_SIM_COST_IRQ, sim_hclk_hz));
+        depth--;
+        sim_exec_prio = saved;
+        sim_catch_up();
+    }
+}
+
+// ===============================================================================
+//  (SIGSEGV +  SIGTRAP)
+// ===============================================================================
+typedef struct {
+    uint32_t addr;      // Ĵַ (ֶ)
+    uint32_t page;      // ʱſҳ
+    uint32_t alias;     // λַ (0 ʾͨ)
+    uint32_t old;       // ǰļĴֵ
+    uint8_t  bit;       // λӦλ
+    uint8_t  write;
+} sim_access_t;
+
+static sim_access_t sim_pend[4];
+static int sim_npend;
+
+// æȼ⣺CPU ͬһĴҶֵ (ѯ TXE/UIF/COUNTFLAG...)
+// ˵ڵһ¼ֱӰʱ¼˷ʱ
+#define SIM_POLL_SKIP 8
+static uint32_t sim_poll_addr, sim_poll_val, sim_poll_cnt;
+
+static void sim_poll_check(uint32_t addr, uint32_t val)
+{
+    if (addr != sim_poll_addr || val != sim_poll_val)
+    {
+        sim_poll_addr = addr;
+        sim_poll_val  = val;
+        sim_poll_cnt  = 0;
+        return;
+    }
+    if (++sim_poll_cnt >= SIM_POLL_SKIP)
+    {
+        uint64_t ev = sim_next_event();
+        if (ev != SIM_NEVER && ev > sim_now_ps) sim_set_now(ev);
+        sim_poll_cnt = 0;
+    }
+}
+
+static uint32_t sim_cost(uint32_t a)
+{
+    if (a >= SIM_SCS_BASE) return RUN_SIM_COST_CORE;
+    if (a >= AHBPERIPH_BASE) return RUN_SIM_COST_AHB;
+    if (a >= APB2PERIPH_BASE) return RUN_SIM_COST_APB2;
+    return RUN_SIM_COST_APB1;
+}
+
+static void sim_segv(int sig, siginfo_t* si, void* ctx)
+{
+    ucontext_t* uc = (ucontext_t*)ctx;
+    uintptr_t fault = (uintptr_t)si->si_addr;
+    sim_access_t* acc;
+    (void)sig;
+
+    uint8_t in_reg = fault >= SIM_PERIPH_BASE && fault < SIM_PERIPH_BASE + SIM_PERIPH_SIZE;
+    uint8_t in_scs = fault >= SIM_SCS_BASE && fault < SIM_SCS_BASE + SIM_SCS_SIZE;
+    uint8_t in_bb  = fault >= SIM_BB_BASE && fault < SIM_BB_BASE + SIM_BB_SIZE;
+
+    if ((!in_reg && !in_scs && !in_bb) || sim_npend >= 4)
+    {
+        signal(SIGSEGV, SIG_DFL);   // ķǷʣϵͳ
+        return;
+    }
+
+    acc = &sim_pend[sim_npend++];
+    acc->page  = (uint32_t)fault & ~(SIM_PAGE - 1);
+    acc->write = (uc->uc_mcontext.gregs[REG_ERR] & 0x2) != 0;
+    acc->alias = 0;
+
+    if (in_bb)
+    {
+        uint32_t off = (uint32_t)fault - SIM_BB_BASE;
+        uint32_t byte = SIM_PERIPH_BASE + off / 32;
+        acc->alias = (uint32_t)fault & ~3u;
+        acc->addr  = byte & ~3u;
+        acc->bit   = (uint8_t)((byte & 3) * 8 + (off / 4) % 8);
+    }
+    else acc->addr = (uint32_t)fault & ~3u;
+
+    sim_stat.bus_access++;
+    sim_set_now(sim_now_ps + sim_ps(sim_cost(acc->addr), sim_hclk_hz));
+    sim_catch_up();
+    sim_read_pre(acc->addr);
+    acc->old = SIM_REG32(acc->addr);
+
+    mprotect((void*)(uintptr_t)acc->page, SIM_PAGE, PROT_READ | PROT_WRITE);
+    if (acc->alias) *(volatile uint32_t*)(uintptr_t)acc->alias = (acc->old >> acc->bit) & 1;
+    uc->uc_mcontext.gregs[REG_EFL] |= 0x100;   // TF: ִһָ SIGTRAP
+}
+
+static void sim_trap(int sig, siginfo_t* si, void* ctx)
+{
+    ucontext_t* uc = (ucontext_t*)ctx;
+    (void)sig; (void)si;
+
+    uc->uc_mcontext.gregs[REG_EFL] &= ~0x100;
+
+    while (sim_npend > 0)
+    {
+        sim_access_t acc = sim_pend[--sim_npend];
+        uint32_t bb_val = acc.alias ? *(volatile uint32_t*)(uintptr_t)acc.alias : 0;
+        mprotect((void*)(uintptr_t)acc.page, SIM_PAGE, PROT_NONE);
+
+        if (acc.write)
+        {
+            if (acc.alias)
+            {
+                uint32_t m = 1u << acc.bit;
+                SIM_REG32(acc.addr) = (bb_val & 1) ? (acc.old | m) : (acc.old & ~m);
+            }
+            sim_write_post(acc.addr, acc.old);
+            sim_poll_addr = 0;
+        }
+        else
+        {
+            sim_read_post(acc.addr);
+            sim_poll_check(acc.alias ? acc.alias : acc.addr, acc.alias ? (acc.old >> acc.bit) & 1 : acc.old);
+        }
+    }
+
+    sim_dma_service();
+    sim_dispatch();
+}
+
+// ===============================================================================
+// λֵ
+// ===============================================================================
+static void sim_reset(void)
+{
+    static const uint32_t gpio_base[7] = {GPIOA_BASE, GPIOB_BASE, GPIOC_BASE, GPIOD_BASE, GPIOE_BASE, GPIOF_BASE, GPIOG_BASE};
+    static const struct { uint32_t base; uint8_t apb2; IRQn_Type irqn; uint8_t up_dma; } tim_def[8] = {
+        {TIM1_BASE, 1, TIM1_UP_IRQn, SIM_DMA1(5)}, {TIM8_BASE, 1, TIM8_UP_IRQn, SIM_DMA2(1)},
+        {TIM2_BASE, 0, TIM2_IRQn,    SIM_DMA1(2)}, {TIM3_BASE, 0, TIM3_IRQn,    SIM_DMA1(3)},
+        {TIM4_BASE, 0, TIM4_IRQn,    SIM_DMA1(7)}, {TIM5_BASE, 0, TIM5_IRQn,    SIM_DMA2(2)},
+        {TIM6_BASE, 0, TIM6_IRQn,    SIM_DMA2(3)}, {TIM7_BASE, 0, TIM7_IRQn,    SIM_DMA2(4)},
+    };
+    static const struct { uint32_t base; uint8_t apb2; IRQn_Type irqn; uint8_t tx, rx; } uart_def[5] = {
+        {USART1_BASE, 1, USART1_IRQn, SIM_DMA1(4), SIM_DMA1(5)},
+        {USART2_BASE, 0, USART2_IRQn, SIM_DMA1(7), SIM_DMA1(6)},
+        {USART3_BASE, 0, USART3_IRQn, SIM_DMA1(2), SIM_DMA1(3)},
+        {UART4_BASE,  0, UART4_IRQn,  SIM_DMA2(5), SIM_DMA2(3)},
+        {UART5_BASE,  0, UART5_IRQn,  SIM_DMA_NONE, SIM_DMA_NONE},
+    };
+    static const struct { uint32_t base; uint8_t apb2; IRQn_Type irqn; uint8_t tx, rx; } spi_def[3] = {
+        {SPI1_BASE, 1, SPI1_IRQn, SIM_DMA1(3), SIM_DMA1(2)},
+        {SPI2_BASE, 0, SPI2_IRQn, SIM_DMA1(5), SIM_DMA1(4)},
+        {SPI3_BASE, 0, SPI3_IRQn, SIM_DMA2(2), SIM_DMA2(1)},
+    };
+    static const IRQn_Type dma_irq[SIM_DMA_CH_NUM] = {
+        DMA1_Channel1_IRQn, DMA1_Channel2_IRQn, DMA1_Channel3_IRQn, DMA1_Channel4_IRQn,
+        DMA1_Channel5_IRQn, DMA1_Channel6_IRQn, DMA1_Channel7_IRQn,
+        DMA2_Channel1_IRQn, DMA2_Channel2_IRQn, DMA2_Channel3_IRQn, DMA2_Channel4_5_IRQn, DMA2_Channel4_5_IRQn
+    };
+
+    memset(sim_periph_view, 0, SIM_PERIPH_SIZE);
+    memset(sim_scs_view, 0, SIM_SCS_SIZE);
+    memset((void*)(uintptr_t)SIM_FLASH_BASE, 0xFF, SIM_FLASH_SIZE);
+
+    sim_now_ps = 0; sim_cycle = 0; sim_cycle_rem = 0; sim_dwt_base = 0;
+    memset(&sim_stat, 0, sizeof(sim_stat));
+    memset(sim_nvic_enable, 0, sizeof(sim_nvic_enable));
+    memset(sim_nvic_pending, 0, sizeof(sim_nvic_pending));
+    memset(sim_nvic_active, 0, sizeof(sim_nvic_active));
+    sim_exec_prio = 0x100;
+    sim_primask   = 0;
+    sim_flash_key = 0;
+    memset(&sim_can, 0, sizeof(sim_can));
+
+    // RCC: HSI SYSCLK = HSI 8MHz
+    SIM_PERIPH(RCC_TypeDef, RCC_BASE)->CR = 0x00000083;
+    SIM_PERIPH(FLASH_TypeDef, FLASH_R_BASE)->CR = FLASH_CR_LOCK;
+    SIM_PERIPH(FLASH_TypeDef, FLASH_R_BASE)->ACR = 0x30;
+    sim_clock_update();
+
+    for (int i = 0; i < 7; i++)
+    {
+        memset(&sim_gpio[i], 0, sizeof(sim_gpio[i]));
+        sim_gpio[i].base = gpio_base[i];
+        SIM_PERIPH(GPIO_TypeDef, gpio_base[i])->CRL = 0x44444444;   // λȫ
+        SIM_PERIPH(GPIO_TypeDef, gpio_base[i])->CRH = 0x44444444;
+    }
+
+    for (int i = 0; i < SIM_DMA_CH_NUM; i++)
+    {
+        memset(&sim_dma[i], 0, sizeof(sim_dma[i]));
+        sim_dma[i].dma_base   = (i < 7) ? DMA1_BASE : DMA2_BASE;
+        sim_dma[i].ch_base    = ((i < 7) ? DMA1_Channel1_BASE : DMA2_Channel1_BASE) + 0x14 * ((i < 7) ? i : i - 7);
+        sim_dma[i].flag_shift = (uint8_t)(4 * ((i < 7) ? i : i - 7));
+        sim_dma[i].irqn       = dma_irq[i];
+        sim_dma[i].next_m2m   = SIM_NEVER;
+    }
+
+    memset(&sim_st, 0, sizeof(sim_st));
+    sim_st.next_zero = SIM_NEVER;
+    SIM_REG32(SysTick_BASE + SIM_OFF(SysTick_Type, CALIB)) = 9000;
+
+    for (int i = 0; i < 8; i++)
+    {
+        memset(&sim_tim[i], 0, sizeof(sim_tim[i]));
+        sim_tim[i].base    = tim_def[i].base;
+        sim_tim[i].is_apb2 = tim_def[i].apb2;
+        sim_tim[i].irqn    = tim_def[i].irqn;
+        sim_tim[i].up_dma  = tim_def[i].up_dma;
+        sim_tim[i].next_upd = SIM_NEVER;
+        SIM_PERIPH(TIM_TypeDef, tim_def[i].base)->ARR = 0xFFFF;
+        sim_tim[i].arr = 0xFFFF;
+    }
+
+    for (int i = 0; i < 5; i++)
+    {
+        memset(&sim_uart[i], 0, sizeof(sim_uart[i]));
+        sim_uart[i].base    = uart_def[i].base;
+        sim_uart[i].is_apb2 = uart_def[i].apb2;
+        sim_uart[i].irqn    = uart_def[i].irqn;
+        sim_uart[i].tx_dma  = uart_def[i].tx;
+        sim_uart[i].rx_dma  = uart_def[i].rx;
+        sim_uart[i].shift_end = sim_uart[i].rx_next = sim_uart[i].idle_at = SIM_NEVER;
+        SIM_PERIPH(USART_TypeDef, uart_def[i].base)->SR = USART_SR_TXE | USART_SR_TC;
+    }
+
+    for (int i = 0; i < 3; i++)
+    {
+        memset(&sim_spi[i], 0, sizeof(sim_spi[i]));
+        sim_spi[i].base    = spi_def[i].base;
+        sim_spi[i].is_apb2 = spi_def[i].apb2;
+        sim_spi[i].irqn    = spi_def[i].irqn;
+        sim_spi[i].tx_dma  = spi_def[i].tx;
+        sim_spi[i].rx_dma  = spi_def[i].rx;
+        sim_spi[i].shift_end = SIM_NEVER;
+        SIM_PERIPH(SPI_TypeDef, spi_def[i].base)->SR = SPI_SR_TXE;
+    }
+
+    memset(&sim_adc, 0, sizeof(sim_adc));
+    for (int ch = 0; ch < 16; ch++) sim_adc.input[ch] = 2048;
+    sim_adc.input[16] = 1755;   // ¶ȴ 25C Լ 1.41V
+    sim_adc.input[17] = 1489;   // VREFINT 1.20V @ VDDA=3.3V
+    sim_adc.conv_end = sim_adc.cal_end = sim_adc.jconv_end = SIM_NEVER;
+
+    CAN_TypeDef* can = SIM_PERIPH(CAN_TypeDef, CAN1_BASE);
+    can->MCR = 0x00010002;
+    can->MSR = 0x00000C02;
+    can->TSR = CAN_TSR_TME0 | CAN_TSR_TME1 | CAN_TSR_TME2;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       ʼ
+// ˵      void
+// ز      void
+// ʹʾ      RUN_sim_init(); SystemInit(); SystemCoreClockUpdate(); ...֮ճ RUN_xxx 
+// עϢ      Ĵļӳ䡢װزָλֵظԸλ
+//-------------------------------------------------------------------------------------------------------------------
+void RUN_sim_init(void)
+{
+    static uint8_t mapped = 0;
+
+    if (!mapped)
+    {
+        int fd = memfd_create("run_sim_regs", 0);
+        if (fd < 0 || ftruncate(fd, SIM_PERIPH_SIZE + SIM_SCS_SIZE) != 0) { perror("RUN_sim_init"); exit(1); }
+
+        void* p1 = mmap((void*)(uintptr_t)SIM_PERIPH_BASE, SIM_PERIPH_SIZE, PROT_NONE, MAP_SHARED | MAP_FIXED_NOREPLACE, fd, 0);
+        void* p2 = mmap((void*)(uintptr_t)SIM_SCS_BASE, SIM_SCS_SIZE, PROT_NONE, MAP_SHARED | MAP_FIXED_NOREPLACE, fd, SIM_PERIPH_SIZE);
+        void* p3 = mmap((void*)(uintptr_t)SIM_BB_BASE, SIM_BB_SIZE, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+        void* p4 = mmap((void*)(uintptr_t)SIM_FLASH_BASE, SIM_FLASH_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+        sim_periph_view = mmap(NULL, SIM_PERIPH_SIZE + SIM_SCS_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+        if (p1 == MAP_FAILED || p2 == MAP_FAILED || p3 == MAP_FAILED || p4 == MAP_FAILED || sim_periph_view == MAP_FAILED)
+        {
+            fprintf(stderr, "RUN_sim_init: ޷ӳ STM32 ַռ (ִļ -no-pie )\n");
+            exit(1);
+        }
+        sim_scs_view = sim_periph_view + SIM_PERIPH_SIZE;
+
+        struct sigaction sa;
+        memset(&sa, 0, sizeof(sa));
+        sa.sa_flags = SA_SIGINFO | SA_NODEFER;
+        sa.sa_sigaction = sim_segv;
+        sigaction(SIGSEGV, &sa, NULL);
+        sa.sa_sigaction = sim_trap;
+        sigaction(SIGTRAP, &sa, NULL);
+        mapped = 1;
+    }
+
+    sim_reset();
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       PRIMASK д ( core_cm3.c еĻʵ)
+// עϢ      ٽ __get_PRIMASK / __set_PRIMASK ָ
+//               ݴͣжɷָʱڼж
+//-------------------------------------------------------------------------------------------------------------------
+uint32_t __get_PRIMASK(void) { return sim_primask; }
+
+void __set_PRIMASK(uint32_t priMask)
+{
+    sim_primask = priMask & 1;
+    if (!sim_primask) sim_dispatch();
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       ȡʱ
+// ز      uint64_t        HCLK  / 
+// עϢ      ÿʱ䵱ʱ HCLK ۼӣлʱҲֵ
+//-------------------------------------------------------------------------------------------------------------------
+uint64_t RUN_sim_cycles(void)  { return sim_cycle; }
+uint64_t RUN_sim_time_ns(void) { return sim_now_ps / 1000; }
+uint32_t RUN_sim_hclk(void)    { return sim_hclk_hz; }
+
+//-------------------------------------------------------------------------------------------------------------------
+//       CPU תƽʱ
+// ˵      cycles          HCLK 
+// ز      void
+// ʹʾ      RUN_sim_run(72000); // ת 1msڼĶʱ/¼ж϶ᰴ˳
+// עϢ      ѭѯ RAM ״̬ ( RUN_uart_packet_get) ʱ裬ʱ䲻ǰ
+//               ʱӦñ"Ӳ"
+//-------------------------------------------------------------------------------------------------------------------
+void RUN_sim_run(uint32_t cycles)
+{
+    uint64_t end = sim_now_ps + sim_ps(cycles, sim_hclk_hz);
+
+    for (;;)
+    {
+        uint64_t ev = sim_next_event();
+        if (ev > end) break;
+        sim_set_now(ev);
+        sim_catch_up();
+        sim_dispatch();
+    }
+    sim_set_now(end);
+    sim_catch_up();
+    sim_dispatch();
+}
+
+void RUN_sim_run_us(uint32_t us)
+{
+    RUN_sim_run((uint32_t)((uint64_t)us * sim_hclk_hz / 1000000));
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       ⲿ GPIO ŵƽ
+// ˵      pin              ( A0)
+// ˵      level           0/1
+// ز      void
+// עϢ      Ϊʱı IDR AFIO_EXTICR/RTSR/FTSR  EXTI ж
+//-------------------------------------------------------------------------------------------------------------------
+void RUN_sim_gpio_input(RUN_GPIO_enum pin, uint8_t level)
+{
+    if (pin >= RUN_GPIO_MAX) return;
+    int idx = pin / 16;
+    uint16_t bit = 1 << (pin % 16);
+    uint16_t old = sim_gpio_idr(idx);
+
+    sim_gpio[idx].ext_driven |= bit;
+    if (level) sim_gpio[idx].ext_level |= bit;
+    else       sim_gpio[idx].ext_level &= ~bit;
+
+    sim_exti_edge(idx, old, sim_gpio_idr(idx));
+    sim_dispatch();
+}
+
+void RUN_sim_gpio_hook(RUN_sim_gpio_hook_t hook) { sim_gpio_hook = hook; }
+
+//-------------------------------------------------------------------------------------------------------------------
+//       򴮿 RX 
+// ˵      uart            USART1 ~ UART5
+// ˵      data/len        ֽ
+// ز      void
+// עϢ      ֽڰǰ BRR Ӧַʱε ( RXNE ORE)һֽںһ֡ʱ IDLE
+//-------------------------------------------------------------------------------------------------------------------
+void RUN_sim_uart_rx(USART_TypeDef* uart, const uint8_t* data, uint32_t len)
+{
+    for (int i = 0; i < 5; i++)
+    {
+        sim_uart_t* u = &sim_uart[i];
+        if (u->base != (uint32_t)(uintptr_t)uart) continue;
+
+        for (uint32_t k = 0; k < len; k++)
+        {
+            uint32_t next = (u->rx_head + 1) % SIM_UART_FIFO;
+            if (next == u->rx_tail) break;
+            u->rx_fifo[u->rx_head] = data[k];
+            u->rx_head = next;
+        }
+        if (u->rx_next == SIM_NEVER && u->rx_head != u->rx_tail)
+            u->rx_next = sim_now_ps + sim_uart_char_ps(u);
+        return;
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       ȡߴ TX Ѿλֽ
+// ز      uint32_t        ʵȡֽ
+//-------------------------------------------------------------------------------------------------------------------
+uint32_t RUN_sim_uart_tx(USART_TypeDef* uart, uint8_t* out, uint32_t max)
+{
+    uint32_t n = 0;
+    for (int i = 0; i < 5; i++)
+    {
+        sim_uart_t* u = &sim_uart[i];
+        if (u->base != (uint32_t)(uintptr_t)uart) continue;
+        while (n < max && u->tx_tail != u->tx_head)
+        {
+            out[n++] = u->tx_log[u->tx_tail];
+            u->tx_tail = (u->tx_tail + 1) % SIM_UART_FIFO;
+        }
+    }
+    return n;
+}
+
+void RUN_sim_uart_hook(RUN_sim_uart_hook_t hook) { sim_uart_hook = hook; }
+void RUN_sim_spi_slave(RUN_sim_spi_slave_t slave) { sim_spi_slave = slave; }
+
+void RUN_sim_adc_input(uint8_t ch, uint16_t value)
+{
+    if (ch < 18) sim_adc.input[ch] = value & 0xFFF;
+}
+
+void RUN_sim_get_stat(RUN_sim_stat_t* stat)
+{
+    *stat = sim_stat;
+}
@@ -0,0 +1,76 @@
+#ifndef _RUN_SIM_H_
+#define _RUN_SIM_H_
+
+// ==========================================================
+// RUN  (Linux x86-64 + gcc)
+// ----------------------------------------------------------
+//  0x40000000 0xE000E000 ں (NVIC/SysTick/SCB)
+// λԼ Flash ӳһĴļ
+// ճֱӶдĴÿηĴᱻأɷ
+// ƽʱ䡢״̬ (TXE/RXNEDMA CNDTR ʱ¼...)
+// Ҫʱֱӵе xxx_IRQHandler жϷ
+// Ϊ gcc 룬Ĺ (ֻӰ룬߼)
+// RUN_header_file.h  __weakRUN_UART.c İ/fputc ض޶ ARMCC £
+// RUN_ADC.c / RUN_OneWire.h  #include ļСдĳļһ¡
+// ==========================================================
+
+#include "stm32f10x.h"
+#include "RUN_Gpio.h"
+
+// --- ʱģ ---
+// ʱ HCLK ڼơÿʰ߼ȴڣ
+// CPU ָʱ (ⲻָ)Ҫתʱ RUN_sim_run
+#define RUN_SIM_COST_AHB     2   // DMA/RCC/FLASH Ĵ (HCLK )
+#define RUN_SIM_COST_APB2    3   // GPIO/AFIO/EXTI/USART1/SPI1/TIM1/TIM8/ADC
+#define RUN_SIM_COST_APB1    5   // TIM2~7/USART2~5/SPI2/SPI3/CAN
+#define RUN_SIM_COST_CORE    1   // NVIC/SysTick/SCB
+#define RUN_SIM_COST_IRQ     12  // жϽ˳ (Cortex-M3 ѹջ/ջ)
+
+// ⲿ HSE Ƶ ( system_stm32f10x.c е HSE_VALUE һ)
+#define RUN_SIM_HSE_HZ       8000000
+
+// --- ص ---
+typedef void    (*RUN_sim_gpio_hook_t)(GPIO_TypeDef* port, uint16_t odr, uint64_t cycle);
+typedef void    (*RUN_sim_uart_hook_t)(USART_TypeDef* uart, uint8_t dat, uint64_t cycle);
+typedef uint8_t (*RUN_sim_spi_slave_t)(SPI_TypeDef* spi, uint8_t mosi);
+
+// --- ͳϢ ---
+typedef struct {
+    uint64_t bus_access;    // Ĵʴ
+    uint64_t irq_count;     // ѽжϴ
+    uint64_t dma_items;     // DMA ˵
+} RUN_sim_stat_t;
+
+// ==========================================================
+// 
+// ==========================================================
+
+// 1. ʼ (κμĴ֮ǰãֱӵ SystemInit)
+void     RUN_sim_init(void);
+
+// 2. ʱ
+uint64_t RUN_sim_cycles(void);                  // ǰʱ (HCLK )
+uint64_t RUN_sim_time_ns(void);                 // ǰʱ ()
+uint32_t RUN_sim_hclk(void);                    // ǰ HCLK Ƶ ( RCC ʵü)
+void     RUN_sim_run(uint32_t cycles);          // CPU ת cycles  HCLK ڣڼ䴦¼ж
+void     RUN_sim_run_us(uint32_t us);           // CPU ת΢
+
+// 3. GPIO ⲿ
+void     RUN_sim_gpio_input(RUN_GPIO_enum pin, uint8_t level);  // ⲿŵƽ (ɴ EXTI)
+void     RUN_sim_gpio_hook(RUN_sim_gpio_hook_t hook);           // ODR ÿα仯ʱص (μ¼)
+
+// 4. 
+void     RUN_sim_uart_rx(USART_TypeDef* uart, const uint8_t* data, uint32_t len); // ֽ RX
+uint32_t RUN_sim_uart_tx(USART_TypeDef* uart, uint8_t* out, uint32_t max);        // ȡѷֽ
+void     RUN_sim_uart_hook(RUN_sim_uart_hook_t hook);                              // ÿһֽڻص
+
+// 5. SPI ӻ (Ĭ MISO Ϊ 0xFF)
+void     RUN_sim_spi_slave(RUN_sim_spi_slave_t slave);
+
+// 6. ADC ģ (ch: 0~17, value: 0~4095)
+void     RUN_sim_adc_input(uint8_t ch, uint16_t value);
+
+// 7. ͳ
+void     RUN_sim_get_stat(RUN_sim_stat_t* stat);
+
+#endif
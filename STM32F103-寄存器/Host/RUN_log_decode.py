@@ -0,0 +1,188 @@
+#!/usr/bin/env python3
+# ==========================================================
+# RUN_Log 电脑端解码器
+# ----------------------------------------------------------
+# 把 RUN_log_poll() 发出的二进制帧还原成文本，格式串从固件 ELF (.axf) 里读。
+#
+#   python3 RUN_log_decode.py Objects/Project.axf capture.bin
+#   stty -F /dev/ttyUSB0 921600 raw && python3 RUN_log_decode.py Objects/Project.axf /dev/ttyUSB0
+#
+# 只用 Python 标准库。不是日志帧的数据 (例如同一串口上的 printf 文本) 原样输出。
+# 固件在每帧前补一个 0x00，文本和帧各自成段；旧固件没有这个分隔符时，
+# 文本会和紧跟的帧连成一段，这时从段尾往前找一个校验通过的日志帧，前面的部分当文本输出。
+# ==========================================================
+
+import re
+import struct
+import sys
+
+LOG_FRAME_TYPE = 0x7F
+LOG_DROP_TYPE  = 0x7E
+LOG_MAX_ARGS   = 8
+# 最长日志帧 COBS 编码后的长度 (不含结尾 0x00)：type + (1 + 参数) * 4 + CRC，再加 COBS 开销
+LOG_ENCODED_MAX = 1 + (1 + (1 + LOG_MAX_ARGS) * 4 + 2) + 1
+
+SPEC = re.compile(r'%([-+ #0]*\d*(?:\.\d+)?)(hh|h|ll|l|z|j|t)?([diuoxXcsfFeEgGp%])')
+
+
+class Elf:
+    """ELF32/ELF64 小端，只取占内存的 PROGBITS 段做 地址 -> 内容 映射"""
+
+    def __init__(self, path):
+        with open(path, 'rb') as f:
+            self.data = f.read()
+        d = self.data
+        if d[:4] != b'\x7fELF' or d[5] != 1:
+            raise ValueError('%s: not a little-endian ELF file' % path)
+        if d[4] == 1:
+            shoff, = struct.unpack_from('<I', d, 0x20)
+            shentsize, shnum = struct.unpack_from('<HH', d, 0x2E)
+            fmt = '<IIIIIIIIII'
+        else:
+            shoff, = struct.unpack_from('<Q', d, 0x28)
+            shentsize, shnum = struct.unpack_from('<HH', d, 0x3A)
+            fmt = '<IIQQQQIIQQ'
+        self.sections = []
+        for i in range(shnum):
+            sh = struct.unpack_from(fmt, d, shoff + i * shentsize)
+            sh_type, sh_flags, sh_addr, sh_offset, sh_size = sh[1], sh[2], sh[3], sh[4], sh[5]
+            if sh_type == 1 and (sh_flags & 0x2) and sh_size:     # PROGBITS + ALLOC
+                self.sections.append((sh_addr, sh_size, sh_offset))
+
+    def resolve(self, addr24):
+        """固件只发地址低 24 位，按每个段的高位补全"""
+        for addr, size, off in self.sections:
+            full = (addr & ~0xFFFFFF) | addr24
+            if addr <= full < addr + size:
+                return full
+        return None
+
+    def string(self, addr):
+        for base, size, off in self.sections:
+            if base <= addr < base + size:
+                start = off + addr - base
+                end = self.data.find(b'\0', start, off + size)
+                return self.data[start:end if end >= 0 else off + size].decode('gbk', 'replace')
+        return None
+
+
+def cobs_decode(chunk):
+    out = bytearray()
+    i = 0
+    while i < len(chunk):
+        code = chunk[i]
+        if code == 0 or i + code > len(chunk):
+            return None
+        out += chunk[i + 1:i + code]
+        i += code
+        if code != 0xFF and i < len(chunk):
+            out.append(0)
+    return bytes(out)
+
+
+def crc16(data, crc=0xFFFF):
+    for b in data:
+        crc ^= b << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) & 0xFFFF if crc & 0x8000 else (crc << 1) & 0xFFFF
+    return crc
+
+
+def format_record(elf, words):
+    nargs, addr24 = words[0] >> 24, words[0] & 0xFFFFFF
+    args = words[1:1 + nargs]
+    addr = elf.resolve(addr24)
+    fmt = elf.string(addr) if addr is not None else None
+    if fmt is None:
+        return '<log: unknown format 0x%06X %s>\n' % (addr24, ' '.join('0x%08X' % a for a in args))
+
+    out, pos, k = [], 0, 0
+    for m in SPEC.finditer(fmt):
+        out.append(fmt[pos:m.start()])
+        pos = m.end()
+        flags, conv = m.group(1), m.group(3)
+        if conv == '%':
+            out.append('%')
+            continue
+        if k >= len(args):
+            out.append('<?>')
+            continue
+        v = args[k]
+        k += 1
+        if conv in 'di':
+            out.append(('%' + flags + 'd') % (v - (1 << 32) if v & 0x80000000 else v))
+        elif conv in 'fFeEgG':
+            out.append(('%' + flags + conv) % struct.unpack('<f', struct.pack('<I', v))[0])
+        elif conv == 's':
+            s = elf.string(v)
+            out.append(('%' + flags + 's') % (s if s is not None else '<0x%08X>' % v))
+        elif conv == 'c':
+            out.append(chr(v & 0xFF))
+        elif conv == 'p':
+            out.append('0x%08X' % v)
+        else:
+            out.append(('%' + flags + conv) % v)
+    out.append(fmt[pos:])
+    return ''.join(out)
+
+
+def parse_frame(chunk):
+    """COBS + CRC 都通过返回 (type, payload)，否则 None"""
+    frame = cobs_decode(chunk)
+    if frame is None or len(frame) < 3 or crc16(frame) != 0:
+        return None
+    return frame[0], frame[1:-2]
+
+
+def is_log_frame(ftype, payload):
+    if ftype == LOG_FRAME_TYPE:
+        return 4 <= len(payload) <= (1 + LOG_MAX_ARGS) * 4 and len(payload) % 4 == 0
+    return ftype == LOG_DROP_TYPE and len(payload) == 4
+
+
+def format_frame(elf, ftype, payload):
+    if ftype == LOG_FRAME_TYPE:
+        return format_record(elf, struct.unpack('<%dI' % (len(payload) // 4), payload))
+    return '<log: %d records dropped so far>\n' % struct.unpack('<I', payload)[0]
+
+
+def decode_chunk(elf, chunk):
+    parsed = parse_frame(chunk)
+    if parsed is not None:
+        if is_log_frame(*parsed):
+            return format_frame(elf, *parsed)
+        return ''                                        # 其他类型的帧不属于日志
+
+    # 文本后面可能紧跟着一帧 (没有前导 0x00)：只在段尾一帧长度内找，最长的优先
+    for start in range(max(1, len(chunk) - LOG_ENCODED_MAX), len(chunk) - 2):
+        parsed = parse_frame(chunk[start:])
+        if parsed is not None and is_log_frame(*parsed):
+            return chunk[:start].decode('gbk', 'replace') + format_frame(elf, *parsed)
+    return chunk.decode('gbk', 'replace')                # 不是帧：原样输出
+
+
+def main():
+    if len(sys.argv) != 3:
+        sys.stderr.write('usage: %s firmware.axf capture.bin|/dev/ttyX|-\n' % sys.argv[0])
+        return 2
+    elf = Elf(sys.argv[1])
+    src = sys.stdin.buffer if sys.argv[2] == '-' else open(sys.argv[2], 'rb', buffering=0)
+    pending = bytearray()
+    while True:
+        data = src.read(4096)
+        if not data:
+            break
+        pending += data
+        while True:
+            end = pending.find(0)
+            if end < 0:
+                break
+            if end:
+                sys.stdout.write(decode_chunk(elf, bytes(pending[:end])))
+                sys.stdout.flush()
+            del pending[:end + 1]
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
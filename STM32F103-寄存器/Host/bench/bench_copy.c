@@ -0,0 +1,99 @@
+#include "RUN_header_file.h"
+#include "RUN_Sim.h"
+#include "RUN_Copy.h"
+
+// ==========================================================
+// DMA 첽 vs CPU  (make bench)
+// ----------------------------------------------------------
+// dma     :  RUN_copy_memcpy ύդɵķʱ (HCLK )
+//           ÿݵλ 4  HCLK ģ洢洢䣬
+//           ټļĴʡTC жϺͲοģǰʵ⡣
+// dma_cpu :  CPU ռõ (ʱȥȴʱĿתڣύ + жļĴ)
+// cpu     : ͬĿ CPU ɵڣ Cortex-M3 ָʱģ (ȴ SRAM)
+//            CPU ָһ bench_cpu_model ͬǰʵ⡣
+// 뷽ʽ src / dst  2 λ
+//   word 0/0   same 1/1 (ֽͷβ + )   half 2/0   byte 1/0
+// ==========================================================
+
+#define BENCH_MAX       65536
+
+// CPU memcpy ģ͸ε (Cortex-M3 TRMLDR 2Ƕ LDR  1STR 1LDM/STM 1+NSUBS 1ת 3)
+#define CPU_CALL        23      // BL + PUSH {r4-r10,lr} + POP {r4-r10,pc}
+#define CPU_BLOCK32     22      // LDM 8  + STM 8  + SUBS + BHS
+#define CPU_WORD        7       // LDR + STR + SUBS + BHS
+#define CPU_WORD_UNALN  8       // Ƕ LDR + STR + SUBS + BHS (src/dst  2 λͬ)
+#define CPU_BYTE        7       // LDRB + STRB + SUBS + BNE
+
+static uint32_t bench_src[BENCH_MAX / 4 + 1];
+static uint32_t bench_dst[BENCH_MAX / 4 + 1];
+
+// CPU ģֽͣڰ dst 뵽֣ 2 λͬ LDM/STM  + βͬ߷Ƕ LDRֽβ
+static uint32_t bench_cpu_model(uint32_t bytes, uint8_t src_off, uint8_t dst_off)
+{
+    uint32_t head = (4 - dst_off) & 3;
+    uint32_t cyc  = CPU_CALL;
+
+    if (head > bytes) head = bytes;
+    cyc   += head * CPU_BYTE;
+    bytes -= head;
+
+    if (((src_off ^ dst_off) & 3) == 0)
+    {
+        cyc   += (bytes / 32) * CPU_BLOCK32;
+        bytes %= 32;
+        cyc   += (bytes / 4) * CPU_WORD;
+    }
+    else
+    {
+        cyc   += (bytes / 4) * CPU_WORD_UNALN;
+    }
+    return cyc + (bytes % 4) * CPU_BYTE;
+}
+
+// DMA ڣ*busy Ϊ CPU ռõ
+static uint32_t bench_dma(uint32_t bytes, uint8_t src_off, uint8_t dst_off, uint32_t* busy)
+{
+    uint64_t t0, total;
+    uint32_t fence, idle = 0;
+
+    t0 = RUN_sim_cycles();
+    fence = RUN_copy_memcpy((uint8_t*)bench_dst + dst_off, (uint8_t*)bench_src + src_off, bytes);
+    if (fence == 0) return 0;
+    while (!RUN_copy_done(fence))
+    {
+        RUN_sim_run(1);                                 // ڴƽʱ䣬Ϊڿת
+        idle++;
+    }
+    if (memcmp((uint8_t*)bench_dst + dst_off, (uint8_t*)bench_src + src_off, bytes) != 0) return 0;
+    total = RUN_sim_cycles() - t0;
+    *busy = (uint32_t)total - idle;
+    return (uint32_t)total;
+}
+
+int main(void)
+{
+    static const uint32_t size[] = { 4, 64, 1024, 65536 };
+    static const struct { const char* name; uint8_t src, dst; } align[] = {
+        {"word", 0, 0}, {"same", 1, 1}, {"half", 2, 0}, {"byte", 1, 0}
+    };
+    uint32_t i, k, dma, busy, cpu;
+
+    RUN_sim_init();
+    SystemInit();
+    RUN_copy_init(RUN_DMA_PRIO_LOW);
+
+    for (i = 0; i < sizeof(bench_src); i++) ((uint8_t*)bench_src)[i] = (uint8_t)(i * 7 + 1);
+
+    printf("%8s %6s %10s %8s %10s %8s\n", "bytes", "align", "dma", "dma_cpu", "cpu", "dma/cpu");
+    for (i = 0; i < sizeof(size) / sizeof(size[0]); i++)
+    {
+        for (k = 0; k < sizeof(align) / sizeof(align[0]); k++)
+        {
+            busy = 0;
+            dma  = bench_dma(size[i], align[k].src, align[k].dst, &busy);
+            cpu  = bench_cpu_model(size[i], align[k].src, align[k].dst);
+            printf("%8u %6s %10u %8u %10u %8.2f\n", size[i], align[k].name, dma, busy, cpu, (double)dma / cpu);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,61 @@
+#include <x86intrin.h>
+#include "RUN_header_file.h"
+#include "RUN_Fmt.h"
+
+// ==========================================================
+// RUN_fmt vs snprintf (make bench)
+// ----------------------------------------------------------
+// 㣬 x86 ԭܣ rdtsc ÿεõ TSC  (ȡС)
+// յ glibc  snprintfû newlib / microlib
+//  MCU  C ĶԱͬѭŵ DWT CYCCNT ⡣
+// ==========================================================
+
+#define BENCH_LOOP      50000
+#define BENCH_ROUND     7           // ȡСֵȶ
+
+static volatile int32_t bench_in[6] = { 1234, -567, 17999, 3210, -4, 0x1A2B };
+static volatile char    bench_sink;
+
+#define BENCH(res, name, body)                                                  \
+    do {                                                                        \
+        uint64_t t0, t, best = ~0ull;                                           \
+        int      n, r;                                                          \
+        for (r = 0; r < BENCH_ROUND; r++)                                       \
+        {                                                                       \
+            t0 = __rdtsc();                                                     \
+            for (n = 0; n < BENCH_LOOP; n++) { body; bench_sink = buf[0]; }     \
+            t = __rdtsc() - t0;                                                 \
+            if (t < best) best = t;                                             \
+        }                                                                       \
+        res = (double)best / BENCH_LOOP;                                        \
+        printf("%-28s %8.1f\n", name, res);                                     \
+    } while (0)
+
+int main(void)
+{
+    char   buf[96];
+    double f_std, f_q, f_k, i_std, i_run;
+
+    // ͬһң⣺̬ (ȣλС) + ֶ
+    printf("%-28s %8s\n", "call", "tsc/call");
+    BENCH(f_std, "snprintf  %.2f x3 + ints",
+          snprintf(buf, sizeof(buf), "R=%.2f P=%.2f Y=%.2f rpm=%d err=%d st=%04X",
+                   bench_in[0] / 100.0f, bench_in[1] / 100.0f, bench_in[2] / 100.0f,
+                   bench_in[3], bench_in[4], bench_in[5]));
+    BENCH(f_q, "RUN_fmt   %.2q x3 + ints",
+          RUN_fmt(buf, sizeof(buf), "R=%.2q P=%.2q Y=%.2q rpm=%d err=%d st=%04X",
+                  RUN_FMT_Q16(bench_in[0] / 100.0f), RUN_FMT_Q16(bench_in[1] / 100.0f),
+                  RUN_FMT_Q16(bench_in[2] / 100.0f), bench_in[3], bench_in[4], bench_in[5]));
+    BENCH(f_k, "RUN_fmt   %.2k x3 + ints",
+          RUN_fmt(buf, sizeof(buf), "R=%.2k P=%.2k Y=%.2k rpm=%d err=%d st=%04X",
+                  bench_in[0], bench_in[1], bench_in[2], bench_in[3], bench_in[4], bench_in[5]));
+    BENCH(i_std, "snprintf  ints only",
+          snprintf(buf, sizeof(buf), "rpm=%d err=%d st=%04X", bench_in[3], bench_in[4], bench_in[5]));
+    BENCH(i_run, "RUN_fmt   ints only",
+          RUN_fmt(buf, sizeof(buf), "rpm=%d err=%d st=%04X", bench_in[3], bench_in[4], bench_in[5]));
+
+    // ֵ͸ر仯ͷļõǱֵ
+    printf("snprintf / RUN_fmt: %.1fx (%%.2q)  %.1fx (%%.2k)  %.1fx (ints only)\n",
+           f_std / f_q, f_std / f_k, i_std / i_run);
+    return 0;
+}
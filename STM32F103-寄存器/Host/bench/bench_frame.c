@@ -0,0 +1,101 @@
+#include <time.h>
+#include "RUN_header_file.h"
+#include "RUN_Sim.h"
+#include "RUN_Str.h"
+
+// ==========================================================
+// ıЭ vs ֡ (make bench)
+// ----------------------------------------------------------
+// 8  float ң⣬115200 8N1
+//   ϣָʽ DMA 巢 BENCH_PKT ʱ/
+//   CPU + BENCH_LOOP Σ x86 ԭʱ (
+//         㲻)ֻӳԿ MCU ϵĺʱ
+// ==========================================================
+
+#define BENCH_PKT       20
+#define BENCH_LOOP      200000
+#define BENCH_UART      UART1_TX_PA9_RX_PA10
+
+static const float bench_val[8] = { 12.345f, -3.210f, 0.500f, 100.250f, -45.678f, 7.000f, 0.012f, 3.142f };
+static volatile float bench_sink;
+
+static double bench_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static uint16_t bench_text_encode(char* out)
+{
+    return (uint16_t)sprintf(out, "@%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f\r\n",
+                             bench_val[0], bench_val[1], bench_val[2], bench_val[3],
+                             bench_val[4], bench_val[5], bench_val[6], bench_val[7]);
+}
+
+//  BENCH_PKT ذ/ (ʱ)
+static double bench_wire(const uint8_t* pkt, uint16_t len)
+{
+    static uint8_t wire[BENCH_PKT * 128];
+    uint64_t t0, t1;
+    int      i;
+
+    t0 = RUN_sim_cycles();
+    for (i = 0; i < BENCH_PKT; i++) RUN_uart_write_buffered(BENCH_UART, pkt, len);  // ʱԼ
+    RUN_uart_tx_flush(BENCH_UART);
+    t1 = RUN_sim_cycles();
+    RUN_sim_uart_tx(USART1, wire, sizeof(wire));
+    return BENCH_PKT * (double)RUN_sim_hclk() / (double)(t1 - t0);
+}
+
+int main(void)
+{
+    static uint8_t  frame[RUN_FRAME_ENCODED_MAX(sizeof(bench_val))], rx_buf[64];
+    static char     text[128];
+    RUN_frame_rx_t  rx;
+    float           out[8];
+    uint16_t        text_len, frame_len, i;
+    double          t0, t_text, t_frame, pps_text, pps_frame;
+    int             n;
+
+    RUN_sim_init();
+    SystemInit();
+    RUN_uart_init(BENCH_UART, 115200, 0);
+    RUN_uart_tx_dma_init(BENCH_UART, 0);
+
+    text_len  = bench_text_encode(text);
+    frame_len = RUN_frame_encode(1, bench_val, sizeof(bench_val), frame);
+
+    pps_text  = bench_wire((const uint8_t*)text, text_len);
+    pps_frame = bench_wire(frame, frame_len);
+
+    // ısprintf + RUN_Str_GetFloatArray
+    t0 = bench_now_ns();
+    for (n = 0; n < BENCH_LOOP; n++)
+    {
+        bench_text_encode(text);
+        RUN_Str_GetFloatArray(text, out, 8);
+        bench_sink = out[7];
+    }
+    t_text = (bench_now_ns() - t0) / BENCH_LOOP;
+
+    // ֡RUN_frame_encode + ֽ RUN_frame_rx_byte
+    RUN_frame_rx_init(&rx, rx_buf, sizeof(rx_buf));
+    t0 = bench_now_ns();
+    for (n = 0; n < BENCH_LOOP; n++)
+    {
+        frame_len = RUN_frame_encode(1, bench_val, sizeof(bench_val), frame);
+        for (i = 0; i < frame_len; i++)
+        {
+            if (RUN_frame_rx_byte(&rx, frame[i])) memcpy(out, rx_buf + 1, sizeof(out));
+        }
+        bench_sink = out[7];
+    }
+    t_frame = (bench_now_ns() - t0) / BENCH_LOOP;
+
+    printf("%-8s %6s %8s %12s\n", "format", "bytes", "pkt/s", "enc+dec(ns)");
+    printf("%-8s %6u %8.1f %12.1f\n", "text",  text_len,  pps_text,  t_text);
+    printf("%-8s %6u %8.1f %12.1f\n", "frame", frame_len, pps_frame, t_frame);
+    printf("frame/text: %.2fx pkt/s, %.2fx enc+dec time\n", pps_frame / pps_text, t_frame / t_text);
+    return 0;
+}
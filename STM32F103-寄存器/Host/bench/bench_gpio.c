@@ -0,0 +1,98 @@
+#include "RUN_header_file.h"
+#ifdef RUN_HOST_SIM
+#include "RUN_Sim.h"
+#endif
+
+// ==========================================================
+// GPIO · / · ÿεõ (make bench)
+// ----------------------------------------------------------
+//  DWT CYCCNT ʱȲһѭΪٿ۵Ϊÿεõ
+//  CYCCNT ֻۼ (APB2 ÿη 3 )
+//  CPU ָֻܿ˼μĴ
+//  bench_gpio() ڰܣͬĴõ CPU ڡ
+// ==========================================================
+
+#define BENCH_N             1000
+
+// DWT ڼ ( CMSIS 汾 core_cm3.h û DWT ṹ嶨)
+#define BENCH_DWT_CTRL      (*(volatile uint32_t*)0xE0001000)
+#define BENCH_DWT_CYCCNT    (*(volatile uint32_t*)0xE0001004)
+
+// Ķǰķתʵ (ODR --д)
+static void bench_toggle_v0(RUN_GPIO_enum pin)
+{
+    if (pin >= RUN_GPIO_MAX) return;
+    gpio_cfg[pin].port->ODR ^= gpio_cfg[pin].pin;
+}
+
+static uint32_t bench_base;                 // ѭ ()
+static volatile RUN_GPIO_enum bench_pin = C13;  // ţֹ۵
+static volatile uint8_t bench_sink;
+
+//  body BENCH_N Σӡÿεõƽ (ͷϵ߷ʴ)
+#ifdef RUN_HOST_SIM
+#define BENCH(name, body)                                                       \
+    do {                                                                        \
+        RUN_sim_stat_t s0, s1;                                                  \
+        uint32_t t0, t1, i;                                                     \
+        RUN_sim_get_stat(&s0);                                                  \
+        t0 = BENCH_DWT_CYCCNT;                                                  \
+        for (i = 0; i < BENCH_N; i++) { body; }                                 \
+        t1 = BENCH_DWT_CYCCNT;                                                  \
+        RUN_sim_get_stat(&s1);                                                  \
+        printf("%-36s %6.2f %8.2f\n", name,                                     \
+               (double)(t1 - t0 - bench_base) / BENCH_N,                        \
+               (double)(s1.bus_access - s0.bus_access) / BENCH_N);        \
+    } while (0)
+#else
+#define BENCH(name, body)                                                       \
+    do {                                                                        \
+        uint32_t t0, t1, i;                                                     \
+        t0 = BENCH_DWT_CYCCNT;                                                  \
+        for (i = 0; i < BENCH_N; i++) { body; }                                 \
+        t1 = BENCH_DWT_CYCCNT;                                                  \
+        printf("%-36s %6.2f\n", name, (double)(t1 - t0 - bench_base) / BENCH_N); \
+    } while (0)
+#endif
+
+//-------------------------------------------------------------------------------------------------------------------
+//       GPIO ·ʱͨ printf 
+// עϢ      C13 ѳʼΪڰжϻڿʱ
+//-------------------------------------------------------------------------------------------------------------------
+void bench_gpio(void)
+{
+    uint32_t t0, t1, i;
+
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    BENCH_DWT_CTRL   |= 1;
+
+    // ѭ (һζ bench_pinı)
+    t0 = BENCH_DWT_CYCCNT;
+    for (i = 0; i < BENCH_N; i++) { bench_sink = (uint8_t)bench_pin; }
+    t1 = BENCH_DWT_CYCCNT;
+    bench_base = t1 - t0;
+
+    // Ҳһ bench_pin֤ͻ߿۵ͬѭ
+    printf("%-36s %6s %8s\n", "path", "cyc", "bus_acc");
+    BENCH("RUN_gpio_set (table)",             RUN_gpio_set(bench_pin, i & 1));
+    BENCH("RUN_gpio_set_fast (var pin)",      RUN_gpio_set_fast(bench_pin, i & 1));
+    BENCH("RUN_gpio_set_fast (const pin)",    RUN_gpio_set_fast(C13, i & 1); bench_sink = (uint8_t)bench_pin);
+    BENCH("RUN_PIN_OUT (const pin)",          RUN_PIN_OUT(C13) = i & 1; bench_sink = (uint8_t)bench_pin);
+    BENCH("RUN_gpio_get (table)",             bench_sink = RUN_gpio_get(bench_pin));
+    BENCH("RUN_gpio_get_fast (var pin)",      bench_sink = RUN_gpio_get_fast(bench_pin));
+    BENCH("ODR ^= (old toggle)",              bench_toggle_v0(bench_pin));
+    BENCH("RUN_gpio_toggle (table)",          RUN_gpio_toggle(bench_pin));
+    BENCH("RUN_gpio_toggle_fast (var pin)",   RUN_gpio_toggle_fast(bench_pin));
+}
+
+#ifdef RUN_HOST_SIM
+int main(void)
+{
+    RUN_sim_init();
+    SystemInit();
+
+    RUN_gpio_init(C13, GPO, 1);
+    bench_gpio();
+    return 0;
+}
+#endif
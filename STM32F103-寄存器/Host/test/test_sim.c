@@ -0,0 +1,645 @@
+#include "RUN_header_file.h"
+#include "RUN_Sim.h"
+
+// ==========================================================
+// ع (make test)
+// ----------------------------------------------------------
+// ͬһʵϣ˳ִУʧʱӡļкţ
+// ˳Ϊʧܵļ0 ʾȫͨ
+// ==========================================================
+
+static int test_fail = 0;
+static int test_count = 0;
+
+#define CHECK(cond)                                                             \
+    do {                                                                        \
+        test_count++;                                                           \
+        if (!(cond)) { printf("FAIL %s:%d  %s\n", __FILE__, __LINE__, #cond); test_fail++; } \
+    } while (0)
+
+//-------------------------------------------------------------------------------------------------------------------
+// ʱSystemInit ֮ 72MHzAPB1 ƵAPB1 ʱʱӱƵ 72MHz
+//-------------------------------------------------------------------------------------------------------------------
+static void test_clock(void)
+{
+    const RUN_clock_t* clk = RUN_clock_update();
+
+    CHECK(clk->sysclk      == 72000000);
+    CHECK(clk->hclk        == 72000000);
+    CHECK(clk->pclk1       == 36000000);
+    CHECK(clk->pclk2       == 72000000);
+    CHECK(clk->apb1_timclk == 72000000);
+    CHECK(clk->apb2_timclk == 72000000);
+    CHECK(RUN_sim_hclk()   == 72000000);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// лƵл󱻵ã BRR / ʱ PSCARR ʱ㣬л 72MHz ԭָ
+//-------------------------------------------------------------------------------------------------------------------
+static uint32_t clock_hook_calls = 0;
+static uint32_t clock_hook_hclk  = 0;
+
+static void on_clock(const RUN_clock_t* old_clk, const RUN_clock_t* new_clk)
+{
+    (void)old_clk;
+    clock_hook_calls++;
+    clock_hook_hclk = new_clk->hclk;
+}
+
+static void test_clock_set(void)
+{
+    RUN_clock_latency_t lat;
+    uint16_t            psc, arr;
+
+    RUN_uart_init(UART2_TX_PA2_RX_PA3, 115200, 0);
+    CHECK(USART2->BRR == (36000000 + 57600) / 115200);
+    CHECK(RUN_timer_init_freq(RUN_TIM4, 1000) == 1000);
+    psc = TIM4->PSC;
+    arr = TIM4->ARR;
+    CHECK(RUN_clock_hook_add(on_clock) == 1);
+
+    CHECK(RUN_clock_set(RUN_CLOCK_HSI_8M, &lat) == 1);
+    CHECK(RUN_clock_get()->sysclk == 8000000);
+    CHECK(RUN_clock_get()->pclk1  == 8000000);
+    CHECK(RUN_sim_hclk() == 8000000);
+    CHECK(clock_hook_calls == 1 && clock_hook_hclk == 8000000);
+    CHECK(USART2->BRR == (8000000 + 57600) / 115200);
+    CHECK((uint32_t)(TIM4->PSC + 1) * (TIM4->ARR + 1) == 8000);   //  1kHz
+
+    CHECK(RUN_clock_set(RUN_CLOCK_PLL_72M, &lat) == 1);
+    CHECK(RUN_clock_get()->sysclk == 72000000);
+    CHECK(clock_hook_calls == 2 && clock_hook_hclk == 72000000);
+    CHECK(USART2->BRR == (36000000 + 57600) / 115200);
+    CHECK(TIM4->PSC == psc && TIM4->ARR == arr);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// GPIO··ű (ͻ / SWJ_CFG)
+//-------------------------------------------------------------------------------------------------------------------
+static void test_gpio(void)
+{
+    static const RUN_gpio_pinmux_t table[] = {
+        {A9,  AF_PP, 1, RUN_GPIO_REMAP_DEFAULT(AFIO_MAPR_USART1_REMAP)},
+        {B6,  AF_PP, 1, AFIO_MAPR_USART1_REMAP},                        // һͻ
+        {B3,  GPO,   0, AFIO_MAPR_SWJ_CFG_JTAGDISABLE},
+        {A0,  AIN,   0, 0},
+        {A0,  AIN,   0, 0},                                             // ȫͬظͻ
+    };
+    static const RUN_gpio_pinmux_t remap_only[] = {
+        {B6,  AF_PP, 1, AFIO_MAPR_USART1_REMAP},                        // 漰 SWJ_CFG
+    };
+    uint16_t first = 0xFFFF;
+
+    RUN_gpio_init(C13, GPO, 1);
+    CHECK(GPIOC->ODR & GPIO_Pin_13);
+    RUN_gpio_toggle(C13);
+    CHECK(!(GPIOC->ODR & GPIO_Pin_13));
+    RUN_gpio_set_fast(C13, 1);
+    CHECK(GPIOC->ODR & GPIO_Pin_13);
+    RUN_gpio_toggle_fast(C13);
+    CHECK(!(GPIOC->ODR & GPIO_Pin_13));
+    RUN_PIN_OUT(C13) = 1;
+    CHECK(GPIOC->ODR & GPIO_Pin_13);
+
+    RUN_gpio_init(A1, GPI, 0);
+    RUN_sim_gpio_input(A1, 1);
+    CHECK(RUN_gpio_get(A1) == 1);
+    CHECK(RUN_gpio_get_fast(A1) == 1);
+    RUN_sim_gpio_input(A1, 0);
+    CHECK(RUN_PIN_IN(A1) == 0);
+
+    CHECK(RUN_gpio_init_table(table, sizeof(table) / sizeof(table[0]), &first) == 1);
+    CHECK(first == 1);
+    CHECK((AFIO->MAPR & AFIO_MAPR_USART1_REMAP) == 0);
+    CHECK((AFIO->MAPR & AFIO_MAPR_SWJ_CFG) == AFIO_MAPR_SWJ_CFG_JTAGDISABLE);
+
+    // һűֻӳ䣺SWJ_CFG дؼסֵJTAG ᱻ´
+    CHECK(RUN_gpio_init_table(remap_only, 1, 0) == 0);
+    CHECK(AFIO->MAPR & AFIO_MAPR_USART1_REMAP);
+    CHECK((AFIO->MAPR & AFIO_MAPR_SWJ_CFG) == AFIO_MAPR_SWJ_CFG_JTAGDISABLE);
+    RUN_gpio_swj_config(AFIO_MAPR_SWJ_CFG_RESET);
+    CHECK((AFIO->MAPR & AFIO_MAPR_SWJ_CFG) == 0);
+    CHECK(AFIO->MAPR & AFIO_MAPR_USART1_REMAP);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//  4 βһ²ŷת 4 εĶ¼ /  / ɿ¼ʱ
+//-------------------------------------------------------------------------------------------------------------------
+static void key_scan_n(uint8_t n)
+{
+    while (n--) RUN_key_scan();
+}
+
+static void test_key(void)
+{
+    static const RUN_key_cfg_t keys[] = {
+        {B12, GPI_PU, 0},                                               // ½ӵ
+    };
+    RUN_key_event_t ev;
+
+    RUN_sim_gpio_input(B12, 1);
+    CHECK(RUN_key_init(keys, 1, 5, 100) == 1);
+    key_scan_n(4);
+    CHECK(RUN_key_get_event(&ev) == 0);
+
+    // 3 εĶ˵
+    RUN_sim_gpio_input(B12, 0);
+    key_scan_n(3);
+    RUN_sim_gpio_input(B12, 1);
+    key_scan_n(1);
+    CHECK(RUN_key_get_event(&ev) == 0);
+    CHECK(RUN_key_is_down(B12) == 0);
+
+    // ȶ£ 4 ɨ豨 PRESS
+    RUN_sim_gpio_input(B12, 0);
+    key_scan_n(3);
+    CHECK(RUN_key_is_down(B12) == 0);
+    key_scan_n(1);
+    CHECK(RUN_key_is_down(B12) == 1);
+    CHECK(RUN_key_get_event(&ev) == 1);
+    CHECK(ev.pin == B12 && ev.type == RUN_KEY_PRESS && ev.time_ms == 12 * 5);
+
+    // ס 100ms (20 ɨ) һ LONG
+    key_scan_n(19);
+    CHECK(RUN_key_get_event(&ev) == 0);
+    key_scan_n(1);
+    CHECK(RUN_key_get_event(&ev) == 1);
+    CHECK(ev.type == RUN_KEY_LONG && ev.time_ms == 32 * 5);
+    key_scan_n(20);
+    CHECK(RUN_key_get_event(&ev) == 0);
+
+    // ɿͬҪ 4 
+    RUN_sim_gpio_input(B12, 1);
+    key_scan_n(2);
+    RUN_sim_gpio_input(B12, 0);
+    key_scan_n(1);
+    RUN_sim_gpio_input(B12, 1);
+    key_scan_n(4);
+    CHECK(RUN_key_get_event(&ev) == 1);
+    CHECK(ev.type == RUN_KEY_RELEASE && ev.time_ms == 59 * 5);
+    CHECK(RUN_key_get_event(&ev) == 0);
+    CHECK(RUN_key_dropped() == 0);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// DMA ͨͻͷšʱʷǷʱ黹ͨη / ߼ǳʼʧͷ
+//-------------------------------------------------------------------------------------------------------------------
+static void test_dma(void)
+{
+    DMA_Channel_TypeDef* ch = RUN_DMA_Alloc(RUN_DMA_REQ_TIM6_UP);
+    RUN_wave_t           wave;
+    RUN_logic_t          la;
+    static uint16_t      la_buf[16];
+    static const uint32_t words[2] = { RUN_WAVE_WORD(GPIO_Pin_0, 0), RUN_WAVE_WORD(0, GPIO_Pin_0) };
+
+    CHECK(ch == DMA2_Channel3);
+    CHECK(RUN_DMA_Alloc(RUN_DMA_REQ_UART4_RX) == 0);           // ͬһͨ
+    CHECK(RUN_DMA_Alloc(RUN_DMA_REQ_TIM6_UP) == ch);           // ͬһظ
+    CHECK(RUN_DMA_Free(ch, RUN_DMA_REQ_UART4_RX) == 0);        // ռ
+    CHECK(RUN_DMA_Owner(ch) == RUN_DMA_REQ_TIM6_UP);
+    CHECK(RUN_DMA_Free(ch, RUN_DMA_REQ_TIM6_UP) == 1);
+    CHECK(RUN_DMA_Owner(ch) == RUN_DMA_REQ_NONE);
+
+    CHECK(RUN_wave_init(&wave, RUN_TIM6, GPIOB, 0) == 0);
+    CHECK(RUN_DMA_Owner(ch) == RUN_DMA_REQ_NONE);
+    CHECK(RUN_DMA_Alloc(RUN_DMA_REQ_UART4_RX) == ch);
+
+    // ͨռʱʼʧܣ֮ start / stop / deinit ǿղ
+    CHECK(RUN_wave_init(&wave, RUN_TIM6, GPIOB, 1000) == 0);
+    CHECK(wave.dma == 0);
+    RUN_wave_start(&wave, words, 2, RUN_DMA_MODE_NORMAL, 0);
+    RUN_wave_stop(&wave);
+    RUN_wave_deinit(&wave);
+    CHECK(RUN_DMA_Owner(ch) == RUN_DMA_REQ_UART4_RX);
+    CHECK(RUN_DMA_Free(ch, RUN_DMA_REQ_UART4_RX) == 1);
+
+    // ʼ deinit 黹ͨ
+    CHECK(RUN_wave_init(&wave, RUN_TIM6, GPIOB, 1000) != 0);
+    CHECK(RUN_DMA_Owner(ch) == RUN_DMA_REQ_TIM6_UP);
+    RUN_wave_deinit(&wave);
+    CHECK(RUN_DMA_Owner(ch) == RUN_DMA_REQ_NONE);
+
+    // ߼ͬʼʧܺ arm / abort  DMAdeinit 黹ͨ
+    ch = RUN_DMA_Alloc(RUN_DMA_REQ_SDIO);
+    CHECK(ch == DMA2_Channel4);
+    CHECK(RUN_logic_init(&la, RUN_TIM7, GPIOB, 100000, la_buf, 16) == 0);
+    CHECK(la.dma == 0);
+    RUN_logic_arm(&la, (RUN_EXTI_Pin_enum)RUN_LOGIC_NO_TRIGGER, EXTI_Trigger_Rising, 0);
+    RUN_logic_abort(&la);
+    RUN_logic_deinit(&la);
+    CHECK(RUN_DMA_Free(ch, RUN_DMA_REQ_SDIO) == 1);
+
+    CHECK(RUN_logic_init(&la, RUN_TIM7, GPIOB, 100000, la_buf, 16) != 0);
+    CHECK(RUN_DMA_Owner(ch) == RUN_DMA_REQ_TIM7_UP);
+    RUN_logic_arm(&la, (RUN_EXTI_Pin_enum)RUN_LOGIC_NO_TRIGGER, EXTI_Trigger_Rising, 0);
+    RUN_sim_run_us(400);
+    CHECK(RUN_logic_done(&la));
+    RUN_logic_deinit(&la);
+    CHECK(RUN_DMA_Owner(ch) == RUN_DMA_REQ_NONE);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// ڣ + DMA 巢ֽͣں˶
+//-------------------------------------------------------------------------------------------------------------------
+static void test_uart(void)
+{
+    static uint8_t expect[2048], got[2048];
+    uint32_t len = 0, n;
+    char     line[64];
+    int      i;
+
+    RUN_uart_init(UART1_TX_PA9_RX_PA10, 2000000, 0);
+    RUN_uart_putchar(UART1_TX_PA9_RX_PA10, 'A');
+    RUN_sim_run_us(20);
+    CHECK(RUN_sim_uart_tx(USART1, got, sizeof(got)) == 1 && got[0] == 'A');
+
+    CHECK(RUN_uart_tx_dma_init(UART1_TX_PA9_RX_PA10, 0) == 1);
+    for (i = 0; i < 30; i++)
+    {
+        n = (uint32_t)sprintf(line, "line %02d 0123456789abcdefghijklmnopqrstuvwxyz\r\n", i);
+        memcpy(expect + len, line, n);
+        len += n;
+        RUN_uart_write_buffered(UART1_TX_PA9_RX_PA10, (uint8_t*)line, (uint16_t)n);
+    }
+    RUN_uart_tx_flush(UART1_TX_PA9_RX_PA10);
+    n = RUN_sim_uart_tx(USART1, got, sizeof(got));
+    CHECK(n == len);
+    CHECK(memcmp(got, expect, len) == 0);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// ڰգıۡ (dropped) (overflow)
+//-------------------------------------------------------------------------------------------------------------------
+static void test_packet(void)
+{
+    static const char pkt[] = "@hello\r\n";
+    static char       longpkt[MAX_RX_LEN + 8];
+    char*             p;
+    uint8_t           n;
+    int               i;
+
+    RUN_uart_init(UART2_TX_PA2_RX_PA3, 1000000, 1);
+    RUN_sim_uart_rx(USART2, (const uint8_t*)pkt, sizeof(pkt) - 1);
+    RUN_sim_run_us(100);
+    p = RUN_uart_packet_get(UART2_TX_PA2_RX_PA3, &n);
+    CHECK(p != 0 && n == 5 && strcmp(p, "hello") == 0);
+    RUN_uart_packet_release(UART2_TX_PA2_RX_PA3);
+    CHECK(RUN_uart_packet_get(UART2_TX_PA2_RX_PA3, &n) == 0);
+
+    // 黹ǰ RUN_RX_SLOTS ۣ֮
+    for (i = 0; i < RUN_RX_SLOTS + 2; i++)
+    {
+        RUN_sim_uart_rx(USART2, (const uint8_t*)pkt, sizeof(pkt) - 1);
+        RUN_sim_run_us(100);
+    }
+    CHECK(RUN_uart_packet_dropped(UART2_TX_PA2_RX_PA3) == 2);
+    for (i = 0; i < RUN_RX_SLOTS; i++)
+    {
+        p = RUN_uart_packet_get(UART2_TX_PA2_RX_PA3, &n);
+        CHECK(p != 0 && strcmp(p, "hello") == 0);
+        RUN_uart_packet_release(UART2_TX_PA2_RX_PA3);
+    }
+    CHECK(RUN_uart_packet_get(UART2_TX_PA2_RX_PA3, &n) == 0);
+
+    // һճ
+    longpkt[0] = '@';
+    memset(longpkt + 1, 'x', MAX_RX_LEN + 4);
+    longpkt[MAX_RX_LEN + 5] = '\r';
+    longpkt[MAX_RX_LEN + 6] = '\n';
+    RUN_sim_uart_rx(USART2, (const uint8_t*)longpkt, MAX_RX_LEN + 7);
+    RUN_sim_run_us(1200);
+    RUN_sim_uart_rx(USART2, (const uint8_t*)pkt, sizeof(pkt) - 1);
+    RUN_sim_run_us(100);
+    CHECK(RUN_uart_packet_overflow(UART2_TX_PA2_RX_PA3) == 1);
+    p = RUN_uart_packet_get(UART2_TX_PA2_RX_PA3, &n);
+    CHECK(p != 0 && strcmp(p, "hello") == 0);
+    RUN_uart_packet_release(UART2_TX_PA2_RX_PA3);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//  DMA գ뻷Ķ̰ IDLE ѭʱμ overrun λ
+//-------------------------------------------------------------------------------------------------------------------
+static uint32_t rx_notify = 0;
+static uint16_t rx_notify_avail = 0;
+
+static void on_rx(UART_PIN_enum uart_pin, uint16_t available)
+{
+    (void)uart_pin;
+    rx_notify++;
+    rx_notify_avail = available;
+}
+
+static void test_uart_rx_dma(void)
+{
+    static uint8_t ring[64];
+    uint8_t        data[100], got[64];
+    int            i;
+
+    for (i = 0; i < (int)sizeof(data); i++) data[i] = (uint8_t)('0' + i % 64);
+    RUN_uart_init(UART3_TX_PB10_RX_PB11, 1000000, 0);
+    CHECK(RUN_uart_rx_dma_init(UART3_TX_PB10_RX_PB11, ring, sizeof(ring), on_rx) == 1);
+
+    RUN_sim_uart_rx(USART3, data, 10);
+    RUN_sim_run_us(90);
+    CHECK(RUN_uart_rx_available(UART3_TX_PB10_RX_PB11) == 0);        // ·û
+    RUN_sim_run_us(60);
+    CHECK(rx_notify == 1 && rx_notify_avail == 10);
+    CHECK(RUN_uart_rx_read(UART3_TX_PB10_RX_PB11, got, sizeof(got)) == 10);
+    CHECK(memcmp(got, data, 10) == 0);
+
+    // һ 100 ֽڲ 64 ֽڵĻ
+    RUN_sim_uart_rx(USART3, data, 100);
+    RUN_sim_run_us(1100);
+    CHECK(RUN_uart_rx_available(UART3_TX_PB10_RX_PB11) == 0);
+    CHECK(RUN_uart_rx_overrun(UART3_TX_PB10_RX_PB11) == 100);
+
+    RUN_sim_uart_rx(USART3, data + 20, 5);
+    RUN_sim_run_us(100);
+    CHECK(RUN_uart_rx_read(UART3_TX_PB10_RX_PB11, got, sizeof(got)) == 5);
+    CHECK(memcmp(got, data + 20, 5) == 0);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// ӳٸʽ־¼֡ݣȷһ֡
+//-------------------------------------------------------------------------------------------------------------------
+static void test_log(void)
+{
+    static uint8_t  out[4096];
+    uint8_t         dec[64];
+    RUN_frame_rx_t  rx;
+    uint32_t        rec[RUN_LOG_MAX_ARGS + 1] = {0};
+    uint32_t        len = 0, w, i;
+    uint16_t        n;
+    int             written = 0, sent = 0, frames = 0, k;
+
+    RUN_log_init(UART1_TX_PA9_RX_PA10);
+    RUN_frame_rx_init(&rx, dec, sizeof(dec));
+
+    RUN_LOG("x=%d\r\n", 42);
+    CHECK(RUN_log_poll() == 1);
+    RUN_uart_tx_flush(UART1_TX_PA9_RX_PA10);
+    len = RUN_sim_uart_tx(USART1, out, sizeof(out));
+    CHECK(len > 0 && out[0] == 0x00);                                   // ֡ǰķָ
+    for (i = 0, n = 0; i < len; i++) n = RUN_frame_rx_byte(&rx, out[i]);
+    CHECK(n == 1 + 8 && dec[0] == RUN_LOG_FRAME_TYPE);
+    memcpy(&w, dec + 1, 4);
+    CHECK((w >> 24) == 1);                                              // 
+    memcpy(&w, dec + 5, 4);
+    CHECK(w == 42);
+
+    // д (ÿ 9 ֣256 ַŵ 28 )ඪ
+    for (k = 0; k < 40; k++) written += RUN_log_write(rec, RUN_LOG_MAX_ARGS + 1);
+    CHECK(written == RUN_LOG_RING / (RUN_LOG_MAX_ARGS + 1));
+    CHECK(RUN_log_dropped() == (uint32_t)(40 - written));
+
+    // ͻÿֻŵ¼֡ poll 
+    len = 0;
+    for (k = 0; k < 100 && sent < written; k++)
+    {
+        sent += RUN_log_poll();
+        RUN_uart_tx_flush(UART1_TX_PA9_RX_PA10);
+        len += RUN_sim_uart_tx(USART1, out + len, sizeof(out) - len);
+    }
+    CHECK(sent == written);
+    CHECK(RUN_log_poll() == 0);
+
+    for (i = 0; i < len; i++)
+    {
+        n = RUN_frame_rx_byte(&rx, out[i]);
+        if (n == 0) continue;
+        if (frames == 0)
+        {
+            memcpy(&w, dec + 1, 4);
+            CHECK(dec[0] == RUN_LOG_DROP_TYPE && n == 5 && w == (uint32_t)(40 - written));
+        }
+        else if (dec[0] != RUN_LOG_FRAME_TYPE || n != 1 + 4 * (RUN_LOG_MAX_ARGS + 1))
+        {
+            break;
+        }
+        frames++;
+    }
+    CHECK(frames == 1 + written);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// ADCת顢ģ⿴Źص
+//-------------------------------------------------------------------------------------------------------------------
+static volatile uint32_t awd_hits = 0;
+
+static void on_awd(RUN_ADC_Channel_enum ch, void* ctx)
+{
+    (void)ch;
+    (void)ctx;
+    awd_hits++;
+}
+
+static void test_adc(void)
+{
+    static volatile uint16_t result[1];
+    static uint16_t          buf[8];
+    RUN_stream_t             st;
+    const RUN_ADC_Channel_enum ch = RUN_ADC_CH0_PA0;
+
+    RUN_ADC_Init();
+    RUN_sim_adc_input(0, 1234);
+    CHECK(RUN_ADC_Get_Value(RUN_ADC_CH0_PA0) == 1234);
+
+    CHECK(RUN_ADC_Timed_Start(RUN_TIM3, 1000, &ch, 1, (RUN_ADC_Sample_t)8, &st, buf, 8, 0, 0) == 0);
+
+    CHECK(RUN_ADC_Awd_Start(RUN_ADC_CH0_PA0, 1000, 3000, on_awd, 0, 0, 0) == 1);
+    CHECK(RUN_ADC_Scan_Start(&ch, 1, RUN_ADC_SMP_55_5, result) == 1);
+    RUN_sim_run_us(50);
+    CHECK(awd_hits == 0);
+    RUN_sim_adc_input(0, 3500);
+    RUN_sim_run_us(50);
+    CHECK(awd_hits == 1);                                   // ص AWDIEֻһ
+    CHECK(RUN_ADC_Scan_Get(RUN_ADC_CH0_PA0) == 3500);
+    RUN_ADC_Awd_Stop();
+    RUN_ADC_Scan_Stop();
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// ƹصŰ鲻黹ʱDMA תȥһ黹
+//-------------------------------------------------------------------------------------------------------------------
+static uint8_t  stream_ack = 0;
+static uint16_t stream_first = 0;
+
+static uint8_t on_block(void* half, uint16_t count, void* ctx)
+{
+    (void)count;
+    stream_first = ((uint16_t*)half)[0];
+    return *(uint8_t*)ctx;
+}
+
+static void test_stream(void)
+{
+    static uint16_t buf[8];
+    RUN_stream_t    st;
+    const RUN_ADC_Channel_enum ch = RUN_ADC_CH0_PA0;
+    int             k;
+
+    RUN_sim_adc_input(0, 2000);
+    stream_ack = 0;
+    CHECK(RUN_ADC_Timed_Start(RUN_TIM3, 10000, &ch, 1, RUN_ADC_SMP_55_5, &st, buf, 8, on_block, &stream_ack) == 10000);
+    for (k = 0; k < 200 && st.blocks < 1; k++) RUN_sim_run_us(10);
+    CHECK(st.blocks == 1 && RUN_stream_overruns(&st) == 0);
+    CHECK(stream_first == 2000);
+    for (k = 0; k < 200 && st.blocks < 2; k++) RUN_sim_run_us(10);
+    CHECK(RUN_stream_overruns(&st) == 1);                       // ǰ黹ռ
+
+    RUN_stream_release(&st, buf);
+    RUN_stream_release(&st, buf + 4);
+    stream_ack = 1;
+    for (k = 0; k < 400 && st.blocks < 6; k++) RUN_sim_run_us(10);
+    CHECK(st.blocks >= 6);
+    CHECK(RUN_stream_overruns(&st) == 1);
+    RUN_ADC_Timed_Stop();
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// ˫ ADC ͬ ( 16 λ ADC1 16 λ ADC2) ע
+//-------------------------------------------------------------------------------------------------------------------
+static uint8_t  inj_num = 0;
+static uint16_t inj_sample[RUN_ADC_INJ_MAX];
+
+static void on_inj(const uint16_t* sample, uint8_t num, void* ctx)
+{
+    (void)ctx;
+    inj_num = num;
+    memcpy(inj_sample, sample, num * sizeof(uint16_t));
+}
+
+static void test_adc_dual_inj(void)
+{
+    static uint32_t buf[8];
+    RUN_stream_t    st;
+    const RUN_ADC_Channel_enum ch1 = RUN_ADC_CH0_PA0, ch2 = RUN_ADC_CH1_PA1;
+    const RUN_ADC_Channel_enum inj[2] = { RUN_ADC_CH2_PA2, RUN_ADC_CH3_PA3 };
+    uint32_t*       half;
+    uint16_t        n = 0;
+    int             k;
+
+    RUN_sim_adc_input(0, 1000);
+    RUN_sim_adc_input(1, 3000);
+    CHECK(RUN_ADC_Dual_Start(RUN_ADC_DUAL_SIMULT, RUN_TIM3, 10000, &ch1, &ch2, 1,
+                             RUN_ADC_SMP_55_5, &st, buf, 8, 0, 0) == 10000);
+    for (k = 0; k < 200 && st.blocks < 1; k++) RUN_sim_run_us(10);
+    half = (uint32_t*)RUN_stream_get(&st, &n);
+    CHECK(half == buf && n == 4);
+    CHECK(half != 0 && half[0] == ((3000u << 16) | 1000u) && half[3] == half[0]);
+    if (half) RUN_stream_release(&st, half);
+    RUN_ADC_Dual_Stop();
+    CHECK(RUN_ADC_Get_Value(RUN_ADC_CH1_PA1) == 3000);         // 黹ת
+
+    RUN_sim_adc_input(2, 111);
+    RUN_sim_adc_input(3, 222);
+    CHECK(RUN_ADC_Inj_Start(RUN_ADC_INJ_SOFTWARE, inj, 2, RUN_ADC_SMP_28_5, on_inj, 0, 1, 0) == 1);
+    RUN_ADC_Inj_Trigger();
+    RUN_sim_run_us(20);
+    CHECK(RUN_ADC_Inj_Count() == 1);
+    CHECK(RUN_ADC_Inj_Get(0) == 111 && RUN_ADC_Inj_Get(1) == 222);
+    CHECK(inj_num == 2 && inj_sample[0] == 111 && inj_sample[1] == 222);
+    RUN_ADC_Inj_Stop();
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// ADC ꣺ VREFINT  VDDAmV / ¶Ȼ㣬 VREFINT ¶ȵ
+//-------------------------------------------------------------------------------------------------------------------
+static void test_adc_cal(void)
+{
+    int32_t t;
+
+    RUN_sim_adc_input(17, 1489);                            // 1.2V / 3.3V * 4095
+    CHECK(RUN_ADC_Cal_Init() == 1);
+    CHECK(RUN_ADC_Cal_VDDA() == 3300);
+
+    RUN_ADC_Cal_Feed(1638);                                 // 1.2V / 3.0V * 4095
+    CHECK(RUN_ADC_Cal_VDDA() == 3000);
+    CHECK(RUN_ADC_Cal_mV(2048) == 1500);
+    CHECK(RUN_ADC_Cal_mV(4095) == 3000);
+    CHECK(RUN_ADC_Cal_uV(2048 << 4, 4) / 1000 == 1500);
+    RUN_ADC_Cal_Feed(100);                                  // Ӧ VDDA 49V
+    CHECK(RUN_ADC_Cal_VDDA() == 3000);
+
+    // V25 = 1.43V -> 1952ÿ 10C  43mV -> 1893
+    t = RUN_ADC_Cal_Temp(1893);
+    CHECK(t >= 3490 && t <= 3510);
+    t = RUN_ADC_Cal_Temp(1952);
+    CHECK(t >= 2490 && t <= 2510);
+    RUN_sim_adc_input(16, 1952);
+    CHECK(RUN_ADC_Cal_ReadTemp() == t);
+    RUN_ADC_Cal_SetTempOffset(-150);                        // ƫ 1.5C
+    CHECK(RUN_ADC_Cal_Temp(1952) == t - 150);
+    RUN_ADC_Cal_SetTempOffset(0);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// ֡ -> ʽCRC 
+//-------------------------------------------------------------------------------------------------------------------
+static void test_frame(void)
+{
+    uint8_t        payload[40], enc[RUN_FRAME_ENCODED_MAX(40)], dec[64];
+    RUN_frame_rx_t rx;
+    uint16_t       n, i, got = 0;
+
+    for (i = 0; i < sizeof(payload); i++) payload[i] = (uint8_t)(i * 7);   //  0x00
+    n = RUN_frame_encode(0x21, payload, sizeof(payload), enc);
+    CHECK(n <= RUN_FRAME_ENCODED_MAX(40));
+    CHECK(memchr(enc, 0, n - 1) == 0 && enc[n - 1] == 0);
+
+    RUN_frame_rx_init(&rx, dec, sizeof(dec));
+    for (i = 0; i < n; i++) got = RUN_frame_rx_byte(&rx, enc[i]);
+    CHECK(got == 1 + sizeof(payload));
+    CHECK(dec[0] == 0x21 && memcmp(dec + 1, payload, sizeof(payload)) == 0);
+
+    enc[5] ^= 0x10;
+    for (i = 0; i < n; i++) got = RUN_frame_rx_byte(&rx, enc[i]);
+    CHECK(got == 0 && rx.crc_error == 1);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// ʽ
+//-------------------------------------------------------------------------------------------------------------------
+static void test_fmt_osr(void)
+{
+    static const uint16_t block[4] = {100, 101, 99, 100};
+    char         buf[64];
+    RUN_osr_t    osr;
+    RUN_osr_ch_t ch[1];
+
+    RUN_fmt(buf, sizeof(buf), "%d|%5u|%04X|%.2q|%.3k|%-3s|", -12, 34u, 0xBEEF, RUN_FMT_Q16(1.5f), 12345, "ab");
+    CHECK(strcmp(buf, "-12|   34|BEEF|1.50|12.345|ab |") == 0);
+    CHECK(RUN_fmt(buf, 4, "%d", 123456) == 3 && strcmp(buf, "123") == 0);
+
+    CHECK(RUN_osr_init(&osr, ch, 0) == 0);
+    CHECK(RUN_osr_feed(&osr, block, 4) == 0);
+    CHECK(RUN_osr_init(&osr, ch, 1) == 1);
+    CHECK(RUN_osr_config(&osr, 0, 1, 0) == 1);
+    CHECK(RUN_osr_feed(&osr, block, 4) == 1);
+    CHECK(RUN_osr_get(&osr, 0) == 200);                    // (100+101+99+100) >> 1
+}
+
+int main(void)
+{
+    RUN_sim_init();
+    SystemInit();
+
+    test_clock();
+    test_clock_set();
+    test_gpio();
+    test_key();
+    test_dma();
+    test_uart();
+    test_packet();
+    test_uart_rx_dma();
+    test_log();
+    test_adc();
+    test_stream();
+    test_adc_dual_inj();
+    test_adc_cal();
+    test_frame();
+    test_fmt_osr();
+
+    printf("test_sim: %d/%d checks passed\n", test_count - test_fail, test_count);
+    return test_fail;
+}
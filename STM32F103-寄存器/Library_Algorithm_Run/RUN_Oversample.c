@@ -0,0 +1,151 @@
+#include "RUN_Oversample.h"
+
+/**
+  * @brief  ڲ3 ֵ
+  */
+static uint16_t Median3(uint16_t a, uint16_t b, uint16_t c)
+{
+    if (a > b) { uint16_t t = a; a = b; b = t; }
+    if (b > c) b = c;
+    return (a > b) ? a : b;
+}
+
+/**
+  * @brief  ڲ5 ֵ (һݿȡм)
+  */
+static uint16_t Median5(const uint16_t *w)
+{
+    uint16_t s[5];
+    uint8_t i, j;
+
+    for (i = 0; i < 5; i++)
+    {
+        uint16_t v = w[i];
+        for (j = i; j > 0 && s[j - 1] > v; j--) s[j] = s[j - 1];
+        s[j] = v;
+    }
+    return s[2];
+}
+
+/**
+  * @brief  ڲһͨ
+  * @retval 1: һ½  0: ۼ
+  */
+static uint8_t Osr_Push(RUN_osr_ch_t *c, uint16_t x)
+{
+    // 1. ֵ (ûǰԭͨ)
+    if (c->median)
+    {
+        c->win[c->widx] = x;
+        if (++c->widx >= c->median) c->widx = 0;
+        if (c->wfill < c->median) c->wfill++;
+        else x = (c->median == 3) ? Median3(c->win[0], c->win[1], c->win[2]) : Median5(c->win);
+    }
+
+    // 2. ʽۼӣ 4^n һ ( n λ = 12+n λ)
+    c->acc += x;
+    if (++c->cnt < (1u << (2 * c->bits))) return 0;
+
+    c->out = (uint16_t)(c->acc >> c->bits);
+    c->acc = 0;
+    c->cnt = 0;
+    c->seq++;
+    return 1;
+}
+
+/**
+  * @brief  ȡʼ
+  * @param  osr: ȡ
+  * @param  ch:  num ͨ״̬ (ṩ)
+  * @param  num: ÿ֡ͨ (>= 1)
+  * @retval 1: ɹ  0:  (osr Ϊգ֮ RUN_osr_feed ʲôҲ)
+  */
+uint8_t RUN_osr_init(RUN_osr_t *osr, RUN_osr_ch_t *ch, uint8_t num)
+{
+    uint8_t i;
+
+    osr->phase = 0;
+    if (ch == 0 || num == 0)
+    {
+        osr->ch  = 0;
+        osr->num = 0;
+        return 0;
+    }
+
+    osr->ch    = ch;
+    osr->num   = num;
+    for (i = 0; i < num; i++) RUN_osr_config(osr, i, 0, 0);
+    return 1;
+}
+
+/**
+  * @brief  õͨ
+  * @param  idx:    ͨ֡еλ ( chs[] ±һ)
+  * @param  bits:   λ n (0 ~ 4)ÿ 4^n һ 12+n λ
+  *                 : 10kHz n = 4 -> 39Hz 16 λn = 2 -> 625Hz14 λ
+  * @param  median: 0 ã3 / 5 㻬ֵȥ (ÿ 3 / ~10 αȽ)
+  * @retval 1: ɹ  0: 
+  * @note   ûͨۼӵһ
+  */
+uint8_t RUN_osr_config(RUN_osr_t *osr, uint8_t idx, uint8_t bits, uint8_t median)
+{
+    RUN_osr_ch_t *c;
+
+    if (idx >= osr->num || bits > RUN_OSR_BITS_MAX) return 0;
+    if (median != 0 && median != 3 && median != 5) return 0;
+
+    c = &osr->ch[idx];
+    c->bits   = bits;
+    c->median = median;
+    c->widx   = 0;
+    c->wfill  = 0;
+    c->cnt    = 0;
+    c->acc    = 0;
+    c->out    = 0;
+    c->seq    = 0;
+    return 1;
+}
+
+/**
+  * @brief  ιһ齻
+  * @param  block:  (ch0, ch1, ... ch(num-1), ch0, ...)һ DMA 
+  * @param  n:      ( num ı֡λ鱣)
+  * @retval β½
+  * @note   ֻмӷȽϺλ DMA жϻصֱӵã
+  *         static uint8_t on_block(void* half, uint16_t n, void* ctx)
+  *         { RUN_osr_feed(&osr, (uint16_t*)half, n); return 1; }
+  */
+uint16_t RUN_osr_feed(RUN_osr_t *osr, const uint16_t *block, uint16_t n)
+{
+    uint16_t produced = 0;
+    uint8_t  phase = osr->phase;
+
+    if (osr->ch == 0 || osr->num == 0) return 0;       // δʼʼʧ
+
+    while (n--)
+    {
+        produced += Osr_Push(&osr->ch[phase], *block++);
+        if (++phase >= osr->num) phase = 0;
+    }
+    osr->phase = phase;
+    return produced;
+}
+
+/**
+  * @brief   idx ͨ½
+  * @retval 12+n λ 12 λ̶Ϊ out / 2^n (Сķֱ)
+  */
+uint16_t RUN_osr_get(const RUN_osr_t *osr, uint8_t idx)
+{
+    if (idx >= osr->num) return 0;
+    return osr->ch[idx].out;
+}
+
+/**
+  * @brief   idx ͨۼ
+  */
+uint32_t RUN_osr_seq(const RUN_osr_t *osr, uint8_t idx)
+{
+    if (idx >= osr->num) return 0;
+    return osr->ch[idx].seq;
+}
@@ -0,0 +1,60 @@
+#ifndef __RUN_OVERSAMPLE_H
+#define __RUN_OVERSAMPLE_H
+
+#include <stdint.h>
+
+/* =================================================================================
+ * [ ADC  / ȡ ] ʽ
+ * ---------------------------------------------------------------------------------
+ * >> : ¶ȡѹصҪ 12 λϸķֱ
+ * >> ԭ: ÿ 4^n ͺ n λ (ʽ˲ + ȡһ CIC)õ 12+n λ
+ *          ǰź 1 LSB  (Ϊ)ȫɾֱλ
+ * >> ÷:  DMA صÿһ齻 RUN_osr_feed һΣ
+ *          ѭʱ RUN_osr_get ½ ( RUN_ADC_Timed_Start / RUN_stream_t )
+ * >> ѡ: ÿͨɵ n (0 ~ 4ȡ 1 ~ 256 ) ͻֵ (3 / 5 㣬˼)
+ *          ֵ֮ǰëۼ
+ * =================================================================================
+ */
+
+#define RUN_OSR_BITS_MAX    4       // 4^4 = 256  -> 16 λ
+#define RUN_OSR_MEDIAN_MAX  5       // ֵ󴰿
+
+// ͨ״̬ (ṩ洢 RUN_osr_init / RUN_osr_config )
+typedef struct {
+    uint8_t           bits;         // λ nȡ 4^n
+    uint8_t           median;       // ֵ (0:   3 / 5)
+    uint8_t           widx;         // ֵдλ
+    uint8_t           wfill;        // ֵ
+    uint16_t          win[RUN_OSR_MEDIAN_MAX];
+    uint16_t          cnt;          // ۼ
+    uint32_t          acc;          // ۼ
+    volatile uint16_t out;          // ½ (12+n λ)
+    volatile uint32_t seq;          // ۼ
+} RUN_osr_ch_t;
+
+// ȡӦһ֡ num ͨ ( ADC ɨ / ʱ chs ˳һ)
+typedef struct {
+    RUN_osr_ch_t* ch;
+    uint8_t       num;              // ÿ֡ͨ
+    uint8_t       phase;            // һڵڼͨ (鳤 num ıʱ鱣)
+} RUN_osr_t;
+
+/* ================= API  ================= */
+
+// ʼch Ϊ num ͨ״̬飬ͨĬ n = 0ֵ (ԭ)
+//  1 ɹ / 0  (ch Ϊ NULL  num Ϊ 0)
+uint8_t RUN_osr_init(RUN_osr_t *osr, RUN_osr_ch_t *ch, uint8_t num);
+
+// õ idx ͨbits = 0 ~ RUN_OSR_BITS_MAXmedian = 0 / 3 / 5 1 ɹ 0 
+uint8_t RUN_osr_config(RUN_osr_t *osr, uint8_t idx, uint8_t bits, uint8_t median);
+
+// ιһ齻 (же)رβ½
+uint16_t RUN_osr_feed(RUN_osr_t *osr, const uint16_t *block, uint16_t n);
+
+//  idx ͨ½ (12+n λ (4096 << n) - 1)
+uint16_t RUN_osr_get(const RUN_osr_t *osr, uint8_t idx);
+
+//  idx ͨۼ (仯½)
+uint32_t RUN_osr_seq(const RUN_osr_t *osr, uint8_t idx);
+
+#endif
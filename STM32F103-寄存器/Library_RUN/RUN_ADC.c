@@ -1,9 +1,149 @@
-#include "RUN_Adc.h"
+#include "RUN_ADC.h"
+#include "RUN_Clock.h"
 
 // 
 // ͼչʾαƽ (SAR) ADC ڲṹ
 //  ֵ· (Sample & Hold)DACȽ  SAR ߼ơ
 
+// ==============================================================================
+// ȫֱ
+// ==============================================================================
+static volatile uint16_t*   adc_scan_buf = 0;       // ɨ飬NULL ʾɨδ
+static DMA_Channel_TypeDef* adc_scan_dma = 0;
+static uint8_t              adc_scan_rank[18];      // ͨ -> ɨеλ + 1 (0: )
+static RUN_stream_t*        adc_timed_st = 0;       // ʱNULL ʾʱδ
+static RUN_TIM_enum         adc_timed_tim;
+static RUN_stream_t*        adc_dual_st = 0;        // ˫ ADC NULL ʾ˫ ADC δ
+static RUN_TIM_enum         adc_dual_tim;           // RUN_TIM_MAX ʾת
+static RUN_ADC_Inj_cb_t     adc_inj_cb = 0;
+static void*                adc_inj_ctx;
+static uint8_t              adc_inj_num = 0;        // עͨ0 ʾעδ
+static RUN_ADC_InjTrig_t    adc_inj_trig;
+static uint16_t             adc_inj_sample[RUN_ADC_INJ_MAX];
+static volatile uint32_t    adc_inj_count = 0;
+static RUN_ADC_Awd_cb_t     adc_awd_cb = 0;
+static void*                adc_awd_ctx;
+static RUN_ADC_Channel_enum adc_awd_ch;
+static uint8_t              adc_awd_on = 0;         // 1: ģ⿴Ź
+static volatile uint32_t    adc_awd_count = 0;
+
+static const uint16_t adc_smp_x2[8] = {3, 15, 27, 57, 83, 111, 143, 479};  //  x2 (ADC ʱ)
+
+// ==============================================================================
+// ڲ
+// ==============================================================================
+
+//-------------------------------------------------------------------------------------------------------------------
+// ڲʵ PCLK2 ѡ ADC Ƶȡ ADCCLK <= 14MHz СƵ (PCLK2 = 72MHz ʱΪ Div6 = 12MHz)
+//-------------------------------------------------------------------------------------------------------------------
+static void adc_clock_config(void)
+{
+    uint32_t pclk2  = RUN_clock_get()->pclk2;
+    uint32_t adcpre = 0;
+
+    while (adcpre < 3 && pclk2 / ((adcpre + 1) * 2) > 14000000) adcpre++;
+    RCC->CFGR = (RCC->CFGR & ~RCC_CFGR_ADCPRE) | (adcpre << 14);
+    RUN_clock_update();
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// ڲʱӸı乳ӣƵ ADCCLK ܳ 14MHzƵ󻻻ظСķƵ
+//-------------------------------------------------------------------------------------------------------------------
+static void adc_clock_hook(const RUN_clock_t* old_clk, const RUN_clock_t* new_clk)
+{
+    (void)old_clk;
+    (void)new_clk;
+    if (RCC->APB2ENR & (RCC_APB2ENR_ADC1EN | RCC_APB2ENR_ADC2EN | RCC_APB2ENR_ADC3EN)) adc_clock_config();
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// ڲõͨĲʱ
+//-------------------------------------------------------------------------------------------------------------------
+static void adc_set_sample(ADC_TypeDef* ADCx, uint8_t channel, RUN_ADC_Sample_t smp)
+{
+    // SMPR2 ͨ 0-9, SMPR1 ͨ 10-17
+    if (channel < 10)
+    {
+        ADCx->SMPR2 &= ~(7 << (3 * channel));      // ԭ (3λ)
+        ADCx->SMPR2 |=  (smp << (3 * channel));
+    }
+    else
+    {
+        ADCx->SMPR1 &= ~(7 << (3 * (channel - 10)));
+        ADCx->SMPR1 |=  (smp << (3 * (channel - 10)));
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// ڲADON ϵ粢У׼
+// ϵ (ADON = 0) ڽеɨ / תͣµΨһ취ϵҪУ׼һ
+//-------------------------------------------------------------------------------------------------------------------
+static void adc_power_up(ADC_TypeDef* ADCx)
+{
+    ADCx->CR2 |= (1 << 0);
+
+    // === ؼϵȴ 2 ADC ʱڲУ׼ ===
+    // 򵥵ʱֹ ADC ûȾͿʼУ׼
+    for(int i=0; i<1000; i++) __NOP(); 
+
+    // λУ׼
+    ADCx->CR2 |= (1 << 3);
+    while(ADCx->CR2 & (1 << 3));
+
+    // ʼУ׼
+    ADCx->CR2 |= (1 << 2);
+    while(ADCx->CR2 & (1 << 2));
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// ڲϵͣڽеתдùкͲʱ䣬ϵУ׼
+// ɨ顢ʱ˫ ADC ãnum > 1 ʱ SCAN (עҲҪɨʱִ)¶ / VREFINT ͨʱ TSVREFE
+//-------------------------------------------------------------------------------------------------------------------
+static void adc_regular_setup(ADC_TypeDef* ADCx, const RUN_ADC_Channel_enum* chs, uint8_t num, RUN_ADC_Sample_t smp)
+{
+    uint32_t sqr[3] = {0, 0, 0};
+    uint8_t  i;
+
+    ADCx->CR2 &= ~(ADC_CR2_CONT | ADC_CR2_DMA | ADC_CR2_ADON);
+    if (ADCx == ADC1)
+    {
+        adc_scan_buf = 0;
+        for (i = 0; i < sizeof(adc_scan_rank); i++) adc_scan_rank[i] = 0;
+    }
+
+    for (i = 0; i < num; i++)
+    {
+        uint8_t ch = (uint8_t)chs[i];
+
+        RUN_ADC_ConfigPin(chs[i]);
+        adc_set_sample(ADCx, ch, smp);
+        sqr[i / 6] |= (uint32_t)ch << (5 * (i % 6));
+        if (ADCx == ADC1 && adc_scan_rank[ch] == 0) adc_scan_rank[ch] = i + 1;
+        if (ch >= 16) ADCx->CR2 |= ADC_CR2_TSVREFE;
+    }
+    ADCx->SQR3 = sqr[0];
+    ADCx->SQR2 = sqr[1];
+    ADCx->SQR1 = sqr[2] | ((uint32_t)(num - 1) << 20);     // L[3:0] = ת - 1
+    if (num > 1 || (ADCx == ADC1 && adc_inj_num > 1)) ADCx->CR1 |=  ADC_CR1_SCAN;
+    else                                             ADCx->CR1 &= ~ADC_CR1_SCAN;
+
+    adc_power_up(ADCx);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// ڲصͨΡ (RUN_ADC_Init ״̬)
+//-------------------------------------------------------------------------------------------------------------------
+static void adc_regular_reset(void)
+{
+    ADC1->CR2 &= ~(ADC_CR2_CONT | ADC_CR2_DMA | ADC_CR2_ADON | ADC_CR2_EXTSEL);
+    ADC1->CR2 |= ADC_CR2_EXTTRIG | ADC_CR2_EXTSEL;         // EXTSEL = 111 (SWSTART)
+    ADC1->CR1 &= ~(ADC_CR1_SCAN | ADC_CR1_DUALMOD);
+    if (adc_inj_num > 1) ADC1->CR1 |= ADC_CR1_SCAN;
+    ADC1->SQR1 = 0;
+    adc_scan_buf = 0;
+    adc_power_up(ADC1);
+}
+
 // ==============================================================================
 // ʼ (Ĵ汾)
 // ==============================================================================
@@ -18,9 +158,9 @@ void RUN_ADC_Init(void)
     // 1.  ADC1 ʱ
     RCC->APB2ENR |= (1 << 9);
 
-    // 2.  ADC Ƶ (Div6 = 12MHz)
-    RCC->CFGR &= ~(3 << 14);
-    RCC->CFGR |=  (2 << 14);
+    // 2.  ADC Ƶ (ADCCLK <= 14MHz)
+    adc_clock_config();
+    RUN_clock_hook_add(adc_clock_hook);
 
     // 3.  CR1
     ADC1->CR1 = 0; // ģʽɨ
@@ -32,22 +172,10 @@ void RUN_ADC_Init(void)
     ADC1->CR2 = 0; // 
     ADC1->CR2 |= (1 << 20); // <--- ֮ǰ©䣺ⲿ
     ADC1->CR2 |= (7 << 17); // EXTSEL = 111 (Software Start)
+    ADC1->CR2 |= ADC_CR2_TSVREFE; // ¶ȴ VREFINT (ϵԼ 10us ȶУ׼ʱ㹻)
     
-    // 5.  ADC Դ (ADON)
-    ADC1->CR2 |= (1 << 0);
-
-    // === ؼϵȴ 2 ADC ʱڲУ׼ ===
-    // 򵥵ʱֹ ADC ûȾͿʼУ׼
-    for(int i=0; i<1000; i++) __NOP(); 
-
-    // 6. ADC У׼
-    // λУ׼
-    ADC1->CR2 |= (1 << 3);
-    while(ADC1->CR2 & (1 << 3));
-
-    // ʼУ׼
-    ADC1->CR2 |= (1 << 2);
-    while(ADC1->CR2 & (1 << 2));
+    // 5.  ADC Դ (ADON) У׼
+    adc_power_up(ADC1);
 }
 
 // 
@@ -99,21 +227,14 @@ uint16_t RUN_ADC_Get_Value(RUN_ADC_Channel_enum ch)
 
     uint8_t channel = (uint8_t)ch;
 
+    // 0. ɨܣSQR ֱܶӶ DMA дõĽ
+    if (adc_scan_buf) return RUN_ADC_Scan_Get(ch);
+    if (adc_timed_st || adc_dual_st) return 0;  // ʱ / ˫ ADC ռ
+
     // 1. òʱ (55.5 Cycles)
     // ӦĴֵ: 000(1.5), 001(7.5), 010(13.5), 011(28.5), 100(41.5), 101(55.5)
-    // Ҫд 5 ( 101)
-    
-    // SMPR2 ͨ 0-9, SMPR1 ͨ 10-17
-    if (channel < 10)
-    {
-        ADC1->SMPR2 &= ~(7 << (3 * channel));      // ԭ (3λ)
-        ADC1->SMPR2 |=  (5 << (3 * channel));      // Ϊ 55.5 
-    }
-    else
-    {
-        ADC1->SMPR1 &= ~(7 << (3 * (channel - 10))); 
-        ADC1->SMPR1 |=  (5 << (3 * (channel - 10))); 
-    }
+    // ¶ȴ / VREFINT Ҫʱ >= 17.1us 239.5 
+    adc_set_sample(ADC1, channel, (channel >= 16) ? RUN_ADC_SMP_239_5 : RUN_ADC_SMP_55_5);
 
     // 2. ù (Rank 1)
     // SQR3  4:0 λ˹1תͨ
@@ -149,4 +270,626 @@ uint16_t RUN_ADC_Get_Average(RUN_ADC_Channel_enum ch, uint8_t times)
     }
     
     return temp_val / times;
-}
\ No newline at end of file
+}
+
+// ==============================================================================
+// ɨ (ɨ + ת + DMA)
+// ==============================================================================
+
+// 
+// ͨ·ADC1  (SQR1~3 źõ num ͨ) --EOC--> DMA1 ͨ1 (ѭ) --> result[0..num-1]
+// һͨת CONT  ADC ӵһͨ¿ʼDMA ҲûƵ result[0]ʼն롣
+
+//-------------------------------------------------------------------------------------------------------------------
+//       ɨ
+// ˵      chs             ͨ
+// ˵      num             ͨ (1 ~ 16)
+// ˵      smp             ʱ
+// ˵      result          飬result[i] Ӧ chs[i]
+// ز      uint8_t         1: ɹ  0: ʧ
+// ʹʾ      static const RUN_ADC_Channel_enum chs[3] = {RUN_ADC_CH0_PA0, RUN_ADC_CH1_PA1, RUN_ADC_CH_VREF};
+//               static volatile uint16_t adc_val[3];
+//               RUN_ADC_Init();
+//               RUN_ADC_Scan_Start(chs, 3, RUN_ADC_SMP_55_5, adc_val);
+//               ... x = adc_val[0];                 //  RUN_ADC_Scan_Get(RUN_ADC_CH0_PA0)
+// עϢ      1. ظûͣеɨ / ʱ
+//               2. ¶ / VREFINT ͨʱԶ TSVREFE
+//-------------------------------------------------------------------------------------------------------------------
+uint8_t RUN_ADC_Scan_Start(const RUN_ADC_Channel_enum* chs, uint8_t num,
+                           RUN_ADC_Sample_t smp, volatile uint16_t* result)
+{
+    DMA_Channel_TypeDef* dma;
+    uint8_t i;
+
+    if (chs == 0 || result == 0 || num == 0 || num > RUN_ADC_SCAN_MAX) return 0;
+    for (i = 0; i < num; i++) if ((uint8_t)chs[i] > 17) return 0;
+
+    RUN_ADC_Timed_Stop();
+    RUN_ADC_Dual_Stop();
+    dma = RUN_DMA_Alloc(RUN_DMA_REQ_ADC1);
+    if (dma == 0) return 0;
+
+    // 1. ֮ͣǰתкͲʱһд
+    adc_regular_setup(ADC1, chs, num, smp);
+
+    // 2. DMA  result[0] ʼ
+    RUN_DMA_Config(dma, (uint32_t)&ADC1->DR, (uint32_t)result, num,
+                   RUN_DMA_DIR_P2M, RUN_DMA_WIDTH_16BIT, RUN_DMA_MODE_CIRCULAR);
+    RUN_DMA_Enable(dma);
+    adc_scan_dma = dma;
+    adc_scan_buf = result;
+
+    // 3.  + DMAһ
+    ADC1->CR2 |= ADC_CR2_CONT | ADC_CR2_DMA;
+    ADC1->CR2 |= ADC_CR2_SWSTART;
+    return 1;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       ֹͣɨ
+// ز      void
+// עϢ      ADC صģʽRUN_ADC_Get_Value ָת
+//-------------------------------------------------------------------------------------------------------------------
+void RUN_ADC_Scan_Stop(void)
+{
+    if (adc_scan_dma == 0) return;
+
+    RUN_DMA_Free(adc_scan_dma, RUN_DMA_REQ_ADC1);
+    adc_scan_dma = 0;
+    adc_regular_reset();
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       ͨɨ½
+// ˵      ch              ADC ͨ
+// ز      uint16_t        12 λͨɨﷵ 0
+//-------------------------------------------------------------------------------------------------------------------
+uint16_t RUN_ADC_Scan_Get(RUN_ADC_Channel_enum ch)
+{
+    uint8_t rank = ((uint8_t)ch < sizeof(adc_scan_rank)) ? adc_scan_rank[(uint8_t)ch] : 0;
+
+    if (adc_scan_buf == 0 || rank == 0) return 0;
+    return adc_scan_buf[rank - 1];
+}
+
+// ==============================================================================
+// ʱ (ⲿ + ƹ)
+// ==============================================================================
+
+// 
+// ͨ·TIMx ¼ --(EXTSEL)--> ADC1  (һδת) --EOC--> DMA1 ͨ1 --> RUN_stream_t
+// ʱɶʱӲжӳ١ѭ޹ء
+// ADC1 ѡĶʱԴ (EXTSEL)TIM1_CC1 (000)TIM2_CC2 (011)TIM3_TRGO (100)TIM4_CC4 (101)
+
+//-------------------------------------------------------------------------------------------------------------------
+// ڲѶʱóÿڸ ADC һ
+// ز      uint8_t         EXTSEL ֵ0xFF ʾöʱܴ ADC1
+// עϢ      CC  PWM ģʽ 1CCR = ARR/2ֻͨıȽ (CCxE)
+//               Ӧű GPIO / ģʱв
+//-------------------------------------------------------------------------------------------------------------------
+static uint8_t adc_trigger_config(RUN_TIM_enum tim_n)
+{
+    TIM_TypeDef* TIMx = timer_cfg[tim_n].tim_base;
+    uint16_t     half = (uint16_t)((TIMx->ARR + 1) / 2);
+
+    switch (tim_n)
+    {
+        case RUN_TIM1:
+            TIMx->CCMR1 = (TIMx->CCMR1 & 0xFF00) | (6 << 4);       // OC1M = 110 (PWM1)
+            TIMx->CCR1  = half;
+            TIMx->CCER |= TIM_CCER_CC1E;
+            TIMx->BDTR |= TIM_BDTR_MOE;                             // ߼ʱ MOE û OC1REF 
+            return 0;
+        case RUN_TIM2:
+            TIMx->CCMR1 = (TIMx->CCMR1 & 0x00FF) | (6 << 12);      // OC2M = 110 (PWM1)
+            TIMx->CCR2  = half;
+            TIMx->CCER |= TIM_CCER_CC2E;
+            return 3;
+        case RUN_TIM3:
+            TIMx->CR2 = (TIMx->CR2 & ~TIM_CR2_MMS) | TIM_CR2_MMS_1; // MMS = 010¼Ϊ TRGO
+            return 4;
+        case RUN_TIM4:
+            TIMx->CCMR2 = (TIMx->CCMR2 & 0x00FF) | (6 << 12);      // OC4M = 110 (PWM1)
+            TIMx->CCR4  = half;
+            TIMx->CCER |= TIM_CCER_CC4E;
+            return 5;
+        default:
+            return 0xFF;
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       ʱĶٲ
+// ˵      tim_n           ʱ (RUN_TIM1 / RUN_TIM2 / RUN_TIM3 / RUN_TIM4)
+// ˵      rate_hz          (ÿ봥ÿת chs )
+// ˵      chs / num       ͨ (1 ~ 16)
+// ˵      smp             ʱ
+// ˵      st               (ṩ洢)
+// ˵      buf / count     count  2 * num ı (ÿ鶼)
+// ˵      callback / ctx  ص (DMA жִ)NULL ʾ RUN_stream_get ѯ
+// ز      uint32_t        ʵʲ (Hz)0 ʾʧ
+// ʹʾ      static uint16_t vib[1024];
+//               static uint8_t on_block(void* half, uint16_t n, void* ctx) { fft_push((uint16_t*)half, n); return 1; }
+//               const RUN_ADC_Channel_enum ch = RUN_ADC_CH0_PA0;
+//               RUN_ADC_Init();
+//               RUN_ADC_Timed_Start(RUN_TIM3, 10000, &ch, 1, RUN_ADC_SMP_28_5, &st, vib, 1024, on_block, 0);
+// עϢ      1. һתʱ num * (smp + 12.5) / ADCCLK ڲڣ򷵻 0
+//                  PCLK2 = 72MHz ʱ ADCCLK = 12MHzͨ 1.5 Լ 857kSPS
+//                  Ҫ 1MSPS  PCLK2  56MHz (ADCCLK = 14MHz)
+//               2. ɶʱ PSC / ARR ƵõֵʵֵRUN_clock_set Ƶɶʱӱ
+//               3. ʱڼ ADC1 鱻ռRUN_ADC_Get_Value  0
+//-------------------------------------------------------------------------------------------------------------------
+uint32_t RUN_ADC_Timed_Start(RUN_TIM_enum tim_n, uint32_t rate_hz,
+                             const RUN_ADC_Channel_enum* chs, uint8_t num, RUN_ADC_Sample_t smp,
+                             RUN_stream_t* st, uint16_t* buf, uint16_t count,
+                             RUN_stream_cb_t callback, void* ctx)
+{
+    uint32_t rate;
+    uint8_t  extsel, i;
+
+    if (tim_n != RUN_TIM1 && (tim_n < RUN_TIM2 || tim_n > RUN_TIM4)) return 0;
+    if (rate_hz == 0 || chs == 0 || num == 0 || num > RUN_ADC_SCAN_MAX) return 0;
+    if (smp > RUN_ADC_SMP_239_5) return 0;
+    if (st == 0 || buf == 0 || count == 0 || count % (2u * num)) return 0;
+    for (i = 0; i < num; i++) if ((uint8_t)chs[i] > 17) return 0;
+
+    // 1. һתһ
+    if ((uint64_t)num * (adc_smp_x2[smp] + 25) * rate_hz > (uint64_t)RUN_clock_get()->adcclk * 2) return 0;
+
+    RUN_ADC_Scan_Stop();
+    RUN_ADC_Timed_Stop();
+    RUN_ADC_Dual_Stop();
+
+    // 2.  (DMA1 ͨ1)
+    if (!RUN_stream_init(st, RUN_DMA_REQ_ADC1, (uint32_t)&ADC1->DR, buf, count,
+                         RUN_DMA_DIR_P2M, RUN_DMA_WIDTH_16BIT, callback, ctx, 1, 0)) return 0;
+
+    // 3. ʱʱʹ (Ȳ)
+    rate = RUN_timer_init_freq(tim_n, rate_hz);
+    extsel = adc_trigger_config(tim_n);
+
+    // 4. 飺 ()ⲿ + DMA
+    adc_regular_setup(ADC1, chs, num, smp);
+    ADC1->CR2 = (ADC1->CR2 & ~(ADC_CR2_EXTSEL | ADC_CR2_CONT)) | ((uint32_t)extsel << 17) | ADC_CR2_EXTTRIG | ADC_CR2_DMA;
+
+    adc_timed_st  = st;
+    adc_timed_tim = tim_n;
+    RUN_stream_start(st);
+    RUN_timer_cmd(tim_n, ENABLE);
+    return rate;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       ֹͣʱ
+// ز      void
+// עϢ      ֹͣʱͷ DMA ͨADC صģʽ
+//-------------------------------------------------------------------------------------------------------------------
+void RUN_ADC_Timed_Stop(void)
+{
+    if (adc_timed_st == 0) return;
+
+    RUN_timer_cmd(adc_timed_tim, DISABLE);
+    RUN_stream_deinit(adc_timed_st);
+    adc_timed_st = 0;
+    adc_regular_reset();
+}
+
+// ==============================================================================
+// ˫ ADC (ADC1  + ADC2 )
+// ==============================================================================
+
+// 
+// ADC1->CR1.DUALMOD ѡģʽADC2 ת ADC1 Ĵ (ADC2 ԼĴ SWSTART )
+// ADC2 Ľ ADC1->DR ĸ 16 λADC1  DMA  32 λһΰһԽߣ
+//   ͬ (0110) ADC ͬһʱ̿ʼ԰Լת chs1[i] / chs2[i]ѹɶԡûλ
+//   ٽ (0111) ADC תͬһͨADC2 ȿʼADC1  7  ADC ʱӣʷ
+
+//-------------------------------------------------------------------------------------------------------------------
+//       ˫ ADC ɼ
+// ˵      mode            RUN_ADC_DUAL_SIMULT / RUN_ADC_DUAL_INTERLEAVE
+// ˵      tim_n           ʱ (ͬ RUN_ADC_Timed_Start)RUN_TIM_MAX ʾת ()
+// ˵      rate_hz         Ƶ (tim_n = RUN_TIM_MAX ʱ)
+// ˵      chs1 / chs2     ADC1 / ADC2 ͨ (ģʽֻ chs1[0]chs2 Ϊ NULL)
+// ˵      num             ÿ ADC ͨ (ģʽΪ 1)
+// ˵      smp             ʱ (ģʽ RUN_ADC_SMP_1_5)
+// ˵      st / buf / count  32 λcount  2 * num ı
+// ˵      callback / ctx  ص
+// ز      uint32_t        ÿ 32 λ (һ = һԽ)0 ʾʧ
+// ʹʾ      // ѹ PA0 /  PA1 ͬʱ10kHz
+//               static uint32_t vi[512];
+//               const RUN_ADC_Channel_enum u = RUN_ADC_CH0_PA0, i = RUN_ADC_CH1_PA1;
+//               RUN_ADC_Dual_Start(RUN_ADC_DUAL_SIMULT, RUN_TIM3, 10000, &u, &i, 1, RUN_ADC_SMP_13_5,
+//                                  &st, vi, 512, on_block, 0);
+//               // on_block Уѹ = (uint16_t)w = (uint16_t)(w >> 16)
+// עϢ      1. ͬģʽͬһͨͬʱ ADC ͬһ
+//               2. ģʽתÿ ADC 14 һΣ ADCCLK / 7 ÿ
+//                  (ADCCLK = 12MHz Լ 1.71MSPS14MHz Ϊ 2MSPS) 16 λ (ADC2) ǽǸ
+//               3. ¶ / VREFINT ֻ ADC1 
+//-------------------------------------------------------------------------------------------------------------------
+uint32_t RUN_ADC_Dual_Start(RUN_ADC_Dual_t mode, RUN_TIM_enum tim_n, uint32_t rate_hz,
+                            const RUN_ADC_Channel_enum* chs1, const RUN_ADC_Channel_enum* chs2, uint8_t num,
+                            RUN_ADC_Sample_t smp, RUN_stream_t* st, uint32_t* buf, uint16_t count,
+                            RUN_stream_cb_t callback, void* ctx)
+{
+    uint32_t adcclk = RUN_clock_get()->adcclk;
+    uint32_t rate;
+    uint8_t  extsel = 7, i;
+
+    // 1. 
+    if (mode != RUN_ADC_DUAL_SIMULT && mode != RUN_ADC_DUAL_INTERLEAVE) return 0;
+    if (tim_n != RUN_TIM_MAX && tim_n != RUN_TIM1 && (tim_n < RUN_TIM2 || tim_n > RUN_TIM4)) return 0;
+    if (chs1 == 0 || num == 0 || num > RUN_ADC_SCAN_MAX || st == 0 || buf == 0) return 0;
+    if (smp > RUN_ADC_SMP_239_5) return 0;
+    if (mode == RUN_ADC_DUAL_INTERLEAVE)
+    {
+        if (num != 1 || smp != RUN_ADC_SMP_1_5) return 0;  // ׶βصʱ < 7 
+        chs2 = chs1;
+    }
+    if (chs2 == 0 || count == 0 || count % (2u * num)) return 0;
+    for (i = 0; i < num; i++) if ((uint8_t)chs1[i] > 17 || (uint8_t)chs2[i] > 15) return 0;
+
+    if (tim_n == RUN_TIM_MAX)
+    {
+        rate = adcclk * 2 / ((uint32_t)num * (adc_smp_x2[smp] + 25));
+    }
+    else
+    {
+        if (rate_hz == 0) return 0;
+        if ((uint64_t)num * (adc_smp_x2[smp] + 25 + (mode == RUN_ADC_DUAL_INTERLEAVE ? 14 : 0)) * rate_hz > (uint64_t)adcclk * 2) return 0;
+        rate = 0;
+    }
+
+    RUN_ADC_Scan_Stop();
+    RUN_ADC_Timed_Stop();
+    RUN_ADC_Dual_Stop();
+
+    // 2.  (ADC1  DMA1 ͨ132 λ)
+    if (!RUN_stream_init(st, RUN_DMA_REQ_ADC1, (uint32_t)&ADC1->DR, buf, count,
+                         RUN_DMA_DIR_P2M, RUN_DMA_WIDTH_32BIT, callback, ctx, 1, 0)) return 0;
+
+    // 3. ʱ
+    if (tim_n != RUN_TIM_MAX)
+    {
+        rate   = RUN_timer_init_freq(tim_n, rate_hz);
+        extsel = adc_trigger_config(tim_n);
+    }
+
+    // 4. ADC2 ӻ ADC1 ȳ SWSTART ( ADC1 )
+    RCC->APB2ENR |= RCC_APB2ENR_ADC2EN;
+    ADC1->CR1 &= ~ADC_CR1_DUALMOD;
+    adc_regular_setup(ADC2, chs2, num, smp);
+    ADC2->CR2 |= ADC_CR2_EXTTRIG | ADC_CR2_EXTSEL;
+    if (tim_n == RUN_TIM_MAX) ADC2->CR2 |= ADC_CR2_CONT;
+
+    // 5. ADC1 ˫ ADC ģʽ + DMA
+    adc_regular_setup(ADC1, chs1, num, smp);
+    ADC1->CR1 = (ADC1->CR1 & ~ADC_CR1_DUALMOD) | ((uint32_t)mode << 16);
+    ADC1->CR2 = (ADC1->CR2 & ~ADC_CR2_EXTSEL) | ((uint32_t)extsel << 17) | ADC_CR2_EXTTRIG | ADC_CR2_DMA;
+    if (tim_n == RUN_TIM_MAX) ADC1->CR2 |= ADC_CR2_CONT;
+
+    adc_dual_st  = st;
+    adc_dual_tim = tim_n;
+    RUN_stream_start(st);
+    if (tim_n == RUN_TIM_MAX) ADC1->CR2 |= ADC_CR2_SWSTART;
+    else                      RUN_timer_cmd(tim_n, ENABLE);
+    return rate;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       ֹͣ˫ ADC ɼ
+// ز      void
+// עϢ      ADC2 ϵ磬ADC1 صģʽ
+//-------------------------------------------------------------------------------------------------------------------
+void RUN_ADC_Dual_Stop(void)
+{
+    if (adc_dual_st == 0) return;
+
+    if (adc_dual_tim != RUN_TIM_MAX) RUN_timer_cmd(adc_dual_tim, DISABLE);
+    ADC2->CR2 &= ~(ADC_CR2_CONT | ADC_CR2_ADON);
+    RUN_stream_deinit(adc_dual_st);
+    adc_dual_st = 0;
+    adc_regular_reset();
+}
+
+// ==============================================================================
+// ע (PWM ͬ + JEOC ж)
+// ==============================================================================
+
+// 
+// ͨ·TIM1 / TIM8 (CC4  TRGO) --(JEXTSEL)--> ADC1 ע JSQ --> JDR1~4 --JEOC--> ADC1_2_IRQHandler --> ص
+// ע봥ʱ鵱ǰתϣעתԶתɨ / ʱͬʱС
+// ADC1 / ADC2 עѡĴ (JEXTSEL)TIM1_TRGO (000)TIM1_CC4 (001)TIM2_TRGO / CC1TIM3_CC4TIM4_TRGO
+// EXTI15  TIM8_CC4 (110 ADC1_ETRGINJ_REMAP ѡ)JSWSTART (111)TIM8  TRGO Ӳ ADC1 / ADC2
+// JSQR д JSQ(4 - num + 1) ʼŵ JSQ4ת˳ JDR1 ~ JDRnum
+
+//-------------------------------------------------------------------------------------------------------------------
+// ڲԴӦĶʱ NULL
+//-------------------------------------------------------------------------------------------------------------------
+static TIM_TypeDef* adc_inj_timer(RUN_ADC_InjTrig_t trig)
+{
+    if (trig == RUN_ADC_INJ_TIM8_CC4) return TIM8;
+    if (trig == RUN_ADC_INJ_SOFTWARE) return 0;
+    return TIM1;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       ע
+// ˵      trig            Դ (RUN_ADC_INJ_TIM1_TRGO / TIM1_CC4 / TIM8_CC4 / SOFTWARE)
+// ˵      chs / num       ͨ (1 ~ 4)һǸٴһ·ĸߵѹ
+// ˵      smp             ʱ
+// ˵      callback / ctx  תĻص (ADC жִ)NULL ʾֻ RUN_ADC_Inj_Get 
+// ˵      pre_priority / sub_priority  ADC жȼ (һ)
+// ز      uint8_t         1: ɹ  0: 
+// ʹʾ      // PWM  TIM1_CH1 (PA8) ϣ20kHzڵͨе PA0 / PA1 
+//               static void current_loop(const uint16_t* s, uint8_t n, void* ctx) { pi_update(s[0], s[1]); }
+//               const RUN_ADC_Channel_enum chs[2] = {RUN_ADC_CH0_PA0, RUN_ADC_CH1_PA1};
+//               RUN_pwm_init(PWM_TIM1_CH1_PA8, 20000, duty);
+//               RUN_ADC_Init();
+//               RUN_ADC_Inj_Start(RUN_ADC_INJ_TIM1_CC4, chs, 2, RUN_ADC_SMP_7_5, current_loop, 0, 0, 0);
+//               RUN_ADC_Inj_SetPoint(duty / 2);       // ÿ RUN_pwm_set ֮Ÿ
+// עϢ      1. ʱ RUN_pwm_init òУCC4 ռøöʱͨ 4
+//                  (OC4M = PWM1ֻ CC4EŲɸþûв)ͨ 4 Ҫ PWM
+//               2. ض PWM  TRGO (¼) ڿرϣҪܿ CC4 + RUN_ADC_Inj_SetPoint
+//               3. һת num * (smp + 12.5) / ADCCLK  PWM ڣĴ
+//-------------------------------------------------------------------------------------------------------------------
+uint8_t RUN_ADC_Inj_Start(RUN_ADC_InjTrig_t trig, const RUN_ADC_Channel_enum* chs, uint8_t num,
+                          RUN_ADC_Sample_t smp, RUN_ADC_Inj_cb_t callback, void* ctx,
+                          uint8_t pre_priority, uint8_t sub_priority)
+{
+    TIM_TypeDef* TIMx = adc_inj_timer(trig);
+    uint32_t     jsqr = 0;
+    uint8_t      i;
+
+    // 1. 
+    if (trig != RUN_ADC_INJ_TIM1_TRGO && trig != RUN_ADC_INJ_TIM1_CC4 &&
+        trig != RUN_ADC_INJ_TIM8_CC4  && trig != RUN_ADC_INJ_SOFTWARE) return 0;
+    if (chs == 0 || num == 0 || num > RUN_ADC_INJ_MAX) return 0;
+    for (i = 0; i < num; i++) if ((uint8_t)chs[i] > 17) return 0;
+
+    RUN_ADC_Inj_Stop();
+
+    // 2. 
+    if (trig == RUN_ADC_INJ_TIM1_TRGO)
+    {
+        TIMx->CR2 = (TIMx->CR2 & ~TIM_CR2_MMS) | TIM_CR2_MMS_1;    // MMS = 010¼Ϊ TRGO
+    }
+    else if (TIMx)
+    {
+        TIMx->CCMR2 = (TIMx->CCMR2 & 0x00FF) | (6 << 12);          // OC4M = 110 (PWM1)
+        TIMx->CCR4  = (uint16_t)((TIMx->ARR + 1) / 2);              // Ĭϲе
+        TIMx->CCER |= TIM_CCER_CC4E;
+        TIMx->BDTR |= TIM_BDTR_MOE;
+        if (trig == RUN_ADC_INJ_TIM8_CC4)
+        {
+            RCC->APB2ENR |= RCC_APB2ENR_AFIOEN;
+            AFIO->MAPR   |= AFIO_MAPR_ADC1_ETRGINJ_REMAP;           // JEXTSEL = 110 ѡ TIM8_CC4  EXTI15
+        }
+    }
+
+    // 3. עкͲʱ
+    for (i = 0; i < num; i++)
+    {
+        uint8_t ch = (uint8_t)chs[i];
+
+        RUN_ADC_ConfigPin(chs[i]);
+        adc_set_sample(ADC1, ch, smp);
+        jsqr |= (uint32_t)ch << (5 * (4 - num + i));
+        if (ch >= 16) ADC1->CR2 |= ADC_CR2_TSVREFE;
+    }
+    ADC1->JSQR = jsqr | ((uint32_t)(num - 1) << 20);            // JL[1:0] = ת - 1
+    if (num > 1) ADC1->CR1 |= ADC_CR1_SCAN;                      // ֻһͨʱɨҲӰ
+
+    adc_inj_cb    = callback;
+    adc_inj_ctx   = ctx;
+    adc_inj_num   = num;
+    adc_inj_trig  = trig;
+    adc_inj_count = 0;
+
+    // 4. ⲿ + JEOC ж
+    ADC1->SR   = ~(uint32_t)(ADC_SR_JEOC | ADC_SR_JSTRT);
+    ADC1->CR2  = (ADC1->CR2 & ~ADC_CR2_JEXTSEL) | ((uint32_t)trig << 12) | ADC_CR2_JEXTTRIG;
+    ADC1->CR1 |= ADC_CR1_JEOCIE;
+    NVIC_SetPriority(ADC1_2_IRQn, NVIC_EncodePriority(NVIC_GetPriorityGrouping(), pre_priority, sub_priority));
+    NVIC_EnableIRQ(ADC1_2_IRQn);
+    return 1;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       ֹͣע
+// ز      void
+// עϢ      ʱ PWM Ӱ
+//-------------------------------------------------------------------------------------------------------------------
+void RUN_ADC_Inj_Stop(void)
+{
+    if (adc_inj_num == 0) return;
+
+    ADC1->CR1 &= ~ADC_CR1_JEOCIE;
+    ADC1->CR2 &= ~(ADC_CR2_JEXTTRIG | ADC_CR2_JEXTSEL);
+    ADC1->JSQR = 0;
+    if ((ADC1->SQR1 & ADC_SQR1_L) == 0) ADC1->CR1 &= ~ADC_CR1_SCAN;
+    if (!adc_awd_on) NVIC_DisableIRQ(ADC1_2_IRQn);         // ŹҪж
+    adc_inj_num = 0;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//        CC4 Ĳ
+// ˵      pos             PWM ڵֱ (0 ~ 10000 RUN_pwm_set ռձͬһ̶)
+// ز      void
+// ʹʾ      RUN_pwm_set(PWM_TIM1_CH1_PA8, duty);
+//               RUN_ADC_Inj_SetPoint(duty / 2);   // ض PWMͨе㣬رԶ
+// עϢ      TRGO / ʱЧֵһ PWM Ч (CCR4 ԤװعرʱЧ)
+//-------------------------------------------------------------------------------------------------------------------
+void RUN_ADC_Inj_SetPoint(uint32_t pos)
+{
+    TIM_TypeDef* TIMx;
+    uint32_t     ccr;
+
+    if (adc_inj_num == 0 || adc_inj_trig == RUN_ADC_INJ_TIM1_TRGO) return;
+    TIMx = adc_inj_timer(adc_inj_trig);
+    if (TIMx == 0) return;
+
+    if (pos > 10000) pos = 10000;
+    ccr = (TIMx->ARR + 1) * pos / 10000;
+    if (ccr > TIMx->ARR) ccr = TIMx->ARR;                        // CCR4 > ARR ԶȽϲϣûд
+    TIMx->CCR4 = (uint16_t)ccr;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       һע
+// ز      void
+// עϢ      ֻ RUN_ADC_INJ_SOFTWARE ʱЧ
+//-------------------------------------------------------------------------------------------------------------------
+void RUN_ADC_Inj_Trigger(void)
+{
+    if (adc_inj_num && adc_inj_trig == RUN_ADC_INJ_SOFTWARE) ADC1->CR2 |= ADC_CR2_JSWSTART;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       һע
+// ˵      i                (0 ~ num-1)Ӧʱ chs[i]
+// ز      uint16_t        תΧ 0
+//-------------------------------------------------------------------------------------------------------------------
+uint16_t RUN_ADC_Inj_Get(uint8_t i)
+{
+    if (i >= adc_inj_num) return 0;
+    return adc_inj_sample[i];
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       ۼɵע
+// ز      uint32_t         (RUN_ADC_Inj_Start ʱ)
+//-------------------------------------------------------------------------------------------------------------------
+uint32_t RUN_ADC_Inj_Count(void)
+{
+    return adc_inj_count;
+}
+
+// ==============================================================================
+// ģ⿴Ź (AWD)
+// ==============================================================================
+
+// 
+// ȽϷÿתд DR / JDRx ͬʱ DMA ˻Ӱ죺
+// AWDEN ӹ (ɨ / ʱ / RUN_ADC_Get_Value)JAWDEN ע飬߶򿪡
+// AWDSGL = 1 ʱֻȽ AWDCH ͨͨ HTR / LTR һֵ
+
+//-------------------------------------------------------------------------------------------------------------------
+//       ģ⿴Ź
+// ˵      ch              ӵͨRUN_ADC_AWD_ALL ʾͨ
+// ˵      low / high       (0 ~ 4095) < low  > high 
+// ˵      callback / ctx  Խص (ADC жִ)
+// ˵      pre_priority / sub_priority  ADC жȼ (ע鹲ͬһжϣõЧ)
+// ز      uint8_t         1: ɹ  0: 
+// ʹʾ      // PA1  (ɨ) 3000  PWM
+//               static void over_current(RUN_ADC_Channel_enum ch, void* ctx) { RUN_pwm_set(PWM_TIM1_CH1_PA8, 0); fault = 1; }
+//               RUN_ADC_Scan_Start(chs, 4, RUN_ADC_SMP_13_5, result);
+//               RUN_ADC_Awd_Start(RUN_ADC_CH1_PA1, 0, 3000, over_current, 0, 0, 0);
+//               ...ϴ RUN_ADC_Awd_Rearm();
+// עϢ      1. жԶر (ֻһΣҲԽڼÿתж)
+//                  ص֮ RUN_ADC_Awd_Rearm ´
+//               2. Ƚϵ 12 λԭʼֵ ALIGN / ע JOFRx ƫӰ
+//               3. ӲֻһֵͬͨҪͬʱȡҪǸͨ
+//-------------------------------------------------------------------------------------------------------------------
+uint8_t RUN_ADC_Awd_Start(RUN_ADC_Channel_enum ch, uint16_t low, uint16_t high,
+                          RUN_ADC_Awd_cb_t callback, void* ctx,
+                          uint8_t pre_priority, uint8_t sub_priority)
+{
+    uint32_t cr1;
+
+    if (ch != RUN_ADC_AWD_ALL && (uint8_t)ch > 17) return 0;
+    if (low > high || high > 0xFFF) return 0;
+
+    adc_awd_cb    = callback;
+    adc_awd_ctx   = ctx;
+    adc_awd_ch    = ch;
+    adc_awd_count = 0;
+    adc_awd_on    = 1;
+
+    ADC1->HTR = high;
+    ADC1->LTR = low;
+
+    cr1 = ADC1->CR1 & ~(ADC_CR1_AWDCH | ADC_CR1_AWDSGL | ADC_CR1_AWDEN | ADC_CR1_JAWDEN | ADC_CR1_AWDIE);
+    if (ch != RUN_ADC_AWD_ALL) cr1 |= ADC_CR1_AWDSGL | (uint32_t)ch;
+    ADC1->SR   = ~(uint32_t)ADC_SR_AWD;
+    ADC1->CR1  = cr1 | ADC_CR1_AWDEN | ADC_CR1_JAWDEN | ADC_CR1_AWDIE;
+
+    NVIC_SetPriority(ADC1_2_IRQn, NVIC_EncodePriority(NVIC_GetPriorityGrouping(), pre_priority, sub_priority));
+    NVIC_EnableIRQ(ADC1_2_IRQn);
+    return 1;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       ֹͣģ⿴Ź
+// ز      void
+//-------------------------------------------------------------------------------------------------------------------
+void RUN_ADC_Awd_Stop(void)
+{
+    if (!adc_awd_on) return;
+
+    ADC1->CR1 &= ~(ADC_CR1_AWDEN | ADC_CR1_JAWDEN | ADC_CR1_AWDIE);
+    ADC1->SR   = ~(uint32_t)ADC_SR_AWD;
+    if (adc_inj_num == 0) NVIC_DisableIRQ(ADC1_2_IRQn);      // ע黹Ҫж
+    adc_awd_on = 0;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       ޸ĿŹ
+// ˵      low / high       (0 ~ 4095)
+// ز      void
+// עϢ      Ϸʱԭ
+//-------------------------------------------------------------------------------------------------------------------
+void RUN_ADC_Awd_SetThreshold(uint16_t low, uint16_t high)
+{
+    if (low > high || high > 0xFFF) return;
+    ADC1->HTR = high;
+    ADC1->LTR = low;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       ´Խж
+// ز      void
+// עϢ      ־ٿжϣֵڴʱһתٴ
+//-------------------------------------------------------------------------------------------------------------------
+void RUN_ADC_Awd_Rearm(void)
+{
+    if (!adc_awd_on) return;
+    ADC1->SR   = ~(uint32_t)ADC_SR_AWD;
+    ADC1->CR1 |= ADC_CR1_AWDIE;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       ۼƴ
+// ز      uint32_t         (RUN_ADC_Awd_Start ʱ)
+//-------------------------------------------------------------------------------------------------------------------
+uint32_t RUN_ADC_Awd_Count(void)
+{
+    return adc_awd_count;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// жϷADC1 / ADC2 
+// AWDȹص AWDIE ٻصԽڼÿת AWDػᱻжû
+// JEOCJDR1 ~ JDRnum ־ (صڼһԽת)ٽƻص
+// SR λ rc_w0־ֱд ~flag--дη֮õı־һ
+//-------------------------------------------------------------------------------------------------------------------
+void ADC1_2_IRQHandler(void)
+{
+    if ((ADC1->CR1 & ADC_CR1_AWDIE) && (ADC1->SR & ADC_SR_AWD))
+    {
+        ADC1->CR1 &= ~ADC_CR1_AWDIE;
+        ADC1->SR   = ~(uint32_t)ADC_SR_AWD;
+        adc_awd_count++;
+        if (adc_awd_cb) adc_awd_cb(adc_awd_ch, adc_awd_ctx);
+    }
+
+    if ((ADC1->CR1 & ADC_CR1_JEOCIE) && (ADC1->SR & ADC_SR_JEOC))
+    {
+        volatile uint32_t* jdr = &ADC1->JDR1;
+        uint8_t i;
+
+        for (i = 0; i < adc_inj_num; i++) adc_inj_sample[i] = (uint16_t)jdr[i];
+        ADC1->SR = ~(uint32_t)(ADC_SR_JEOC | ADC_SR_JSTRT);
+        adc_inj_count++;
+        if (adc_inj_cb) adc_inj_cb(adc_inj_sample, adc_inj_num, adc_inj_ctx);
+    }
+}
@@ -3,6 +3,9 @@
 
 #include "stm32f10x.h"
 #include "RUN_Gpio.h" // Ҫõ GPIO ʼΪģ
+#include "RUN_DMA.h"
+#include "RUN_Timer.h"
+#include "RUN_Stream.h"
 
 // ==========================================================
 // ADC ͨö (Ӧٲ)
@@ -27,13 +30,33 @@ typedef enum {
     RUN_ADC_CH14_PC4 = ADC_Channel_14,
     RUN_ADC_CH15_PC5 = ADC_Channel_15,
     
-    // ڲ¶ȴ (Ҫ⿪)
+    // ڲ¶ȴ (RUN_ADC_Init  TSVREFE RUN_ADC_Cal)
     RUN_ADC_CH_TEMP  = ADC_Channel_16, 
     // ڲοѹ (Vrefint)
     RUN_ADC_CH_VREF  = ADC_Channel_17  
 
 } RUN_ADC_Channel_enum;
 
+// ʱ (ADC ʱ)תʱ = ʱ + 12.5 
+typedef enum {
+    RUN_ADC_SMP_1_5   = 0,
+    RUN_ADC_SMP_7_5   = 1,
+    RUN_ADC_SMP_13_5  = 2,
+    RUN_ADC_SMP_28_5  = 3,
+    RUN_ADC_SMP_41_5  = 4,
+    RUN_ADC_SMP_55_5  = 5,  // RUN_ADC_Get_Value ʹõĬֵ
+    RUN_ADC_SMP_71_5  = 6,
+    RUN_ADC_SMP_239_5 = 7   // ¶ȴ 17.1usһ
+} RUN_ADC_Sample_t;
+
+#define RUN_ADC_SCAN_MAX    16      //  16 ת
+
+// ˫ ADC ģʽ (ȡֵ ADC1->CR1.DUALMOD)
+typedef enum {
+    RUN_ADC_DUAL_SIMULT     = 6,    // ͬADC1 / ADC2 ͬһʱ̸һͨ
+    RUN_ADC_DUAL_INTERLEAVE = 7     // ٽ棺 ADC ͬһͨʷ
+} RUN_ADC_Dual_t;
+
 // ==========================================================
 // 
 // ==========================================================
@@ -49,6 +72,165 @@ void RUN_ADC_ConfigPin(RUN_ADC_Channel_enum ch);
 uint16_t RUN_ADC_Get_Value(RUN_ADC_Channel_enum ch);
 
 // 4. ȡƽֵ (βȡƽ)
+//     times תҪռ CPU  13~16 λöʱ + RUN_Oversample  DMA صȡ
 uint16_t RUN_ADC_Get_Average(RUN_ADC_Channel_enum ch, uint8_t times);
 
-#endif
\ No newline at end of file
+// ==========================================================
+// ɨ (ɨ + ת + DMA1 ͨ1 ѭ)
+// ----------------------------------------------------------
+// SQR1~3 ͲʱֻʱдһΣ֮ ADC1 Լһһֵת
+// DMA ÿһֵĽ˳д result[]Զµһ֣һڴ
+// ɨڼ RUN_ADC_Get_Value / RUN_ADC_Get_Average ֱӶ飬ٵת
+// ==========================================================
+
+/**
+ * @brief  ɨ ( RUN_ADC_InitɱΪģ)
+ * @param  chs:    ͨ (ظͬһֶͨμĲ)
+ * @param  num:    ͨ (1 ~ RUN_ADC_SCAN_MAX)
+ * @param  smp:    ʱ (ͨͬ)
+ * @param  result:  (num  uint16_t)result[i] Ӧ chs[i]
+ * @return 1: ɹ  0:  / DMA1 ͨ1 ռ
+ * һֺʱ = num * (smp + 12.5) / ADCCLK 8 ͨ55.5 ڡ12MHz Լ 45us
+ */
+uint8_t RUN_ADC_Scan_Start(const RUN_ADC_Channel_enum* chs, uint8_t num,
+                           RUN_ADC_Sample_t smp, volatile uint16_t* result);
+
+// ֹͣɨ (ADC صģʽͷ DMA ͨ)
+void RUN_ADC_Scan_Stop(void);
+
+// ͨ½ (ͨɨﷵ 0)ͬһֶͨʱصһλõֵ
+uint16_t RUN_ADC_Scan_Get(RUN_ADC_Channel_enum ch);
+
+// ==========================================================
+// ʱ (ʾ / 񶯷)
+// ----------------------------------------------------------
+// ʱ¼ֱӴ ADC1 飬Ӳ֤û
+//  DMA1 ͨ1 ƹһ (RUN_stream_t)ÿصһΡ
+// õĴTIM1_CC1 / TIM2_CC2 / TIM3_TRGO / TIM4_CC4 (ADC1  EXTSEL ֻ⼸ʱ)
+// ==========================================================
+
+/**
+ * @brief  ٲ ( RUN_ADC_Init)
+ * @param  tim_n:     RUN_TIM1 / RUN_TIM2 / RUN_TIM3 / RUN_TIM4
+ * @param  rate_hz:    (ÿδת)
+ * @param  buf/count: count  2*num ı chs ˳򽻴
+ * @param  callback:  ص ( RUN_stream_cb_t)
+ * @return ʵʲʣ0 ʾʧ (ʱܴ ADC / תʱ䳬 / DMA1 ͨ1 ռ)
+ */
+uint32_t RUN_ADC_Timed_Start(RUN_TIM_enum tim_n, uint32_t rate_hz,
+                             const RUN_ADC_Channel_enum* chs, uint8_t num, RUN_ADC_Sample_t smp,
+                             RUN_stream_t* st, uint16_t* buf, uint16_t count,
+                             RUN_stream_cb_t callback, void* ctx);
+
+// ֹͣٲ
+void RUN_ADC_Timed_Stop(void);
+
+// ==========================================================
+// ˫ ADC (ADC1 + ADC2)
+// ----------------------------------------------------------
+// ÿ DMA һ 32 λ֣ 16 λ ADC1 16 λ ADC2
+// ͬڵѹ / ֮λٽڵͨ ~2MSPS ٲɼ
+// ==========================================================
+
+/**
+ * @brief  ˫ ADC ɼ ( RUN_ADC_Init)
+ * @param  tim_n:     ʱ (RUN_TIM1 ~ RUN_TIM4)RUN_TIM_MAX ʾת
+ * @param  chs1/chs2: ADC1 / ADC2 ͨУ num  (ģʽֻ chs1[0])
+ * @param  buf/count: 32 λcount  2*num ı
+ * @return ÿ˵ 32 λ (ģʽ 2 )0 ʾʧ
+ */
+uint32_t RUN_ADC_Dual_Start(RUN_ADC_Dual_t mode, RUN_TIM_enum tim_n, uint32_t rate_hz,
+                            const RUN_ADC_Channel_enum* chs1, const RUN_ADC_Channel_enum* chs2, uint8_t num,
+                            RUN_ADC_Sample_t smp, RUN_stream_t* st, uint32_t* buf, uint16_t count,
+                            RUN_stream_cb_t callback, void* ctx);
+
+// ֹͣ˫ ADC ɼ
+void RUN_ADC_Dual_Stop(void);
+
+// ==========================================================
+// ע (PWM ͬ)
+// ----------------------------------------------------------
+// TIM1 / TIM8  CC4  TIM1  TRGO  ADC1 ע飬һת 4 ͨ
+// ת (JEOC)  ADC жѽƻص PWM Ƶϣ
+// ʱ PWM Ӳܿرص塣
+// ע͹黥ţɨ / ʱ / RUN_ADC_Get_Value ճ (עת)
+// ==========================================================
+
+// ע鴥Դ (ȡֵ ADC1->CR2.JEXTSEL)
+typedef enum {
+    RUN_ADC_INJ_TIM1_TRGO = 0,      // TIM1 ¼ (MMS = 010)ض PWM 
+    RUN_ADC_INJ_TIM1_CC4  = 1,      // TIM1 CC4 RUN_ADC_Inj_SetPoint 趨
+    RUN_ADC_INJ_TIM8_CC4  = 6,      // TIM8 CC4 ( AFIO  ADC1_ETRGINJ_REMAP)
+    RUN_ADC_INJ_SOFTWARE  = 7       // JSWSTART RUN_ADC_Inj_Trigger 
+} RUN_ADC_InjTrig_t;
+
+#define RUN_ADC_INJ_MAX     4       // ע 4 ת
+
+// עص (ADC жִ)sample[i] Ӧʱ chs[i]
+typedef void (*RUN_ADC_Inj_cb_t)(const uint16_t* sample, uint8_t num, void* ctx);
+
+/**
+ * @brief  ע ( RUN_ADC_Initʱ RUN_pwm_init ò)
+ * @param  trig:     Դ
+ * @param  chs/num:  ͨ (1 ~ RUN_ADC_INJ_MAX)
+ * @param  smp:      ʱ
+ * @param  callback: תĻصNULL ʾֻ RUN_ADC_Inj_Get 
+ * @return 1: ɹ  0: 
+ */
+uint8_t RUN_ADC_Inj_Start(RUN_ADC_InjTrig_t trig, const RUN_ADC_Channel_enum* chs, uint8_t num,
+                          RUN_ADC_Sample_t smp, RUN_ADC_Inj_cb_t callback, void* ctx,
+                          uint8_t pre_priority, uint8_t sub_priority);
+
+// ֹͣע
+void RUN_ADC_Inj_Stop(void);
+
+// CC4 Ĳ㣺pos Ϊ PWM ڵֱ (0 ~ 10000)ض PWM ȡ duty / 2 ڵͨе
+void RUN_ADC_Inj_SetPoint(uint32_t pos);
+
+// һ (RUN_ADC_INJ_SOFTWARE)
+void RUN_ADC_Inj_Trigger(void);
+
+// һĵ i  (0 ~ num-1)
+uint16_t RUN_ADC_Inj_Get(uint8_t i);
+
+// ۼɵ (ƻصǷ PWM)
+uint32_t RUN_ADC_Inj_Count(void);
+
+// ==========================================================
+// ģ⿴Ź ( / ѹ)
+// ----------------------------------------------------------
+// Ӳÿתʱѽ [low, high] ȽϣԽжϣ
+// ڲռ CPUɨ + DMAʱעתڼӷΧڣ
+// Ӧʱһת ( us)ѭѯö࣬Ҳ©ʱ塣
+// ADC1 ֻһֵҪôֻһͨҪôͨͬһڡ
+// ==========================================================
+
+#define RUN_ADC_AWD_ALL     ((RUN_ADC_Channel_enum)0xFF)   // ͨ
+
+// Խص (ADC жִ)ch Ϊʱͨ ( RUN_ADC_AWD_ALL)
+typedef void (*RUN_ADC_Awd_cb_t)(RUN_ADC_Channel_enum ch, void* ctx);
+
+/**
+ * @brief  ģ⿴Ź ( RUN_ADC_Init)
+ * @param  ch:        ӵͨRUN_ADC_AWD_ALL ʾͨ
+ * @param  low/high:   (0 ~ 409512 λҶԭʼֵ) < low  > high 
+ * @param  callback:  Խص (һκжԶرգ RUN_ADC_Awd_Rearm ´)
+ * @return 1: ɹ  0: 
+ */
+uint8_t RUN_ADC_Awd_Start(RUN_ADC_Channel_enum ch, uint16_t low, uint16_t high,
+                          RUN_ADC_Awd_cb_t callback, void* ctx,
+                          uint8_t pre_priority, uint8_t sub_priority);
+
+// ֹͣģ⿴Ź
+void RUN_ADC_Awd_Stop(void);
+
+// ޸Ĵ (пɸģһתЧ)
+void RUN_ADC_Awd_SetThreshold(uint16_t low, uint16_t high);
+
+// ´Խж (µı־)
+void RUN_ADC_Awd_Rearm(void);
+
+// ۼƴ
+uint32_t RUN_ADC_Awd_Count(void);
+
+#endif
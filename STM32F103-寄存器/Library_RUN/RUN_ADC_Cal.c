@@ -0,0 +1,176 @@
+#include "RUN_ADC_Cal.h"
+
+//
+// ϵƵ (raw / vref_raw Ϊ 12 λԭʼֵVDDA  4095)
+//   VDDA = VREFINT * 4095 / vref_raw
+//   V    = raw * VDDA / 4095 = raw * VREFINT / vref_raw          -> k  = VREFINT_mV * 65536 / vref_raw
+//   T    = 25 + (V25 - V) / Slope
+//   T*100 = (2500 + 100 * V25 / Slope) - raw * (k * 100000 / Slope) >> 16   -> c0tb
+// k  VDDA = 2.0 ~ 3.6V ʱԼ 32000 ~ 58000raw * k  32 λڣuV / ¶ 32x32->64 ˷ (Cortex-M3 һ UMULL)
+
+// ==============================================================================
+// ȫֱ
+// ==============================================================================
+static volatile uint32_t adc_cal_k  = ((uint32_t)RUN_ADC_CAL_VREFINT_MV << 16) / 1489;    // δǰ VDDA = 3.3V
+static volatile uint32_t adc_cal_tb = 0;
+static volatile int32_t  adc_cal_c0 = 0;
+static volatile uint16_t adc_cal_vref_raw = 1489;
+static uint16_t          adc_cal_vrefint_mv = RUN_ADC_CAL_VREFINT_MV;
+static int16_t           adc_cal_offset = 0;
+
+// ==============================================================================
+// ڲ
+// ==============================================================================
+
+//-------------------------------------------------------------------------------------------------------------------
+// ڲ vref_raw ¼ȫϵ (г)
+//-------------------------------------------------------------------------------------------------------------------
+static void adc_cal_refresh(void)
+{
+    uint32_t k  = ((uint32_t)adc_cal_vrefint_mv << 16) / adc_cal_vref_raw;
+    uint32_t tb = (uint32_t)((uint64_t)k * 100000u / RUN_ADC_CAL_SLOPE_UV);
+    int32_t  c0 = 2500 + (int32_t)((uint64_t)RUN_ADC_CAL_V25_UV * 100u / RUN_ADC_CAL_SLOPE_UV) + adc_cal_offset;
+    uint32_t primask = __get_PRIMASK();
+
+    __set_PRIMASK(1);                          // ϵһ𻻣жﲻһһ
+    adc_cal_k  = k;
+    adc_cal_tb = tb;
+    adc_cal_c0 = c0;
+    __set_PRIMASK(primask);
+}
+
+// ==============================================================================
+// ӿں
+// ==============================================================================
+
+//-------------------------------------------------------------------------------------------------------------------
+//       ʼ
+// ز      uint8_t         1: ɹ  0: 鱻ռãݰ VDDA = 3.3V
+// ʹʾ      RUN_ADC_Init();
+//               RUN_ADC_Cal_Init();
+//               uint32_t mv = RUN_ADC_Cal_mV(RUN_ADC_Get_Value(RUN_ADC_CH0_PA0));
+// עϢ      TSVREFE  RUN_ADC_Init 
+//-------------------------------------------------------------------------------------------------------------------
+uint8_t RUN_ADC_Cal_Init(void)
+{
+    adc_cal_refresh();
+    return RUN_ADC_Cal_Update();
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       ˢ¶ϵ
+// ز      uint8_t         1: ˢ  0: 鱻ռ
+// ʹʾ      // 1s ʱж cal_flagѭˢ
+//               if (cal_flag) { cal_flag = 0; RUN_ADC_Cal_Update(); }
+// עϢ      1. ɨʱ RUN_ADC_Get_Value ɨɨҪ RUN_ADC_CH_VREF
+//                  򷵻 0 (ϵ)
+//               2. ʱ / ˫ ADC ڼ鱻ռVREFINT ŽʱͨУ
+//                  ݻص RUN_ADC_Cal_Feed ˢ
+//-------------------------------------------------------------------------------------------------------------------
+uint8_t RUN_ADC_Cal_Update(void)
+{
+    uint16_t raw = RUN_ADC_Get_Average(RUN_ADC_CH_VREF, 8);
+
+    if (raw == 0) return 0;
+    RUN_ADC_Cal_Feed(raw);
+    return 1;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//        VREFINT ԭʼֵˢϵ
+// ˵      vref_raw        VREFINT  12 λԭʼֵ
+// ز      void
+// עϢ      жеãԲֵ (VDDA  2.0 ~ 3.6V ӦΧ) 
+//-------------------------------------------------------------------------------------------------------------------
+void RUN_ADC_Cal_Feed(uint16_t vref_raw)
+{
+    uint32_t lo = (uint32_t)adc_cal_vrefint_mv * 4095 / 3600;     // VDDA = 3.6V
+    uint32_t hi = (uint32_t)adc_cal_vrefint_mv * 4095 / 2000;     // VDDA = 2.0V
+
+    if (vref_raw < lo || vref_raw > hi) return;
+    adc_cal_vref_raw = vref_raw;
+    adc_cal_refresh();
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//        VREFINT ʵֵ
+// ˵      vrefint_mv      VREFINT ʵֵ (mV1100 ~ 1300)
+// ز      void
+// ʹʾ      // VDDA ʵ 3.297V ʱ vref_raw ƽ 15031503 * 3297 / 4095 = 1210mV
+//               RUN_ADC_Cal_SetVrefint(1210);
+// עϢ      ÿƬоƬ VREFINT ֵͬɴ Flashϵ
+//-------------------------------------------------------------------------------------------------------------------
+void RUN_ADC_Cal_SetVrefint(uint16_t vrefint_mv)
+{
+    if (vrefint_mv < 1100 || vrefint_mv > 1300) return;
+    adc_cal_vrefint_mv = vrefint_mv;
+    adc_cal_refresh();
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       ¶ƫ
+// ˵      offset          ƫ (0.01C)ӵ
+// ز      void
+//-------------------------------------------------------------------------------------------------------------------
+void RUN_ADC_Cal_SetTempOffset(int16_t offset)
+{
+    adc_cal_offset = offset;
+    adc_cal_refresh();
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       ǰ VDDA
+// ز      uint16_t        mV
+//-------------------------------------------------------------------------------------------------------------------
+uint16_t RUN_ADC_Cal_VDDA(void)
+{
+    return (uint16_t)((4095u * adc_cal_k + 0x8000) >> 16);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       12 λԭʼֵ mV
+// ˵      raw             ADC ԭʼֵ (0 ~ 4095)
+// ز      uint32_t        mV ()
+// ʹʾ      uint32_t mv = RUN_ADC_Cal_mV(result[2]);
+//-------------------------------------------------------------------------------------------------------------------
+uint32_t RUN_ADC_Cal_mV(uint16_t raw)
+{
+    return ((uint32_t)raw * adc_cal_k + 0x8000) >> 16;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       ߷ֱԭʼֵ uV
+// ˵      raw             12+bits λԭʼֵ ( RUN_osr_get Ľ)
+// ˵      bits            λ (0 ~ 4)
+// ز      uint32_t        uV
+// ʹʾ      uint32_t uv = RUN_ADC_Cal_uV(RUN_osr_get(&osr, 0), 4);
+//-------------------------------------------------------------------------------------------------------------------
+uint32_t RUN_ADC_Cal_uV(uint32_t raw, uint8_t bits)
+{
+    return (uint32_t)(((uint64_t)raw * adc_cal_k * 1000u) >> (16 + bits));
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       ¶ȴԭʼֵ¶
+// ˵      raw             RUN_ADC_CH_TEMP  12 λԭʼֵ
+// ز      int32_t         0.01C
+// עϢ      ֲֵ¾Լ C (б / V25 )ʺϿͱ仯ƣ
+//               ҪԾʱ RUN_ADC_Cal_SetTempOffset ֪¶һ
+//-------------------------------------------------------------------------------------------------------------------
+int32_t RUN_ADC_Cal_Temp(uint16_t raw)
+{
+    return adc_cal_c0 - (int32_t)(((uint64_t)raw * adc_cal_tb) >> 16);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       һ¶
+// ز      int32_t         0.01C鱻ռʱ INT32_MIN
+// עϢ       4 ת (239.5 ڣԼ 85us)ɨʱɨ RUN_ADC_CH_TEMP
+//-------------------------------------------------------------------------------------------------------------------
+int32_t RUN_ADC_Cal_ReadTemp(void)
+{
+    uint16_t raw = RUN_ADC_Get_Average(RUN_ADC_CH_TEMP, 4);
+
+    if (raw == 0) return INT32_MIN;
+    return RUN_ADC_Cal_Temp(raw);
+}
@@ -0,0 +1,71 @@
+#ifndef _RUN_ADC_CAL_H_
+#define _RUN_ADC_CAL_H_
+
+#include "stm32f10x.h"
+#include "RUN_ADC.h"
+
+// ==========================================================
+// ADC  (VREFINT Դ + ڲ¶ȴ)
+// ----------------------------------------------------------
+// ADC  VDDA ıVDDA Դ / ƯʱֱӰ 3.3V Ư
+// VREFINT ڲ ~1.20V ϶׼ڲһΣϵ k = VREFINT_mV * 65536 / vref_raw 
+//   mV = raw * k >> 16
+// ֮ÿλֻһγ˷λûиҲûг (ֻˢϵʱһ)
+// ¶ͬT(0.01C) = c0 - raw * tb >> 16c0 / tb  k һˢ¡
+//
+// F103 ûгУ׼ֲֵĵֵ (VREFINT 1.16 ~ 1.24VV25 1.34 ~ 1.52V
+// б 4.0 ~ 4.6 mV/C)ԾҪʱ RUN_ADC_Cal_SetVrefint / RUN_ADC_Cal_SetTempOffset 
+// ==========================================================
+
+#ifndef RUN_ADC_CAL_VREFINT_MV
+#define RUN_ADC_CAL_VREFINT_MV  1200        // VREFINT ֵ (mV)
+#endif
+#ifndef RUN_ADC_CAL_V25_UV
+#define RUN_ADC_CAL_V25_UV      1430000     // 25C ʱ¶ȴ (uV)
+#endif
+#ifndef RUN_ADC_CAL_SLOPE_UV
+#define RUN_ADC_CAL_SLOPE_UV    4300        // ¶ȴб (uV/C¶ߵѹ½)
+#endif
+
+// ==========================================================
+// 
+// ==========================================================
+
+/**
+ * @brief  ʼ ( RUN_ADC_Init)һ VREFINT
+ * @return 1: ɹ  0: ADC 鱻ʱ / ˫ ADC ռãݰ VDDA = 3.3V
+ */
+uint8_t RUN_ADC_Cal_Init(void);
+
+/**
+ * @brief  ˢ¶ϵ 8  VREFINT ȡƽ (Լ 180us)
+ * @return 1: ˢ  0: 鱻ռãԭϵ
+ *  100ms ~ 1s һΣɨ RUN_ADC_CH_VREF ʱֱӶɨ
+ */
+uint8_t RUN_ADC_Cal_Update(void);
+
+// ñ𴦵õ VREFINT ԭʼֵˢ (12 λҶ룬ɨ / ƺ)
+void RUN_ADC_Cal_Feed(uint16_t vref_raw);
+
+//  VREFINT ʵֵ (mV)ñ׼ VDDA VDDA * vref_raw / 4095 õ
+void RUN_ADC_Cal_SetVrefint(uint16_t vrefint_mv);
+
+// ¶ƫ (0.01C)ӵϣʵʸ 1.5C ʱ -150
+void RUN_ADC_Cal_SetTempOffset(int16_t offset);
+
+// ǰ VDDA (mV)
+uint16_t RUN_ADC_Cal_VDDA(void);
+
+// 12 λԭʼֵ -> mV
+uint32_t RUN_ADC_Cal_mV(uint16_t raw);
+
+// 12+bits λԭʼֵ () -> uVbits = 0 ͨ 12 λ
+uint32_t RUN_ADC_Cal_uV(uint32_t raw, uint8_t bits);
+
+// ¶ȴԭʼֵ -> 0.01C ( 2537 = 25.37C)
+int32_t RUN_ADC_Cal_Temp(uint16_t raw);
+
+// һ¶ȴ (0.01C)鱻ռʱ INT32_MIN
+int32_t RUN_ADC_Cal_ReadTemp(void);
+
+#endif
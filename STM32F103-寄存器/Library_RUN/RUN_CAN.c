@@ -1,4 +1,5 @@
 #include "RUN_CAN.h"
+#include "RUN_Clock.h"
 
 // ===============================================================================
 // 
@@ -99,9 +100,9 @@ void RUN_can_init(CAN_PIN_enum can_pin, uint32 baud_rate, RUN_CAN_MODE_enum can_
 
     CAN1->MCR |= CAN_MCR_ABOM;   // Զ߹ (Bus-Off Զָ)
 
-    // 5. ʼ (APB1 = 36MHz, TS1=3, TS2=4, SJW=1, Total=8tq)
-    // 36M / 8 / BaudRate = Prescaler
-    uint32_t brp = 36000000 / 8 / baud_rate;
+    // 5. ʼ (TS1=3, TS2=4, SJW=1, Total=8tq)
+    // PCLK1 / 8 / BaudRate = Prescaler (PCLK1 = 36MHz ʱ 500K -> 9)
+    uint32_t brp = RUN_clock_get()->pclk1 / 8 / baud_rate;
     if(brp > 0) brp = brp - 1; // Ĵֵ = ʵֵ - 1
     
     CAN1->BTR = 0;
@@ -165,6 +166,8 @@ uint8_t RUN_can_send_msg(CAN_PIN_enum can_pin, uint32 id, uint8* msg, uint8 len)
     uint8_t mbox;
     uint16_t timeout = 0;
 
+    (void)can_pin;  // ֻ CAN1ֻڳʼʱõ
+
     // 1. Ѱҿ
     if ((CAN1->TSR & CAN_TSR_TME0) == CAN_TSR_TME0) mbox = 0;
     else if ((CAN1->TSR & CAN_TSR_TME1) == CAN_TSR_TME1) mbox = 1;
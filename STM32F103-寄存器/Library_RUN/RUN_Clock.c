@@ -0,0 +1,272 @@
+#include "RUN_Clock.h"
+
+// ==============================================================================
+// ȫֱ
+// ==============================================================================
+
+static RUN_clock_t clock_cache;         // sysclk == 0 ʾδȡ
+
+// Ƶ (Ϊ RCC->CFGR жӦֶεֵ)
+static const uint16_t clock_ahb_div[16] = {1, 1, 1, 1, 1, 1, 1, 1, 2, 4, 8, 16, 64, 128, 256, 512};
+static const uint8_t  clock_apb_div[8]  = {1, 1, 1, 1, 2, 4, 8, 16};
+static const uint8_t  clock_adc_div[4]  = {2, 4, 6, 8};
+
+// ӱ
+static RUN_clock_hook_t clock_hooks[RUN_CLOCK_HOOK_MAX];
+static uint8_t          clock_hook_num = 0;
+
+// DWT ڼ ( CMSIS 汾 core_cm3.h û DWT ṹ嶨)
+#define CLOCK_DWT_CTRL      (*(volatile uint32_t*)0xE0001000)
+#define CLOCK_DWT_CYCCNT    (*(volatile uint32_t*)0xE0001004)
+
+// ==============================================================================
+// ڲ
+// ==============================================================================
+
+//-------------------------------------------------------------------------------------------------------------------
+// ڲHCLK  -> 
+//-------------------------------------------------------------------------------------------------------------------
+static uint32_t clock_cycles_ns(uint32_t cycles, uint32_t hclk)
+{
+    return (uint32_t)((uint64_t)cycles * 1000000000u / hclk);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// ڲȴ RCC->CR еľλ (ʱͬ SystemInit  HSE_STARTUP_TIMEOUT)
+//-------------------------------------------------------------------------------------------------------------------
+static uint8_t clock_wait_ready(uint32_t rdy_bit)
+{
+    uint32_t n = 0;
+    while (!(RCC->CR & rdy_bit))
+    {
+        if (++n > HSE_STARTUP_TIMEOUT) return 0;
+    }
+    return 1;
+}
+
+// ==============================================================================
+// ӿں
+// ==============================================================================
+
+//-------------------------------------------------------------------------------------------------------------------
+//       ¶ȡʱ
+// ˵      void
+// ز      const RUN_clock_t*  ʱƵ
+// ʹʾ      RCC->CFGR = ...;             // Լ˷Ƶ
+//               RUN_clock_update();
+// עϢ       SWS (ʵЧʱԴ) 㣬 SW (ʱԴ)
+//-------------------------------------------------------------------------------------------------------------------
+const RUN_clock_t* RUN_clock_update(void)
+{
+    uint32_t cfgr = RCC->CFGR;
+    uint32_t sys;
+
+    // 1. SYSCLK
+    switch (cfgr & RCC_CFGR_SWS)
+    {
+        case RCC_CFGR_SWS_HSE:
+            sys = HSE_VALUE;
+            break;
+        case RCC_CFGR_SWS_PLL:
+        {
+            uint32_t mul = ((cfgr & RCC_CFGR_PLLMULL) >> 18) + 2;
+            uint32_t src;
+
+            if (mul > 16) mul = 16;
+            if (!(cfgr & RCC_CFGR_PLLSRC))        src = HSI_VALUE / 2;
+            else if (cfgr & RCC_CFGR_PLLXTPRE)    src = HSE_VALUE / 2;
+            else                                  src = HSE_VALUE;
+            sys = src * mul;
+            break;
+        }
+        default:
+            sys = HSI_VALUE;
+            break;
+    }
+
+    // 2. ߷Ƶ
+    clock_cache.sysclk      = sys;
+    clock_cache.hclk        = sys / clock_ahb_div[(cfgr & RCC_CFGR_HPRE) >> 4];
+    clock_cache.pclk1       = clock_cache.hclk / clock_apb_div[(cfgr & RCC_CFGR_PPRE1) >> 8];
+    clock_cache.pclk2       = clock_cache.hclk / clock_apb_div[(cfgr & RCC_CFGR_PPRE2) >> 11];
+
+    // 3. ʱʱӣAPB ƵΪ 1 ʱʱʱ PCLK  2 
+    clock_cache.apb1_timclk = clock_cache.pclk1 * ((clock_cache.pclk1 == clock_cache.hclk) ? 1 : 2);
+    clock_cache.apb2_timclk = clock_cache.pclk2 * ((clock_cache.pclk2 == clock_cache.hclk) ? 1 : 2);
+    clock_cache.adcclk      = clock_cache.pclk2 / clock_adc_div[(cfgr & RCC_CFGR_ADCPRE) >> 14];
+
+    SystemCoreClock = clock_cache.hclk;
+    return &clock_cache;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       ȡʱƵ
+// ˵      void
+// ز      const RUN_clock_t*  ʱƵ
+// ʹʾ      uint32_t brr = RUN_clock_get()->pclk2 / 115200;
+//-------------------------------------------------------------------------------------------------------------------
+const RUN_clock_t* RUN_clock_get(void)
+{
+    if (clock_cache.sysclk == 0) RUN_clock_update();
+    return &clock_cache;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       ȡ APB ʱ
+// ˵      is_apb2         1: APB2 (PCLK2)  0: APB1 (PCLK1)
+// ز      uint32_t        Ƶ (Hz)
+//-------------------------------------------------------------------------------------------------------------------
+uint32_t RUN_clock_pclk(uint8_t is_apb2)
+{
+    const RUN_clock_t* clk = RUN_clock_get();
+    return is_apb2 ? clk->pclk2 : clk->pclk1;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       ȡʱʱ
+// ˵      is_apb2         1: TIM1/TIM8  0: TIM2~TIM7
+// ز      uint32_t        Ƶ (Hz)
+//-------------------------------------------------------------------------------------------------------------------
+uint32_t RUN_clock_timer(uint8_t is_apb2)
+{
+    const RUN_clock_t* clk = RUN_clock_get();
+    return is_apb2 ? clk->apb2_timclk : clk->apb1_timclk;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       ǼʱӸı乳
+// ˵      hook            Ӻ
+// ز      uint8_t         1: ɹ (ѵǼǹ)  0: ӱ
+// ʹʾ      RUN_clock_hook_add(uart_clock_hook);    // ʼʱ
+// עϢ       RUN_clock_set ڹжִУǼ˳
+//-------------------------------------------------------------------------------------------------------------------
+uint8_t RUN_clock_hook_add(RUN_clock_hook_t hook)
+{
+    uint8_t i;
+
+    for (i = 0; i < clock_hook_num; i++)
+    {
+        if (clock_hooks[i] == hook) return 1;
+    }
+    if (clock_hook_num >= RUN_CLOCK_HOOK_MAX) return 0;
+    clock_hooks[clock_hook_num++] = hook;
+    return 1;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       лƵ
+// ˵      mode            RUN_CLOCK_HSI_8M / RUN_CLOCK_PLL_72M
+// ˵      latency         ׶κʱ (Ϊ NULL)
+// ز      uint8_t         1: ɹ  0: HSE ʧܣʱӲ
+// ʹʾ      RUN_clock_latency_t lat;
+//               RUN_clock_set(RUN_CLOCK_PLL_72M, &lat);    // ͻǰƵ
+//               ...
+//               RUN_clock_set(RUN_CLOCK_HSI_8M, NULL);     // ʱƵ
+// עϢ      1. ˳ѭοֲ᣺Ƶǰȼ Flash ȴڣƵټ
+//               2.  HSE / PLL ʱж (ʵоƬ HSE Լ 1~2msҪʱ)
+//                   SW ִʱжϣжϷ򿴵һһɵķƵ
+//               3. շĴ / SPI ֽڻͻڴ϶
+//-------------------------------------------------------------------------------------------------------------------
+uint8_t RUN_clock_set(RUN_clock_mode_t mode, RUN_clock_latency_t* latency)
+{
+    RUN_clock_t old_clk = *RUN_clock_get();
+    uint32_t    t0, t1, t2, t3;
+    uint32_t    primask;
+    uint8_t     i;
+
+    if (latency) latency->osc_ns = latency->switch_ns = latency->retime_ns = 0;
+
+    // 0. ѾĿ굵λֱӷ
+    if (mode == RUN_CLOCK_PLL_72M)
+    {
+        if (old_clk.hclk == 72000000 && old_clk.pclk1 == 36000000 && old_clk.pclk2 == 72000000) return 1;
+    }
+    else
+    {
+        if ((RCC->CFGR & RCC_CFGR_SWS) == RCC_CFGR_SWS_HSI && old_clk.pclk1 == HSI_VALUE && old_clk.pclk2 == HSI_VALUE) return 1;
+    }
+
+    //  PLL ʱܸ PLLMUL (ûԼ 48MHz)Ȼ HSI
+    if (mode == RUN_CLOCK_PLL_72M && (RCC->CFGR & RCC_CFGR_SWS) == RCC_CFGR_SWS_PLL)
+    {
+        RUN_clock_set(RUN_CLOCK_HSI_8M, 0);
+        old_clk = *RUN_clock_get();
+    }
+
+    //  DWT ڼʱ
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    CLOCK_DWT_CTRL   |= 1;
+    t0 = CLOCK_DWT_CYCCNT;
+
+    if (mode == RUN_CLOCK_PLL_72M)
+    {
+        // 1. HSE PLL = HSE x9 ȴ
+        RCC->CR |= RCC_CR_HSEON;
+        if (!clock_wait_ready(RCC_CR_HSERDY))
+        {
+            RCC->CR &= ~RCC_CR_HSEON;
+            return 0;
+        }
+        RCC->CR &= ~RCC_CR_PLLON;
+        RCC->CFGR = (RCC->CFGR & ~(RCC_CFGR_PLLSRC | RCC_CFGR_PLLXTPRE | RCC_CFGR_PLLMULL))
+                  | RCC_CFGR_PLLSRC_HSE | RCC_CFGR_PLLMULL9;
+        RCC->CR |= RCC_CR_PLLON;
+        if (!clock_wait_ready(RCC_CR_PLLRDY))
+        {
+            RCC->CR &= ~(RCC_CR_PLLON | RCC_CR_HSEON);
+            return 0;
+        }
+
+        // 2. 48MHz < SYSCLK <= 72MHz Ҫ 2 ȴڣƵǰ
+        FLASH->ACR = (FLASH->ACR & ~FLASH_ACR_LATENCY) | FLASH_ACR_PRFTBE | FLASH_ACR_LATENCY_2;
+    }
+    else
+    {
+        RCC->CR |= RCC_CR_HSION;
+        clock_wait_ready(RCC_CR_HSIRDY);
+    }
+    t1 = CLOCK_DWT_CYCCNT;
+
+    // 3. жл SWAPB1 ܳ 36MHz
+    primask = __get_PRIMASK();
+    __set_PRIMASK(1);
+
+    if (mode == RUN_CLOCK_PLL_72M)
+    {
+        RCC->CFGR = (RCC->CFGR & ~(RCC_CFGR_HPRE | RCC_CFGR_PPRE1 | RCC_CFGR_PPRE2 | RCC_CFGR_SW))
+                  | RCC_CFGR_HPRE_DIV1 | RCC_CFGR_PPRE1_DIV2 | RCC_CFGR_PPRE2_DIV1 | RCC_CFGR_SW_PLL;
+        while ((RCC->CFGR & RCC_CFGR_SWS) != RCC_CFGR_SWS_PLL);
+    }
+    else
+    {
+        RCC->CFGR = (RCC->CFGR & ~(RCC_CFGR_HPRE | RCC_CFGR_PPRE1 | RCC_CFGR_PPRE2 | RCC_CFGR_SW))
+                  | RCC_CFGR_HPRE_DIV1 | RCC_CFGR_PPRE1_DIV1 | RCC_CFGR_PPRE2_DIV1 | RCC_CFGR_SW_HSI;
+        while ((RCC->CFGR & RCC_CFGR_SWS) != RCC_CFGR_SWS_HSI);
+    }
+    t2 = CLOCK_DWT_CYCCNT;
+
+    // 4. ֪ͨʱ
+    RUN_clock_update();
+    for (i = 0; i < clock_hook_num; i++)
+    {
+        clock_hooks[i](&old_clk, &clock_cache);
+    }
+    t3 = CLOCK_DWT_CYCCNT;
+
+    __set_PRIMASK(primask);
+
+    // 5. Ƶص PLL / HSEFlash ȴڼ 0
+    if (mode == RUN_CLOCK_HSI_8M)
+    {
+        RCC->CR &= ~(RCC_CR_PLLON | RCC_CR_HSEON);
+        FLASH->ACR = (FLASH->ACR & ~FLASH_ACR_LATENCY) | FLASH_ACR_PRFTBE;
+    }
+
+    if (latency)
+    {
+        latency->osc_ns    = clock_cycles_ns(t1 - t0, old_clk.hclk);
+        latency->switch_ns = clock_cycles_ns(t2 - t1, old_clk.hclk);
+        latency->retime_ns = clock_cycles_ns(t3 - t2, clock_cache.hclk);
+    }
+    return 1;
+}
@@ -0,0 +1,78 @@
+#ifndef _RUN_CLOCK_H_
+#define _RUN_CLOCK_H_
+
+#include "stm32f10x.h"
+
+// ==========================================================
+// ʱ
+// ----------------------------------------------------------
+//  RCC Ĵʵʵʱãݴ˼Ƶ (д 72MHz)
+//   SYSCLK -> /HPRE -> HCLK -> /PPRE1 -> PCLK1 (APB1 )   TIM2~7 = PCLK1 x (PPRE1 == 1 ? 1 : 2)
+//                           -> /PPRE2 -> PCLK2 (APB2 )   TIM1/8 = PCLK2 x (PPRE2 == 1 ? 1 : 2)
+//                                                            ADCCLK = PCLK2 / ADCPRE
+//  RUN_clock_get() иĹ RCC  RUN_clock_update() ˢ
+//
+// лƵ (RUN_clock_set)ȴ/PLL ʱжճӦ
+// ֻл SW ֪ͨһιжϣڳʼʱǼǹӣ
+// лͬһεﰴʱ BRR / PSC / ARR / SPI Ƶ / fac_us
+// ==========================================================
+
+#ifndef RUN_CLOCK_HOOK_MAX
+#define RUN_CLOCK_HOOK_MAX  8       // Ǽǵ
+#endif
+
+typedef struct {
+    uint32_t sysclk;        // ϵͳʱ
+    uint32_t hclk;          // AHB (CPUDMASysTick)
+    uint32_t pclk1;         // APB1  (USART2~5CANI2CSPI2/3)
+    uint32_t pclk2;         // APB2  (USART1SPI1ADCGPIO)
+    uint32_t apb1_timclk;   // APB1 ʱ (TIM2~TIM7)
+    uint32_t apb2_timclk;   // APB2 ʱ (TIM1TIM8)
+    uint32_t adcclk;        // ADC
+} RUN_clock_t;
+
+// Ƶλ
+typedef enum {
+    RUN_CLOCK_HSI_8M  = 0,  // HSI 8MHz ֱ SYSCLKPLL / HSE ر (ʡ)
+    RUN_CLOCK_PLL_72M = 1   // HSE 8MHz x9 = 72MHz ( SystemInit ͬPCLK1 = 36MHz)
+} RUN_clock_mode_t;
+
+// һлĺʱ (룬 DWT ڼ)
+typedef struct {
+    uint32_t osc_ns;        // ȴ HSE / PLL  (ж)
+    uint32_t switch_ns;     // л SW ֱ SWS Ч (ж)
+    uint32_t retime_ns;     // ִ (ж)
+} RUN_clock_latency_t;
+
+// ӣʱӸı (жִУҪȴ)
+typedef void (*RUN_clock_hook_t)(const RUN_clock_t* old_clk, const RUN_clock_t* new_clk);
+
+// ==========================================================
+// 
+// ==========================================================
+
+// ¶ȡ RCC » (ͬʱ CMSIS  SystemCoreClock)
+const RUN_clock_t* RUN_clock_update(void);
+
+// ȡʱƵ (״εʱԶȡ)
+const RUN_clock_t* RUN_clock_get(void);
+
+// ȡ / ʱʱ (is_apb2 ñֶͬһ)
+uint32_t RUN_clock_pclk(uint8_t is_apb2);
+uint32_t RUN_clock_timer(uint8_t is_apb2);
+
+/**
+ * @brief  ǼʱӸı乳 (ظǼͬһֻһ)
+ * @return 1: ɹ  0: ӱ
+ */
+uint8_t RUN_clock_hook_add(RUN_clock_hook_t hook);
+
+/**
+ * @brief  лƵ֪ͨѵǼǵƵ
+ * @param  mode:    Ŀ굵λ
+ * @param  latency: ظ׶κʱ (Ϊ NULL)
+ * @return 1: ɹ  0: HSE ʧ (ԭʱӲ)
+ */
+uint8_t RUN_clock_set(RUN_clock_mode_t mode, RUN_clock_latency_t* latency);
+
+#endif
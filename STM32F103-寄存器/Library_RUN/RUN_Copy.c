@@ -0,0 +1,294 @@
+#include "RUN_Copy.h"
+
+//
+// ͨ·DMA  M2M ģʽ° CPAR ԴCMAR Ŀģ߶ AHB ߾
+// ÿһλ (ֽ//) һдһΣCPU ֻÿʱһжϡ
+
+// ==============================================================================
+// ȫֱ
+// ==============================================================================
+
+#define COPY_MASK       (RUN_COPY_QUEUE_LEN - 1)
+#define COPY_SPLIT_MAX  8           // memcpy / memset 
+
+// вۣѾɼĴֵжֱд
+typedef struct {
+    uint32_t src;           // CPAR
+    uint32_t dst;           // CMAR
+    uint16_t len;           // CNDTR
+    uint16_t ccr;           // MEM2MEM / PINC / MINC / PSIZE / MSIZE
+    uint32_t value;         // memset ֵ (fill Դָ)
+} copy_slot_t;
+
+static DMA_Channel_TypeDef* copy_ch = 0;
+static uint32_t             copy_ccr_base;      // PL + TCIE + TEIE
+
+static copy_slot_t          copy_queue[RUN_COPY_QUEUE_LEN];
+static volatile uint8_t     copy_head = 0;      // һдλ (ύ)
+static volatile uint8_t     copy_tail = 0;      // ڴ (ж)
+static volatile uint32_t    copy_submitted = 0; // ۼӵ = µդ
+static volatile uint32_t    copy_completed = 0; // ۼɵ
+static volatile uint32_t    copy_error = 0;
+
+// ==============================================================================
+// ڲ
+// ==============================================================================
+
+//-------------------------------------------------------------------------------------------------------------------
+// ڲѶвдͨ
+//-------------------------------------------------------------------------------------------------------------------
+static void copy_start(const copy_slot_t* slot)
+{
+    copy_ch->CCR   = copy_ccr_base;             // EN = 0 ܸ CPAR / CMAR / CNDTR
+    copy_ch->CPAR  = slot->src;
+    copy_ch->CMAR  = slot->dst;
+    copy_ch->CNDTR = slot->len;
+    copy_ch->CCR   = copy_ccr_base | slot->ccr | DMA_CCR1_EN;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// ڲDMA жϻصһһ
+//-------------------------------------------------------------------------------------------------------------------
+static void copy_dma_callback(uint8_t flags, void* ctx)
+{
+    uint8_t tail = (uint8_t)((copy_tail + 1) & COPY_MASK);
+    (void)ctx;
+
+    if (flags & RUN_DMA_IT_TE) copy_error++;    // Ӱ
+
+    copy_tail = tail;
+    copy_completed++;
+
+    if (tail != copy_head) copy_start(&copy_queue[tail]);
+    else                   copy_ch->CCR = copy_ccr_base;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// ڲ
+// ˵      value           Ϊ NULL ʱ fill ԴΪвԴֵ
+//-------------------------------------------------------------------------------------------------------------------
+static uint32_t copy_enqueue(const RUN_copy_desc_t* list, uint8_t num, const uint32_t* value)
+{
+    uint32_t primask, fence;
+    uint8_t  i, head, idle;
+
+    if (copy_ch == 0 || list == 0 || num == 0 || num >= RUN_COPY_QUEUE_LEN) return 0;
+
+    // 1.  (ȡ롢)
+    for (i = 0; i < num; i++)
+    {
+        uint32_t align = (1u << list[i].width) - 1;
+        if (list[i].width > RUN_DMA_WIDTH_32BIT || list[i].len == 0) return 0;
+        if (((uint32_t)list[i].dst & align) || (value == 0 && ((uint32_t)list[i].src & align))) return 0;
+    }
+
+    primask = __get_PRIMASK();
+    __set_PRIMASK(1);
+
+    // 2. ռ䲻˻
+    if (((copy_head - copy_tail) & COPY_MASK) + num > COPY_MASK)
+    {
+        __set_PRIMASK(primask);
+        return 0;
+    }
+
+    idle = (copy_head == copy_tail);
+    head = copy_head;
+    for (i = 0; i < num; i++)
+    {
+        copy_slot_t* slot = &copy_queue[head];
+        uint32_t     w    = list[i].width;
+
+        slot->dst = (uint32_t)list[i].dst;
+        slot->len = list[i].len;
+        slot->ccr = (uint16_t)(DMA_CCR1_MEM2MEM | DMA_CCR1_MINC | (w << 8) | (w << 10));
+        if (!list[i].fill)  slot->ccr |= DMA_CCR1_PINC;
+        if (list[i].fill && value)
+        {
+            slot->value = *value;
+            slot->src   = (uint32_t)&slot->value;
+        }
+        else slot->src = (uint32_t)list[i].src;
+
+        head = (uint8_t)((head + 1) & COPY_MASK);
+    }
+    copy_head       = head;
+    copy_submitted += num;
+    fence           = copy_submitted;
+
+    // 3. о̿ʼ TC жϽ
+    if (idle) copy_start(&copy_queue[(head - num) & COPY_MASK]);
+
+    __set_PRIMASK(primask);
+    return fence;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// ڲһֽڿ / 
+// ˵      value           NULL:    NULL: 
+// עϢ      DMA ݿͬ¶룬ֻ src  dst λ뷽ʽͬʱְ᣻
+//               ֽڲ dstм䰴 () ᣬʣµβֽٰ
+//-------------------------------------------------------------------------------------------------------------------
+static uint32_t copy_split(uint32_t d, uint32_t s, uint32_t bytes, const uint32_t* value)
+{
+    RUN_copy_desc_t list[COPY_SPLIT_MAX];
+    uint32_t        unit, head, body;
+    uint8_t         w, n = 0;
+
+    if (bytes == 0) return 0;
+
+    if (value || ((d ^ s) & 3) == 0) w = RUN_DMA_WIDTH_32BIT;
+    else if (((d ^ s) & 1) == 0)     w = RUN_DMA_WIDTH_16BIT;
+    else                             w = RUN_DMA_WIDTH_8BIT;
+    unit = 1u << w;
+
+    head = (unit - (d & (unit - 1))) & (unit - 1);
+    if (head > bytes) head = bytes;
+    body = (bytes - head) / unit;
+
+    // 1. ֽͷ
+    if (head)
+    {
+        list[n].src = (const void*)s; list[n].dst = (void*)d; list[n].len = (uint16_t)head;
+        list[n].width = RUN_DMA_WIDTH_8BIT; list[n].fill = (value != 0); n++;
+        d += head; s += head; bytes -= head;
+    }
+
+    // 2. 壬ÿ 65535 λ
+    while (body)
+    {
+        uint32_t len = (body > 0xFFFF) ? 0xFFFF : body;
+        if (n >= COPY_SPLIT_MAX - 1) return 0;
+        list[n].src = (const void*)s; list[n].dst = (void*)d; list[n].len = (uint16_t)len;
+        list[n].width = w; list[n].fill = (value != 0); n++;
+        d += len * unit; s += len * unit; bytes -= len * unit; body -= len;
+    }
+
+    // 3. ֽβ
+    if (bytes)
+    {
+        list[n].src = (const void*)s; list[n].dst = (void*)d; list[n].len = (uint16_t)bytes;
+        list[n].width = RUN_DMA_WIDTH_8BIT; list[n].fill = (value != 0); n++;
+    }
+
+    return copy_enqueue(list, n, value);
+}
+
+// ==============================================================================
+// ӿں
+// ==============================================================================
+
+//-------------------------------------------------------------------------------------------------------------------
+//       ʼ
+// ˵      prio            DMA ͨȼ
+// ز      uint8_t         1: ɹ  0: ûп DMA ͨ
+// ʹʾ      RUN_copy_init(RUN_DMA_PRIO_LOW);
+// עϢ      1. ͨ RUN_DMA_Alloc(RUN_DMA_REQ_MEM2MEM) 䣬ڸ DMA ֮ٵ
+//               2. M2M һֱռٲãȼһЩ / ADC ܲ
+//-------------------------------------------------------------------------------------------------------------------
+uint8_t RUN_copy_init(RUN_DMA_Priority_t prio)
+{
+    if (copy_ch == 0)
+    {
+        copy_ch = RUN_DMA_Alloc(RUN_DMA_REQ_MEM2MEM);
+        if (copy_ch == 0) return 0;
+    }
+
+    RUN_DMA_SetPriority(copy_ch, prio);
+    RUN_DMA_Config(copy_ch, 0, 0, 0, RUN_DMA_DIR_M2M, RUN_DMA_WIDTH_32BIT, RUN_DMA_MODE_NORMAL);
+    RUN_DMA_SetCallback(copy_ch, RUN_DMA_IT_TC | RUN_DMA_IT_TE, copy_dma_callback, 0, 1, 0);
+    copy_ccr_base = copy_ch->CCR & (DMA_CCR1_PL | DMA_CCR1_TCIE | DMA_CCR1_TEIE);
+    copy_ch->CCR  = copy_ccr_base;
+
+    copy_head = copy_tail = 0;
+    copy_completed = copy_submitted;
+    copy_error = 0;
+    return 1;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       ύһ
+// ˵      list             (ݻᱻƣغ󼴿)
+// ˵      num              (1 ~ RUN_COPY_QUEUE_LEN-1)
+// ز      uint32_t        դţ0 ʾû
+// ʹʾ      //  4  40 ƴ֡Ĳͬλ
+//               RUN_copy_desc_t rows[4];
+//               for (i = 0; i < 4; i++) {
+//                   rows[i].src = line[i]; rows[i].dst = &fb[(y + i) * 320 + x];
+//                   rows[i].len = 40; rows[i].width = RUN_DMA_WIDTH_16BIT; rows[i].fill = 0;
+//               }
+//               fence = RUN_copy_submit(rows, 4);
+// עϢ      же
+//-------------------------------------------------------------------------------------------------------------------
+uint32_t RUN_copy_submit(const RUN_copy_desc_t* list, uint8_t num)
+{
+    return copy_enqueue(list, num, 0);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       첽 memcpy
+// ˵      dst / src       Ŀ / Դ (ǰ src ܸġdst ܶ)
+// ˵      bytes           ֽ
+// ز      uint32_t        դţ0 ʾʧ
+// ʹʾ      uint32_t f = RUN_copy_memcpy(block_out, block_in, sizeof(block_in));
+//               control_loop();                     // DMA ʱ CPU 
+//               RUN_copy_wait(f);
+// עϢ      src  dst ַ 2 λְͬܰ᣻ 1 λֻֽͬڰᣬ CPU 
+//-------------------------------------------------------------------------------------------------------------------
+uint32_t RUN_copy_memcpy(void* dst, const void* src, uint32_t bytes)
+{
+    return copy_split((uint32_t)dst, (uint32_t)src, bytes, 0);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       첽 memset
+// ˵      dst             Ŀĵַ
+// ˵      value           ֽ
+// ˵      bytes           ֽ
+// ز      uint32_t        դţ0 ʾʧ
+// ʹʾ      RUN_copy_memset(fb, 0, sizeof(fb));   // ֡
+// עϢ      ֵڶв÷غҪ
+//-------------------------------------------------------------------------------------------------------------------
+uint32_t RUN_copy_memset(void* dst, uint8_t value, uint32_t bytes)
+{
+    uint32_t word = value * 0x01010101u;
+    return copy_split((uint32_t)dst, 0, bytes, &word);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       ѯդǷ
+// ˵      fence           RUN_copy_submit / memcpy / memset ķֵ
+// ز      uint8_t         1: μ֮ǰύ  0: ڰ
+//-------------------------------------------------------------------------------------------------------------------
+uint8_t RUN_copy_done(uint32_t fence)
+{
+    return (int32_t)(copy_completed - fence) >= 0;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       ȴդ
+// ˵      fence           դ
+// ز      void
+//-------------------------------------------------------------------------------------------------------------------
+void RUN_copy_wait(uint32_t fence)
+{
+    while (!RUN_copy_done(fence));
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       Ƿδɵ
+// ز      uint8_t         1: æ  0: 
+//-------------------------------------------------------------------------------------------------------------------
+uint8_t RUN_copy_busy(void)
+{
+    return copy_head != copy_tail;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       ȡ
+// ز      uint32_t        
+//-------------------------------------------------------------------------------------------------------------------
+uint32_t RUN_copy_errors(void)
+{
+    return copy_error;
+}
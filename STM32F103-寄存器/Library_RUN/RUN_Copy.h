@@ -0,0 +1,89 @@
+#ifndef _RUN_COPY_H_
+#define _RUN_COPY_H_
+
+#include "stm32f10x.h"
+#include "RUN_DMA.h"
+
+// ==========================================================
+// DMA 첽 / 
+// ----------------------------------------------------------
+// ռһ洢洢 DMA ͨ (src, dst, len, width) ųɶУ
+// ÿδ (TC ж) ʱֱӸдͨĴŰһ  ɢ (scatter-gather)
+// Դַ (memset)
+// ÿύһդ (fence)RUN_copy_done / RUN_copy_wait жύ֮ǰǷɡ
+//
+// DMA  CPU Ա (HCLK ڣHost/bench/bench_copy.cmake -C Host bench)жģͣ
+//   DMA : M2M 䰴ÿλ 4  HCLK ģļĴʡTC жϺͲο
+//   CPU :  Cortex-M3 ָʱ (ȴ SRAMLDM/STM 8 һ飬src/dst λʱ÷Ƕ LDR)
+//  src/dst ַ 2 λֶ 0/0λͬ 1/1 (ֽͷβ + ) 2/0ֽ 1/0
+// ϰ DWT CYCCNT ʵ⡣
+//
+//   ֽ      ֶ DMA/CPU    λͬ DMA/CPU     DMA/CPU      ֽ DMA/CPU
+//        4          50 / 30          102 / 51           54 / 31           62 / 31
+//       64         110 / 67          194 / 122         174 / 151         302 / 151
+//     1024        1070 / 727        1154 / 782        2094 / 2071       4142 / 2071
+//    65536       65582 / 45079     65665 / 45134    131117 / 131095   262227 / 131095
+//
+//   * DMA κγߴ硢κζ¶ CPU  (ֶԼ 1.45 )
+//     Ĳٶȣǰڼ CPU ճ
+//   * DMA ·ռ CPU Լ 45  (ύ + TC жϣλͬ 3 ʱԼ 130)
+//     ֶ 32 ֽ CPU ֱӿڻûô࣬ DMA ռ CPU
+//   * ֽͬ° / ֽڰ˵ DMA ʱԼΪֶ 2  / 4 
+//     CPU ÷Ƕ LDR ƣֶ CPU бҪ
+// ==========================================================
+
+#ifndef RUN_COPY_QUEUE_LEN
+#define RUN_COPY_QUEUE_LEN  16      // г ( 2 )
+#endif
+
+// 
+typedef struct {
+    const void* src;        // Դַ (fill = 1 ʱֵָǰܸ)
+    void*       dst;        // Ŀĵַ
+    uint16_t    len;        // λ ( width ƣ1 ~ 65535)
+    uint8_t     width;      // RUN_DMA_Width_tsrc / dst 밴
+    uint8_t     fill;       // 1: Դַ ()
+} RUN_copy_desc_t;
+
+// ==========================================================
+// 
+// ==========================================================
+
+/**
+ * @brief  ʼ (һ DMA ͨ)
+ * @param  prio: ͨȼһ RUN_DMA_PRIO_LOW
+ * @return 1: ɹ  0: ûп DMA ͨ
+ */
+uint8_t RUN_copy_init(RUN_DMA_Priority_t prio);
+
+/**
+ * @brief  ύһ (һӣ˳ִ)
+ * @return դţ0 ʾпռ䲻 / δʼ /  (鶼û)
+ */
+uint32_t RUN_copy_submit(const RUN_copy_desc_t* list, uint8_t num);
+
+/**
+ * @brief  첽 memcpyԶ ֽͷ + / + ֽβ
+ * @return դţ0 ʾʧ
+ */
+uint32_t RUN_copy_memcpy(void* dst, const void* src, uint32_t bytes);
+
+/**
+ * @brief  첽 memset
+ * @return դţ0 ʾʧ
+ */
+uint32_t RUN_copy_memset(void* dst, uint8_t value, uint32_t bytes);
+
+// դŶӦύ (֮ǰύ) Ƿ
+uint8_t RUN_copy_done(uint32_t fence);
+
+// ȴդ
+void RUN_copy_wait(uint32_t fence);
+
+// Ƿδɵ
+uint8_t RUN_copy_busy(void);
+
+//  (TE)
+uint32_t RUN_copy_errors(void);
+
+#endif
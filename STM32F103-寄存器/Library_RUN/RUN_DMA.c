@@ -6,6 +6,60 @@
 // û CPU Ԥ£ <->ڴ  ڴ<->ڴ ٰ֮ݡ
 // ͷ CPU ʹרע߼㡣
 
+// ==============================================================================
+// ͨ
+// ==============================================================================
+
+// ͨţDMA1 ͨ 1~7 -> 0~6DMA2 ͨ 1~5 -> 7~11
+#define DMA_CH_NUM  12
+
+typedef struct {
+    RUN_DMA_Callback_t callback;
+    void*              ctx;
+} dma_cb_t;
+
+static dma_cb_t dma_callbacks[DMA_CH_NUM] = {0};
+
+static DMA_Channel_TypeDef* const dma_channels[DMA_CH_NUM] = {
+    DMA1_Channel1, DMA1_Channel2, DMA1_Channel3, DMA1_Channel4, DMA1_Channel5, DMA1_Channel6, DMA1_Channel7,
+    DMA2_Channel1, DMA2_Channel2, DMA2_Channel3, DMA2_Channel4, DMA2_Channel5
+};
+
+// ÿͨĵһ (RUN_DMA_Req_t ͨ˳Уͨ = һ <= )
+static const uint8_t dma_req_first[DMA_CH_NUM] = {
+    RUN_DMA_REQ_ADC1,     RUN_DMA_REQ_SPI1_RX,  RUN_DMA_REQ_SPI1_TX,  RUN_DMA_REQ_SPI2_RX,
+    RUN_DMA_REQ_SPI2_TX,  RUN_DMA_REQ_USART2_RX, RUN_DMA_REQ_USART2_TX,
+    RUN_DMA_REQ_SPI3_RX,  RUN_DMA_REQ_SPI3_TX,  RUN_DMA_REQ_UART4_RX, RUN_DMA_REQ_SDIO,     RUN_DMA_REQ_ADC3
+};
+
+static uint8_t dma_owner[DMA_CH_NUM] = {0};     // ռ RUN_DMA_Req_t + 10 = 
+static uint8_t dma_prio[DMA_CH_NUM]  = {        // ȼĬ High (ԭ̶ PL_1 һ)
+    RUN_DMA_PRIO_HIGH, RUN_DMA_PRIO_HIGH, RUN_DMA_PRIO_HIGH, RUN_DMA_PRIO_HIGH, RUN_DMA_PRIO_HIGH, RUN_DMA_PRIO_HIGH,
+    RUN_DMA_PRIO_HIGH, RUN_DMA_PRIO_HIGH, RUN_DMA_PRIO_HIGH, RUN_DMA_PRIO_HIGH, RUN_DMA_PRIO_HIGH, RUN_DMA_PRIO_HIGH
+};
+
+static const IRQn_Type dma_irqn[DMA_CH_NUM] = {
+    DMA1_Channel1_IRQn, DMA1_Channel2_IRQn, DMA1_Channel3_IRQn, DMA1_Channel4_IRQn,
+    DMA1_Channel5_IRQn, DMA1_Channel6_IRQn, DMA1_Channel7_IRQn,
+    DMA2_Channel1_IRQn, DMA2_Channel2_IRQn, DMA2_Channel3_IRQn,
+    DMA2_Channel4_5_IRQn, DMA2_Channel4_5_IRQn
+};
+
+//-------------------------------------------------------------------------------------------------------------------
+// ڲָͨ ->  (Ƿ -1)
+// ͨĴ 0x14ֱɵַ
+//-------------------------------------------------------------------------------------------------------------------
+static int8_t dma_channel_index(DMA_Channel_TypeDef* DMAy_Channelx)
+{
+    uint32_t addr = (uint32_t)DMAy_Channelx;
+
+    if (addr >= DMA1_Channel1_BASE && addr <= DMA1_Channel7_BASE)
+        return (int8_t)((addr - DMA1_Channel1_BASE) / 0x14);
+    if (addr >= DMA2_Channel1_BASE && addr <= DMA2_Channel5_BASE)
+        return (int8_t)(7 + (addr - DMA2_Channel1_BASE) / 0x14);
+    return -1;
+}
+
 // ==============================================================================
 // ú
 // ==============================================================================
@@ -30,13 +84,14 @@ void RUN_DMA_Config(DMA_Channel_TypeDef* DMAy_Channelx,
 {
     // ݴ CCR Ĵֵ
     uint32_t tmpreg = 0;
+    int8_t   idx    = dma_channel_index(DMAy_Channelx);
+    if (idx < 0) return;
 
     // 1.  DMA ʱ
-    // ֱӲ RCC  AHBENR Ĵ
-    // Ϊ˱߼һ£ͬʱ DMA1  DMA2 ʱ (оƬ֧)
-    RCC->AHBENR |= RCC_AHBENR_DMA1EN;
+    // ֱӲ RCC  AHBENR ĴֻͨڵǸ
+    if (idx < 7) RCC->AHBENR |= RCC_AHBENR_DMA1EN;
 #ifdef RCC_AHBENR_DMA2EN
-    RCC->AHBENR |= RCC_AHBENR_DMA2EN;
+    else         RCC->AHBENR |= RCC_AHBENR_DMA2EN;
 #endif
 
     // 2. λͨ & ʧ
@@ -50,9 +105,9 @@ void RUN_DMA_Config(DMA_Channel_TypeDef* DMAy_Channelx,
     DMAy_Channelx->CMAR  = 0;
     
     // ܴͨڵĹжϱ־ (GIF, TCIF, HTIF, TEIF)
-    // ע⣺DMA1  DMA2 жϱ־Ĵַͬ
-    // ΪͨԣݲִȫʹǰӲλ״̬
-    // (ڱ׼ĴУý׶ͨҪ־λǿж)
+    // һδµ TCIF  RUN_DMA_SetCallback һжϾͻ
+    if (idx < 7) DMA1->IFCR = 0x0Fu << (idx * 4);
+    else         DMA2->IFCR = 0x0Fu << ((idx - 7) * 4);
 
     // 3. ַ
     // CPAR: ַĴ
@@ -128,8 +183,8 @@ void RUN_DMA_Config(DMA_Channel_TypeDef* DMAy_Channelx,
 
     // 7. ȼ
     // PL (Bit 13:12): 00=Low, 01=Medium, 10=High, 11=VeryHigh
-    // Ϊ High (10)
-    tmpreg |= DMA_CCR1_PL_1; // PL_1 Ӧ Bit 13  1
+    // Ĭ High (10) RUN_DMA_SetPriority ޸
+    tmpreg |= (uint32_t)dma_prio[idx] << 12;
     
     // 8. дĴ
     // úõֵд CCRעʱ EN λ 0 (δ)
@@ -182,4 +237,234 @@ uint16_t RUN_DMA_GetCurrDataCounter(DMA_Channel_TypeDef* DMAy_Channelx)
 {
     // ֱӶȡ CNDTR Ĵ
     return (uint16_t)(DMAy_Channelx->CNDTR);
-}
\ No newline at end of file
+}
+// ==============================================================================
+// ͨ
+// ==============================================================================
+
+//-------------------------------------------------------------------------------------------------------------------
+//       ѯڵͨ
+// ˵      req             DMA 
+// ز      DMA_Channel_TypeDef*  ָͨ (MEM2MEM Ƿ󷵻 NULL)
+// ʹʾ      DMA_Channel_TypeDef* ch = RUN_DMA_Channel(RUN_DMA_REQ_USART1_TX);   // DMA1_Channel4
+//-------------------------------------------------------------------------------------------------------------------
+DMA_Channel_TypeDef* RUN_DMA_Channel(RUN_DMA_Req_t req)
+{
+    int8_t i;
+
+    if (req >= RUN_DMA_REQ_MEM2MEM) return 0;
+    for (i = DMA_CH_NUM - 1; i > 0 && req < dma_req_first[i]; i--);
+    return dma_channels[i];
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       Ϊͨ
+// ˵      req             DMA 
+// ز      DMA_Channel_TypeDef*  ָͨ룬NULL ʾͻ
+// ʹʾ      la->dma = RUN_DMA_Alloc(RUN_DMA_REQ_TIM6_UP);
+//               if (la->dma == NULL) return 0;      // DMA2_CH3 ѱ UART4_RX ռ
+// עϢ      1. ͬһظ䷵ͬһͨ
+//               2. MEM2MEM  DMA2_CH5  DMA1_CH1 ҿͨ (༯ DMA1)
+//               3. ͻʱ RUN_DMA_Owner(RUN_DMA_Channel(req)) ˭ռ
+//-------------------------------------------------------------------------------------------------------------------
+DMA_Channel_TypeDef* RUN_DMA_Alloc(RUN_DMA_Req_t req)
+{
+    DMA_Channel_TypeDef* ch = 0;
+    uint32_t primask;
+    int8_t   idx;
+
+    if (req >= RUN_DMA_REQ_MAX) return 0;
+
+    primask = __get_PRIMASK();
+    __set_PRIMASK(1);
+
+    if (req == RUN_DMA_REQ_MEM2MEM)
+    {
+        for (idx = DMA_CH_NUM - 1; idx >= 0; idx--)
+        {
+            if (dma_owner[idx] == 0) break;
+        }
+    }
+    else
+    {
+        idx = dma_channel_index(RUN_DMA_Channel(req));
+        if (idx >= 0 && dma_owner[idx] != 0 && dma_owner[idx] != req + 1) idx = -1;
+    }
+
+    if (idx >= 0)
+    {
+        dma_owner[idx] = (uint8_t)(req + 1);
+        ch = dma_channels[idx];
+    }
+
+    __set_PRIMASK(primask);
+    return ch;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       ͷͨ
+// ˵      DMAy_Channelx   DMAͨ
+// ˵      req             ʱõ
+// ز      uint8_t         1: ͷ  0: ͨǱ req ռõ (ʲôҲ)
+// ʹʾ      RUN_DMA_Free(adc_scan_dma, RUN_DMA_REQ_ADC1);
+// עϢ      رͨжʹܣصȼñ
+//-------------------------------------------------------------------------------------------------------------------
+uint8_t RUN_DMA_Free(DMA_Channel_TypeDef* DMAy_Channelx, RUN_DMA_Req_t req)
+{
+    int8_t   idx = dma_channel_index(DMAy_Channelx);
+    uint32_t primask;
+    uint8_t  ok = 0;
+
+    if (idx < 0 || req >= RUN_DMA_REQ_MAX) return 0;
+
+    primask = __get_PRIMASK();
+    __set_PRIMASK(1);
+    if (dma_owner[idx] == req + 1)
+    {
+        DMAy_Channelx->CCR &= ~(uint32_t)(DMA_CCR1_EN | DMA_CCR1_TCIE | DMA_CCR1_HTIE | DMA_CCR1_TEIE);
+        dma_callbacks[idx].callback = 0;
+        dma_callbacks[idx].ctx      = 0;
+        dma_owner[idx] = 0;
+        ok = 1;
+    }
+    __set_PRIMASK(primask);
+    return ok;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       ѯͨռ
+// ˵      DMAy_Channelx   DMAͨ
+// ز      RUN_DMA_Req_t   ռõ󣬿з RUN_DMA_REQ_NONE
+//-------------------------------------------------------------------------------------------------------------------
+RUN_DMA_Req_t RUN_DMA_Owner(DMA_Channel_TypeDef* DMAy_Channelx)
+{
+    int8_t idx = dma_channel_index(DMAy_Channelx);
+    if (idx < 0 || dma_owner[idx] == 0) return RUN_DMA_REQ_NONE;
+    return (RUN_DMA_Req_t)(dma_owner[idx] - 1);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       ͨȼ
+// ˵      DMAy_Channelx   DMAͨ
+// ˵      prio            RUN_DMA_PRIO_LOW ~ RUN_DMA_PRIO_VERY_HIGH
+// ز      void
+// ʹʾ      RUN_DMA_SetPriority(RUN_DMA_Channel(RUN_DMA_REQ_ADC1), RUN_DMA_PRIO_VERY_HIGH);
+// עϢ      1. ٲֻͬһڽУȱ PLͬٱͨ (С)
+//               2. PL ֻͨرʱ޸ģͨڴʱֵ´ RUN_DMA_Config Ч
+//-------------------------------------------------------------------------------------------------------------------
+void RUN_DMA_SetPriority(DMA_Channel_TypeDef* DMAy_Channelx, RUN_DMA_Priority_t prio)
+{
+    int8_t idx = dma_channel_index(DMAy_Channelx);
+    if (idx < 0) return;
+
+    dma_prio[idx] = (uint8_t)(prio & 3);
+    if (!(DMAy_Channelx->CCR & DMA_CCR1_EN))
+        DMAy_Channelx->CCR = (DMAy_Channelx->CCR & ~(uint32_t)DMA_CCR1_PL) | ((uint32_t)dma_prio[idx] << 12);
+}
+
+// ==============================================================================
+// жϻص
+// ==============================================================================
+
+//-------------------------------------------------------------------------------------------------------------------
+//       ע DMA ͨжϻص
+// ˵      DMAy_Channelx   DMAͨ
+// ˵      it_mask         Ҫ¼ (RUN_DMA_IT_TC / RUN_DMA_IT_HT / RUN_DMA_IT_TE )
+// ˵      callback        ص (жִ)
+// ˵      ctx             صģԭ
+// ˵      pre_priority    ռȼ
+// ˵      sub_priority    ȼ
+// ز      void
+// ʹʾ      RUN_DMA_SetCallback(DMA1_Channel1, RUN_DMA_IT_HT | RUN_DMA_IT_TC, adc_block_cb, NULL, 1, 0);
+// עϢ      RUN_DMA_Config  CCRԱҪ֮
+//-------------------------------------------------------------------------------------------------------------------
+void RUN_DMA_SetCallback(DMA_Channel_TypeDef* DMAy_Channelx, uint8_t it_mask,
+                         RUN_DMA_Callback_t callback, void* ctx,
+                         uint8_t pre_priority, uint8_t sub_priority)
+{
+    int8_t idx = dma_channel_index(DMAy_Channelx);
+    if (idx < 0) return;
+
+    it_mask &= (RUN_DMA_IT_TC | RUN_DMA_IT_HT | RUN_DMA_IT_TE);
+
+    dma_callbacks[idx].callback = callback;
+    dma_callbacks[idx].ctx      = ctx;
+
+    // CCR: TCIE(Bit1) / HTIE(Bit2) / TEIE(Bit3)
+    DMAy_Channelx->CCR = (DMAy_Channelx->CCR & ~(uint32_t)(DMA_CCR1_TCIE | DMA_CCR1_HTIE | DMA_CCR1_TEIE)) | it_mask;
+
+    if (it_mask && callback)
+    {
+        uint32_t priority = NVIC_EncodePriority(NVIC_GetPriorityGrouping(), pre_priority, sub_priority);
+        NVIC_SetPriority(dma_irqn[idx], priority);
+        NVIC_EnableIRQ(dma_irqn[idx]);
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       ȡͨ¼־
+// ˵      DMAy_Channelx   DMAͨ
+// ز      uint8_t         RUN_DMA_IT_TC / RUN_DMA_IT_HT / RUN_DMA_IT_TE 
+// עϢ       CCR жʹλӰ죬δжϵ¼Ҳܲ鵽
+//-------------------------------------------------------------------------------------------------------------------
+uint8_t RUN_DMA_GetFlags(DMA_Channel_TypeDef* DMAy_Channelx)
+{
+    int8_t idx = dma_channel_index(DMAy_Channelx);
+    if (idx < 0) return 0;
+
+    if (idx < 7) return (uint8_t)((DMA1->ISR >> (idx * 4)) & 0x0E);
+    return (uint8_t)((DMA2->ISR >> ((idx - 7) * 4)) & 0x0E);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       ͨ¼־
+// ˵      DMAy_Channelx   DMAͨ
+// ˵      flags           Ҫ¼ (RUN_DMA_IT_xx )
+// ز      void
+// עϢ      ȫ¼ GIF Ҳһ
+//-------------------------------------------------------------------------------------------------------------------
+void RUN_DMA_ClearFlags(DMA_Channel_TypeDef* DMAy_Channelx, uint8_t flags)
+{
+    int8_t idx = dma_channel_index(DMAy_Channelx);
+    if (idx < 0) return;
+
+    flags &= 0x0E;
+    if (flags == 0) return;
+    if ((RUN_DMA_GetFlags(DMAy_Channelx) & ~flags) == 0) flags |= 0x01;
+
+    if (idx < 7) DMA1->IFCR = (uint32_t)flags << (idx * 4);
+    else         DMA2->IFCR = (uint32_t)flags << ((idx - 7) * 4);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// ڲжϷַ
+// ISR ÿͨռ 4 λGIF(0) TCIF(1) HTIF(2) TEIF(3)IFCR д 1 
+//-------------------------------------------------------------------------------------------------------------------
+static void RUN_DMA_Handler(DMA_TypeDef* DMAx, DMA_Channel_TypeDef* DMAy_Channelx, uint8_t idx, uint8_t ch)
+{
+    uint8_t shift = ch * 4;
+    uint8_t flags = (uint8_t)((DMAx->ISR >> shift) & 0x0E) & (uint8_t)(DMAy_Channelx->CCR & 0x0E);
+
+    if (flags == 0) return;
+
+    DMAx->IFCR = (uint32_t)(flags | 0x01) << shift;
+    if (dma_callbacks[idx].callback) dma_callbacks[idx].callback(flags, dma_callbacks[idx].ctx);
+}
+
+void DMA1_Channel1_IRQHandler(void) { RUN_DMA_Handler(DMA1, DMA1_Channel1, 0, 0); }
+void DMA1_Channel2_IRQHandler(void) { RUN_DMA_Handler(DMA1, DMA1_Channel2, 1, 1); }
+void DMA1_Channel3_IRQHandler(void) { RUN_DMA_Handler(DMA1, DMA1_Channel3, 2, 2); }
+void DMA1_Channel4_IRQHandler(void) { RUN_DMA_Handler(DMA1, DMA1_Channel4, 3, 3); }
+void DMA1_Channel5_IRQHandler(void) { RUN_DMA_Handler(DMA1, DMA1_Channel5, 4, 4); }
+void DMA1_Channel6_IRQHandler(void) { RUN_DMA_Handler(DMA1, DMA1_Channel6, 5, 5); }
+void DMA1_Channel7_IRQHandler(void) { RUN_DMA_Handler(DMA1, DMA1_Channel7, 6, 6); }
+
+void DMA2_Channel1_IRQHandler(void) { RUN_DMA_Handler(DMA2, DMA2_Channel1, 7, 0); }
+void DMA2_Channel2_IRQHandler(void) { RUN_DMA_Handler(DMA2, DMA2_Channel2, 8, 1); }
+void DMA2_Channel3_IRQHandler(void) { RUN_DMA_Handler(DMA2, DMA2_Channel3, 9, 2); }
+
+void DMA2_Channel4_5_IRQHandler(void)
+{
+    RUN_DMA_Handler(DMA2, DMA2_Channel4, 10, 3);
+    RUN_DMA_Handler(DMA2, DMA2_Channel5, 11, 4);
+}
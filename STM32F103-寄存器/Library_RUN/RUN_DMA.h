@@ -28,6 +28,75 @@ typedef enum {
 } RUN_DMA_Mode_t;
 
 
+// 4. ͨȼ (CCR  PL λͬһȼͬʱͨС)
+typedef enum {
+    RUN_DMA_PRIO_LOW       = 0,
+    RUN_DMA_PRIO_MEDIUM    = 1,
+    RUN_DMA_PRIO_HIGH      = 2, // Ĭ
+    RUN_DMA_PRIO_VERY_HIGH = 3
+} RUN_DMA_Priority_t;
+
+// 5. DMA  (F103 Ʒ DMA ӳͬһеһͨͬһʱֻһ)
+typedef enum {
+    // DMA1 ͨ 1
+    RUN_DMA_REQ_ADC1, RUN_DMA_REQ_TIM2_CH3, RUN_DMA_REQ_TIM4_CH1,
+    // DMA1 ͨ 2
+    RUN_DMA_REQ_SPI1_RX, RUN_DMA_REQ_USART3_TX, RUN_DMA_REQ_TIM1_CH1, RUN_DMA_REQ_TIM2_UP, RUN_DMA_REQ_TIM3_CH3,
+    // DMA1 ͨ 3
+    RUN_DMA_REQ_SPI1_TX, RUN_DMA_REQ_USART3_RX, RUN_DMA_REQ_TIM1_CH2, RUN_DMA_REQ_TIM3_CH4, RUN_DMA_REQ_TIM3_UP,
+    // DMA1 ͨ 4
+    RUN_DMA_REQ_SPI2_RX, RUN_DMA_REQ_USART1_TX, RUN_DMA_REQ_I2C2_TX, RUN_DMA_REQ_TIM1_CH4, RUN_DMA_REQ_TIM1_TRIG, RUN_DMA_REQ_TIM1_COM, RUN_DMA_REQ_TIM4_CH2,
+    // DMA1 ͨ 5
+    RUN_DMA_REQ_SPI2_TX, RUN_DMA_REQ_USART1_RX, RUN_DMA_REQ_I2C2_RX, RUN_DMA_REQ_TIM1_UP, RUN_DMA_REQ_TIM2_CH1, RUN_DMA_REQ_TIM4_CH3,
+    // DMA1 ͨ 6
+    RUN_DMA_REQ_USART2_RX, RUN_DMA_REQ_I2C1_TX, RUN_DMA_REQ_TIM1_CH3, RUN_DMA_REQ_TIM3_CH1, RUN_DMA_REQ_TIM3_TRIG,
+    // DMA1 ͨ 7
+    RUN_DMA_REQ_USART2_TX, RUN_DMA_REQ_I2C1_RX, RUN_DMA_REQ_TIM2_CH2, RUN_DMA_REQ_TIM2_CH4, RUN_DMA_REQ_TIM4_UP,
+    // DMA2 ͨ 1
+    RUN_DMA_REQ_SPI3_RX, RUN_DMA_REQ_TIM5_CH4, RUN_DMA_REQ_TIM5_TRIG, RUN_DMA_REQ_TIM8_CH3, RUN_DMA_REQ_TIM8_UP,
+    // DMA2 ͨ 2
+    RUN_DMA_REQ_SPI3_TX, RUN_DMA_REQ_TIM5_CH3, RUN_DMA_REQ_TIM5_UP, RUN_DMA_REQ_TIM8_CH4, RUN_DMA_REQ_TIM8_TRIG, RUN_DMA_REQ_TIM8_COM,
+    // DMA2 ͨ 3
+    RUN_DMA_REQ_UART4_RX, RUN_DMA_REQ_TIM6_UP, RUN_DMA_REQ_DAC1, RUN_DMA_REQ_TIM8_CH1,
+    // DMA2 ͨ 4
+    RUN_DMA_REQ_SDIO, RUN_DMA_REQ_TIM5_CH2, RUN_DMA_REQ_TIM7_UP, RUN_DMA_REQ_DAC2,
+    // DMA2 ͨ 5
+    RUN_DMA_REQ_ADC3, RUN_DMA_REQ_UART4_TX, RUN_DMA_REQ_TIM5_CH1, RUN_DMA_REQ_TIM8_CH2,
+
+    RUN_DMA_REQ_MEM2MEM,        // 洢洢һͨ
+    RUN_DMA_REQ_MAX,
+    RUN_DMA_REQ_NONE = 0xFF     // ͨ / δ
+} RUN_DMA_Req_t;
+
+
+// =============================================================
+//  ͨ
+// -------------------------------------------------------------
+//  RUN_DMA_Alloc() ֱͨд DMAx_Channely
+// ͨѱռʱ NULLĸͬһĴ
+// ͬһظ뷵ͬһͨ (³ʼͷ)
+// ֱӰָͨ뽻 RUN_DMA_Config Ȼãƹ˳ͻ顣
+// =============================================================
+
+// ڵͨ (䣻MEM2MEM  NULL)
+DMA_Channel_TypeDef* RUN_DMA_Channel(RUN_DMA_Req_t req);
+
+/**
+ * @brief  Ϊͨ
+ * @return ָͨ룻NULL ʾͨѱռ ( MEM2MEM ûпͨ)
+ */
+DMA_Channel_TypeDef* RUN_DMA_Alloc(RUN_DMA_Req_t req);
+
+// ͷͨ (ͬʱرͨжϡص)
+// req ʱһ£ͨ req ʱ 0
+uint8_t RUN_DMA_Free(DMA_Channel_TypeDef* DMAy_Channelx, RUN_DMA_Req_t req);
+
+// ѯͨǰռ (з RUN_DMA_REQ_NONE)
+RUN_DMA_Req_t RUN_DMA_Owner(DMA_Channel_TypeDef* DMAy_Channelx);
+
+// ͨȼд CCR֮ RUN_DMA_Config б
+void RUN_DMA_SetPriority(DMA_Channel_TypeDef* DMAy_Channelx, RUN_DMA_Priority_t prio);
+
 // =============================================================
 //  
 // =============================================================
@@ -59,4 +128,30 @@ void RUN_DMA_Disable(DMA_Channel_TypeDef* DMAy_Channelx);
 // ȡʣ (ڼλ)
 uint16_t RUN_DMA_GetCurrDataCounter(DMA_Channel_TypeDef* DMAy_Channelx);
 
+// =============================================================
+//  жϻص
+// =============================================================
+
+// ж¼ (λ CCR  TCIE/HTIE/TEIEISR ÿͨ TCIF/HTIF/TEIF һ)
+#define RUN_DMA_IT_TC   0x02    // 
+#define RUN_DMA_IT_HT   0x04    // 
+#define RUN_DMA_IT_TE   0x08    // 
+
+// flags: η¼ (RUN_DMA_IT_xx )   ctx: עʱ
+typedef void (*RUN_DMA_Callback_t)(uint8_t flags, void* ctx);
+
+/**
+ * @brief  עͨжϻص򿪶Ӧж
+ * @param  it_mask: Ҫ¼ (RUN_DMA_IT_TC | RUN_DMA_IT_HT ...) RUN_DMA_Config ֮
+ * @param  pre_priority / sub_priority: NVIC ռ/ȼ
+ * ע⣺DMA2 ͨ 4  5 һжֱַ
+ */
+void RUN_DMA_SetCallback(DMA_Channel_TypeDef* DMAy_Channelx, uint8_t it_mask,
+                         RUN_DMA_Callback_t callback, void* ctx,
+                         uint8_t pre_priority, uint8_t sub_priority);
+
+// ȡ / ͨ¼־ (RUN_DMA_IT_xx )ж֮ѯȴ
+uint8_t RUN_DMA_GetFlags(DMA_Channel_TypeDef* DMAy_Channelx);
+void    RUN_DMA_ClearFlags(DMA_Channel_TypeDef* DMAy_Channelx, uint8_t flags);
+
 #endif
\ No newline at end of file
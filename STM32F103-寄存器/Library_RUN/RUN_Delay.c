@@ -10,30 +10,58 @@ static uint8_t fac_us = 0;
 // 
 // ͼչʾ SysTick ĺĽṹһ 24 λ¼ں LOAD(װ)VAL(ǰֵ)CTRL() ҪĴ
 
+// ==============================================================================
+// ڲ
+// ==============================================================================
+
+//-------------------------------------------------------------------------------------------------------------------
+// ڲʱӸı乳ӣ HCLK ѡ SysTick ʱԴ fac_us
+//-------------------------------------------------------------------------------------------------------------------
+static void delay_clock_hook(const RUN_clock_t* old_clk, const RUN_clock_t* new_clk)
+{
+    (void)old_clk;
+    (void)new_clk;
+    RUN_delay_init(0);
+}
+
 // ==============================================================================
 // ʵ
 // ==============================================================================
 
 //-------------------------------------------------------------------------------------------------------------------
 //       SysTick ʱʼ
-// ˵      sysclk_mhz      ϵͳʱƵ (λ: MHz)
-// ˵                       STM32F103 (ZET6/C8T6)ͨ 72
+// ˵      sysclk_mhz      ʹ (Լݾɴ)ʵƵʴ RUN_Clock ȡ
 // ز      void
 // ʹʾ      RUN_delay_init(72); //  main ͷ
-// עϢ       SysTick ʱԴΪ HCLK/8΢뱶
+// עϢ      HCLK Ϊ 8MHz ʱ SysTick ʱԴ HCLK/8 ( 36MHz) ֱ HCLK
+//               ֤ fac_us  RUN_clock_set лƵʱԶ㣬Լ RCC µá
 //-------------------------------------------------------------------------------------------------------------------
 void RUN_delay_init(uint8_t sysclk_mhz)
 {
+    uint32_t hclk = RUN_clock_get()->hclk;
+
+    (void)sysclk_mhz;
+
     // 1.  SysTick ʱԴ
-    // ѡⲿʱԴ (STCLK) HCLK  8 Ƶ
+    // ѡⲿʱԴ (STCLK) HCLK  8 Ƶ
     // ʽSysTick_CLK = 72MHz / 8 = 9MHz
-    SysTick_CLKSourceConfig(SysTick_CLKSource_HCLK_Div8);
+    if ((hclk / 8) % 1000000 == 0)
+    {
+        SysTick_CLKSourceConfig(SysTick_CLKSource_HCLK_Div8);
+        hclk /= 8;
+    }
+    else
+    {
+        SysTick_CLKSourceConfig(SysTick_CLKSource_HCLK);
+    }
 
     // 2.  1us Ҫļֵ (fac_us)
     // Ƶ 9MHz ζ 1  9M 
     // 1us = 1/1,000,000 
     //  = 9,000,000 / 1,000,000 = 9 
-    fac_us = sysclk_mhz / 8;
+    fac_us = (uint8_t)(hclk / 1000000);
+
+    RUN_clock_hook_add(delay_clock_hook);
 }
 
 //-------------------------------------------------------------------------------------------------------------------
@@ -42,7 +70,8 @@ void RUN_delay_init(uint8_t sysclk_mhz)
 // ز      void
 // ʹʾ      RUN_delay_us(50); // ʱ 50us
 // עϢ      ע⡿ LOAD Ĵ 24 λ (ֵ 0xFFFFFF = 16,777,215)
-//                fac_us=9˵ʱֵΪ16777215 / 9  1,864,135 us (Լ 1.86)
+//               72MHz ʱ fac_us=9˵ʱֵΪ16777215 / 9  1,864,135 us (Լ 1.86)
+//               (36MHz ʱ SysTick ֱ HCLKfac_us=36Լ 466ms)
 //               ֵᵼ¼ʱ
 //-------------------------------------------------------------------------------------------------------------------
 void RUN_delay_us(uint32_t nus)
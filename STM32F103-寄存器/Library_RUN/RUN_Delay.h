@@ -24,7 +24,7 @@ typedef uint8_t uint8;
 
 /**
  * @brief  ʱʼ
- * @param  sysclk_mhz: ϵͳʱƵ (STM32F103ͨ 72)
+ * @param  sysclk_mhz: ʹãʵ HCLK  RUN_Clock ȡ (ݾɴ)
  */
 void RUN_delay_init(uint8_t sysclk_mhz);
 
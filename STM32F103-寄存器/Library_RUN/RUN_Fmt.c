@@ -0,0 +1,251 @@
+#include "RUN_Fmt.h"
+
+// ==============================================================================
+// ڲ
+// ==============================================================================
+
+static const uint32_t fmt_pow10[10] = {
+    1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000
+};
+
+// α ( size - 1 ֱַӶֻ)
+typedef struct {
+    char*    buf;
+    uint16_t size;
+    uint16_t len;
+} fmt_out_t;
+
+static void fmt_putc(fmt_out_t* o, char c)
+{
+    if (o->len + 1 < o->size) o->buf[o->len] = c;
+    o->len++;
+}
+
+static void fmt_pad(fmt_out_t* o, char c, int16_t n)
+{
+    while (n-- > 0) fmt_putc(o, c);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// ڲ޷תַ (д tmpλ)
+//-------------------------------------------------------------------------------------------------------------------
+static uint8_t fmt_utoa(char* tmp, uint32_t v, uint8_t base, uint8_t upper)
+{
+    const char* digits = upper ? "0123456789ABCDEF" : "0123456789abcdef";
+    uint8_t     n = 0;
+
+    if (base == 16)
+    {
+        do { tmp[n++] = digits[v & 0xF]; v >>= 4; } while (v);
+    }
+    else
+    {
+        do { tmp[n++] = (char)('0' + v % 10); v /= 10; } while (v);
+    }
+    return n;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// ڲ/־һֶ
+// ˵      sign            ַ (0 ʾ)
+// ˵      ip/in            () λ
+// ˵      fp/fn           С () λfn = 0 ʾС
+//-------------------------------------------------------------------------------------------------------------------
+static void fmt_field(fmt_out_t* o, char sign, const char* ip, uint8_t in, const char* fp, uint8_t fn,
+                      int16_t width, uint8_t left, uint8_t zero)
+{
+    int16_t pad = width - in - (sign ? 1 : 0) - (fn ? fn + 1 : 0);
+
+    if (!left && !zero) fmt_pad(o, ' ', pad);
+    if (sign) fmt_putc(o, sign);
+    if (!left && zero) fmt_pad(o, '0', pad);
+    while (in) fmt_putc(o, ip[--in]);
+    if (fn)
+    {
+        fmt_putc(o, '.');
+        while (fn--) fmt_putc(o, *fp++);
+    }
+    if (left) fmt_pad(o, ' ', pad);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// ڲ (mag Ϊֵ)
+// ˵      q16             1: Q16.16  0:  ( 10^prec)
+//-------------------------------------------------------------------------------------------------------------------
+static void fmt_fixed(fmt_out_t* o, uint32_t mag, char sign, uint8_t q16, uint8_t prec,
+                      int16_t width, uint8_t left, uint8_t zero)
+{
+    char     ip[10], fp[10];
+    uint32_t ipart, fpart;
+    uint8_t  i;
+
+    if (q16)
+    {
+        // С = frac * 10^prec / 65536룬λ (prec <= 4 )
+        ipart = mag >> 16;
+        fpart = ((mag & 0xFFFF) * fmt_pow10[prec] + 0x8000) >> 16;
+        if (fpart >= fmt_pow10[prec]) { fpart -= fmt_pow10[prec]; ipart++; }
+    }
+    else
+    {
+        ipart = mag / fmt_pow10[prec];
+        fpart = mag - ipart * fmt_pow10[prec];
+    }
+
+    for (i = prec; i > 0; i--)
+    {
+        fp[i - 1] = (char)('0' + fpart % 10);
+        fpart /= 10;
+    }
+    fmt_field(o, sign, ip, fmt_utoa(ip, ipart, 10, 0), fp, prec, width, left, zero);
+}
+
+// ==============================================================================
+// ӿں
+// ==============================================================================
+
+//-------------------------------------------------------------------------------------------------------------------
+//       ʽ (va_list 汾)
+// ˵      buf             
+// ˵      size            С
+// ˵      fmt             ʽ
+// ˵      ap              
+// ز      uint16_t        дַ ( '\0'Ѱ size ض)
+//-------------------------------------------------------------------------------------------------------------------
+uint16_t RUN_vfmt(char* buf, uint16_t size, const char* fmt, va_list ap)
+{
+    fmt_out_t o;
+
+    o.buf = buf; o.size = size; o.len = 0;
+    if (size == 0) return 0;
+
+    while (*fmt)
+    {
+        char     c = *fmt++;
+        uint8_t  left = 0, zero = 0, plus = 0, prec = 3, has_prec = 0;
+        int16_t  width = 0;
+        char     tmp[10];
+        char     sign = 0;
+
+        if (c != '%')
+        {
+            fmt_putc(&o, c);
+            continue;
+        }
+
+        // 1. ־ȡȡ
+        for (;; fmt++)
+        {
+            if      (*fmt == '-') left = 1;
+            else if (*fmt == '0') zero = 1;
+            else if (*fmt == '+') plus = 1;
+            else break;
+        }
+        while (*fmt >= '0' && *fmt <= '9') width = (int16_t)(width * 10 + (*fmt++ - '0'));
+        if (*fmt == '.')
+        {
+            fmt++;
+            has_prec = 1;
+            prec = 0;
+            while (*fmt >= '0' && *fmt <= '9') prec = (uint8_t)(prec * 10 + (*fmt++ - '0'));
+        }
+        while (*fmt == 'l' || *fmt == 'h') fmt++;
+
+        // 2. ת
+        switch (c = *fmt++)
+        {
+            case 'd':
+            case 'i':
+            case 'q':
+            case 'k':
+            {
+                int32_t  v   = va_arg(ap, int32_t);
+                uint32_t mag = (v < 0) ? (uint32_t)0 - (uint32_t)v : (uint32_t)v;
+
+                sign = (v < 0) ? '-' : (plus ? '+' : 0);
+                if (c == 'q')      fmt_fixed(&o, mag, sign, 1, (prec > 4) ? 4 : prec, width, left, zero);
+                else if (c == 'k') fmt_fixed(&o, mag, sign, 0, (prec > 9) ? 9 : prec, width, left, zero);
+                else               fmt_field(&o, sign, tmp, fmt_utoa(tmp, mag, 10, 0), 0, 0, width, left, zero);
+                break;
+            }
+            case 'u':
+            case 'x':
+            case 'X':
+            {
+                uint32_t v = va_arg(ap, uint32_t);
+                fmt_field(&o, 0, tmp, fmt_utoa(tmp, v, (c == 'u') ? 10 : 16, c == 'X'), 0, 0, width, left, zero);
+                break;
+            }
+            case 'c':
+                tmp[0] = (char)va_arg(ap, int);
+                fmt_field(&o, 0, tmp, 1, 0, 0, width, left, 0);
+                break;
+            case 's':
+            {
+                const char* s = va_arg(ap, const char*);
+                int16_t     n = 0;
+
+                if (s == 0) s = "(null)";
+                while (s[n] && (!has_prec || n < prec)) n++;
+                if (!left) fmt_pad(&o, ' ', width - n);
+                for (width -= n; n > 0; n--) fmt_putc(&o, *s++);
+                if (left) fmt_pad(&o, ' ', width);
+                break;
+            }
+            case '%':
+                fmt_putc(&o, '%');
+                break;
+            case '\0':
+                fmt--;
+                break;
+            default:    // ֵ֧תԭ
+                fmt_putc(&o, '%');
+                fmt_putc(&o, c);
+                break;
+        }
+    }
+
+    if (o.len >= size) o.len = size - 1;
+    buf[o.len] = '\0';
+    return o.len;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       ʽ
+// ˵      buf             
+// ˵      size            С
+// ˵      fmt             ʽ
+// ز      uint16_t        дַ
+// ʹʾ      char line[64];
+//               RUN_fmt(line, sizeof(line), "T=%.2q V=%.3k ID=%04X\r\n", temp_q16, mv, id);
+//-------------------------------------------------------------------------------------------------------------------
+uint16_t RUN_fmt(char* buf, uint16_t size, const char* fmt, ...)
+{
+    va_list  ap;
+    uint16_t n;
+
+    va_start(ap, fmt);
+    n = RUN_vfmt(buf, size, fmt, ap);
+    va_end(ap);
+    return n;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       ʽֱӷ
+// ˵      uart_pin        ö
+// ˵      fmt             ʽ
+// ز      uint16_t        ͵ַ
+// ʹʾ      RUN_fmt_uart(UART1_TX_PA9_RX_PA10, "pid out=%.3q err=%d\r\n", out_q16, err);
+//-------------------------------------------------------------------------------------------------------------------
+uint16_t RUN_fmt_uart(UART_PIN_enum uart_pin, const char* fmt, ...)
+{
+    char     buf[RUN_FMT_UART_MAX];
+    va_list  ap;
+    uint16_t n;
+
+    va_start(ap, fmt);
+    n = RUN_vfmt(buf, sizeof(buf), fmt, ap);
+    va_end(ap);
+    RUN_uart_write_buffered(uart_pin, (const uint8_t*)buf, n);
+    return n;
+}
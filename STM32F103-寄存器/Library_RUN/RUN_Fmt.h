@@ -0,0 +1,51 @@
+#ifndef _RUN_FMT_H_
+#define _RUN_FMT_H_
+
+#include <stdarg.h>
+#include "stm32f10x.h"
+#include "RUN_UART.h"
+
+// ==========================================================
+// ʽ (printf  / Ʒ)
+// ----------------------------------------------------------
+// ֻ 32 λ㣬 stdio ĸʽ
+// ֧֣%d %i %u %x %X %c %s %%־ '-' '0' '+'ȣ l ()
+// 㣺%.Nq  Q16.16 (int32_t 16 λ 16 λС)N = 0~4Ĭ 3
+//       %.Nk   (int32_tֵ / 10^N)N = 0~9Ĭ 3 "%.2k" 1234 -> "12.34"
+// ֧֣%f %e %g %p %nʱԭ
+//
+// Ա Host/bench/bench_fmt.c  make -C Host bench  (x86-64  glibc)
+//   ʱ (rdtscȡСֵر仯ֵֻ)
+//     "R=%.2f P=%.2f Y=%.2f rpm=%d err=%d st=%04X"  snprintf ԼΪ RUN_fmt (%.2q / %.2k)  3~4 
+//     "rpm=%d err=%d st=%04X"                        snprintf ԼΪ RUN_fmt  1.5~2 
+//    (text)RUN_Fmt.o (-Os) 2399 ֽڣsnprintf  libc.a Ա
+//     (snprintf / vsnprintf / vfprintf-internal / printf_fp / printf_fphex / printf-parsemb) ϼ 45584 ֽ
+// û newlib / microlibMCU ϵͬѭŵ DWT CYCCNT ⣬
+// Thumb-2  map ļ
+// ==========================================================
+
+#define RUN_FMT_UART_MAX    128                     // RUN_fmt_uart 
+
+// float -> Q16.16 (һ˷ printf("%f") ˵ö)
+#define RUN_FMT_Q16(x)      ((int32_t)((x) * 65536.0f))
+
+// ==========================================================
+// 
+// ==========================================================
+
+/**
+ * @brief  ʽ ( '\0' βض)
+ * @param  buf:  
+ * @param  size: С ( '\0')
+ * @return дַ ( '\0')
+ */
+uint16_t RUN_fmt(char* buf, uint16_t size, const char* fmt, ...);
+uint16_t RUN_vfmt(char* buf, uint16_t size, const char* fmt, va_list ap);
+
+/**
+ * @brief  ʽֱӽڷͶ (RUN_uart_write_buffered DMA ʱ)
+ * @return ͵ַ ( RUN_FMT_UART_MAX - 1)
+ */
+uint16_t RUN_fmt_uart(UART_PIN_enum uart_pin, const char* fmt, ...);
+
+#endif
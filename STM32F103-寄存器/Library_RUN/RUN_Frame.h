@@ -0,0 +1,73 @@
+#ifndef _RUN_FRAME_H_
+#define _RUN_FRAME_H_
+
+#include "stm32f10x.h"
+#include "RUN_UART.h"
+
+// ==========================================================
+// ֡Э (COBS + CRC-16)
+// ----------------------------------------------------------
+// ϸʽCOBS( type | payload | crc_hi | crc_lo ) + 0x00
+//   type     : Ϣ (ӦԼ)
+//   payload  :  (ṹֱӷ printf/)
+//   crc      : CRC-16/CCITT-FALSE (ʽ 0x1021ֵ 0xFFFF) type + payload
+// COBS ֡ڲ 0x000x00 ָֻֽںһ 0x00 ͬ
+// ÿ̶֡ 5 ֽ (type + 2 ֽ CRC + COBS ׸ֽ + ָ) + ÿ 254 ֽ 1 ֽڡ
+//
+// Ա (115200 8N18  float ң⣬ Host/bench/bench_frame.c ɣmake -C Host bench)
+//   ı "@%.3f,...\r\n"   56 ֽ/206 /룬շ sprintf + RUN_Str_GetFloatArray
+//   ֡              37 ֽ/311 / (1.51 )
+// /Ϊ DMA 巢͵ʵֵ+ʱ x86 ԭʱ
+// ֡ԼΪı 1/4~1/6ֻԱȽϣMCU ϵľԺʱϰ⡣
+// ==========================================================
+
+#define RUN_FRAME_OVERHEAD          5                                   // type + CRC + COBS ֽ + ָ
+#define RUN_FRAME_ENCODED_MAX(n)    ((n) + RUN_FRAME_OVERHEAD + ((n) + 3) / 254)       // 󳤶
+#define RUN_FRAME_SEND_MAX          128                                 // RUN_frame_send ֡ payload
+
+// ʽ (ÿյһֽڵһ RUN_frame_rx_byte)
+typedef struct {
+    uint8_t*          buf;          // type + payload + CRC (Ϊ NULL ʱ֡)
+    uint16_t          size;         // buf С
+    uint16_t          len;          // ѽֽ
+    uint16_t          crc;          // ͬ CRC һ㣬֡ȷʱΪ 0
+    uint8_t           left;         // ǰ COBS ʣֽ
+    uint8_t           zero;         // ǰҪһ 0
+    uint8_t           state;        // 0: ֡ͷ  1: ֡  2: ָ
+    volatile uint32_t crc_error;    // CRC ֡
+    volatile uint32_t format_error; // ʽ / ֡
+} RUN_frame_rx_t;
+
+// ==========================================================
+// 
+// ==========================================================
+
+// CRC-16/CCITT-FALSE ()crc  0xFFFF ʼɷֶ
+uint16_t RUN_crc16(uint16_t crc, const uint8_t* data, uint16_t len);
+
+/**
+ * @brief  һ֡
+ * @param  type:    Ϣ
+ * @param  payload:  (Ϊ NULLlen = 0)
+ * @param  out:      RUN_FRAME_ENCODED_MAX(len) ֽ
+ * @return 󳤶 (β 0x00)
+ */
+uint16_t RUN_frame_encode(uint8_t type, const void* payload, uint16_t len, uint8_t* out);
+
+/**
+ * @brief  벢һ֡ ( RUN_uart_write_buffered DMA ʱ)
+ * @return 1: ѷ  0: len  RUN_FRAME_SEND_MAX
+ */
+uint8_t  RUN_frame_send(UART_PIN_enum uart_pin, uint8_t type, const void* payload, uint16_t len);
+
+// ʼ
+void     RUN_frame_rx_init(RUN_frame_rx_t* rx, uint8_t* buf, uint16_t size);
+
+/**
+ * @brief  һֽ
+ * @return 0: ֡δ / ֡Ч>0: յһ֡ȷֵ֡Ϊ type + payload ĳ
+ *         (buf[0] Ϊ typebuf[1] Ϊ payloadһֽڵǰЧ)
+ */
+uint16_t RUN_frame_rx_byte(RUN_frame_rx_t* rx, uint8_t byte);
+
+#endif
@@ -1,4 +1,5 @@
 #include "RUN_Gpio.h"
+#include <string.h>
 
 // ===============================================================================
 // Ӳӳ 
@@ -77,47 +78,57 @@ const gpio_info_t gpio_cfg[RUN_GPIO_MAX] = {
 };
 
 //-------------------------------------------------------------------------------------------------------------------
-//       GPIO ʼ (ĴֱӲ)
-// ˵      pin             ѡ GPIO 
-// ˵      mode             GPIO ģʽ
-// ˵      default_level   Ĭϵƽ
-// עϢ      ֱӲ APB2ENR, CRL/CRH, ODR, BSRR/BRR Ĵ
+// ڲģʽö -> 4 λֵ [CNF1 CNF0 MODE1 MODE0]
+// MODE: 00(Input), 11(Output 50MHz)
 //-------------------------------------------------------------------------------------------------------------------
-void RUN_gpio_init(RUN_GPIO_enum pin, RUN_GPIO_Mode mode, uint8_t default_level)
+static uint32_t gpio_mode_conf(RUN_GPIO_Mode mode)
 {
-    if (pin >= RUN_GPIO_MAX) return;
-
-    GPIO_TypeDef* GPIOx = gpio_cfg[pin].port; 
-    uint32_t current_mode_conf = 0;
-    
-    // 1. ʱ
-    // ֱӲ RCC_APB2ENR ĴͨʹܶӦʱ
-    RCC->APB2ENR |= gpio_cfg[pin].rcc;
-
-    // 2. ׼Ĵֵ (MODE + CNF)
-    // STM32F103 λΪ 4 λ [CNF1 CNF0 MODE1 MODE0]
-    // MODE: 00(Input), 11(Output 50MHz)
     switch (mode)
     {
         //  50MHz (MODE=11, CNF=00) -> 0011b = 0x3
-        case GPO:    current_mode_conf = 0x3; break; 
+        case GPO:    return 0x3;
         
         // © 50MHz (MODE=11, CNF=01) -> 0111b = 0x7
-        case GPO_OD: current_mode_conf = 0x7; break; 
+        case GPO_OD: return 0x7;
+        
+        //  50MHz (MODE=11, CNF=10) -> 1011b = 0xB
+        case AF_PP:  return 0xB;
+        
+        // ÿ© 50MHz (MODE=11, CNF=11) -> 1111b = 0xF
+        case AF_OD:  return 0xF;
         
         // / (MODE=00, CNF=10) -> 1000b = 0x8
         // ע ODR Ĵֵλһ
         case GPI_PU: 
-        case GPI_PD: current_mode_conf = 0x8; break; 
+        case GPI_PD: return 0x8;
         
         // ģ (MODE=00, CNF=00) -> 0000b = 0x0
-        case AIN:    current_mode_conf = 0x0; break; 
+        case AIN:    return 0x0;
         
         //  (MODE=00, CNF=01) -> 0100b = 0x4
-        default:     current_mode_conf = 0x4; break; 
+        default:     return 0x4;
     }
+}
 
-    // 3. д CRL  CRH Ĵ
+//-------------------------------------------------------------------------------------------------------------------
+//       GPIO ʼ (ĴֱӲ)
+// ˵      pin             ѡ GPIO 
+// ˵      mode             GPIO ģʽ
+// ˵      default_level   Ĭϵƽ
+// עϢ      ֱӲ APB2ENR, CRL/CRH, ODR, BSRR/BRR Ĵ
+//-------------------------------------------------------------------------------------------------------------------
+void RUN_gpio_init(RUN_GPIO_enum pin, RUN_GPIO_Mode mode, uint8_t default_level)
+{
+    if (pin >= RUN_GPIO_MAX) return;
+
+    GPIO_TypeDef* GPIOx = gpio_cfg[pin].port; 
+    uint32_t current_mode_conf = gpio_mode_conf(mode);
+    
+    // 1. ʱ
+    // ֱӲ RCC_APB2ENR ĴͨʹܶӦʱ
+    RCC->APB2ENR |= gpio_cfg[pin].rcc;
+
+    // 2. д CRL  CRH Ĵ
     // pin_index 㣺0~15
     uint8_t pin_index = pin % 16; 
 
@@ -137,7 +148,7 @@ void RUN_gpio_init(RUN_GPIO_enum pin, RUN_GPIO_Mode mode, uint8_t default_level)
         GPIOx->CRH |= (current_mode_conf << shift);
     }
 
-    // 4. / (ͨ ODR Ĵ)
+    // 3. / (ͨ ODR Ĵ)
     if (mode == GPI_PU)
     {
         GPIOx->BSRR = gpio_cfg[pin].pin; // Set Bit -> 
@@ -147,8 +158,8 @@ void RUN_gpio_init(RUN_GPIO_enum pin, RUN_GPIO_Mode mode, uint8_t default_level)
         GPIOx->BRR = gpio_cfg[pin].pin;  // Reset Bit -> 
     }
 
-    // 5. ģʽóʼƽ
-    if (mode == GPO || mode == GPO_OD)
+    // 4. ģʽóʼƽ
+    if (mode == GPO || mode == GPO_OD || mode == AF_PP || mode == AF_OD)
     {
         RUN_gpio_set(pin, default_level);
     }
@@ -176,14 +187,18 @@ void RUN_gpio_set(RUN_GPIO_enum pin, uint8_t level)
 
 //-------------------------------------------------------------------------------------------------------------------
 //       GPIO ƽת (Ĵ)
-// עϢ      ͨ ODR Ĵʵ
+// עϢ       ODR жϵǰƽͨ BSRR һд뷭ת
+//               (ODR ^= Ƕджмͬ˿Żᱻ)
 //-------------------------------------------------------------------------------------------------------------------
 void RUN_gpio_toggle(RUN_GPIO_enum pin)
 {
     if (pin >= RUN_GPIO_MAX) return;
-    
-    // ^= 0110
-    gpio_cfg[pin].port->ODR ^= gpio_cfg[pin].pin;
+
+    GPIO_TypeDef* GPIOx = gpio_cfg[pin].port;
+    uint32_t mask = gpio_cfg[pin].pin;
+
+    // ǰΪ ->  16 λλǰΪ ->  16 λλ
+    GPIOx->BSRR = (GPIOx->ODR & mask) ? (mask << 16) : mask;
 }
 
 //-------------------------------------------------------------------------------------------------------------------
@@ -203,4 +218,365 @@ uint8_t RUN_gpio_get(RUN_GPIO_enum pin)
     {
         return 0;
     }
-}
\ No newline at end of file
+}
+// ===============================================================================
+// 弶űʼ
+// ===============================================================================
+
+// AFIO->MAPR иӳֶ (λֶαȡͬһֵ)
+static const uint32_t gpio_mapr_field[] = {
+    AFIO_MAPR_SPI1_REMAP,   AFIO_MAPR_I2C1_REMAP,   AFIO_MAPR_USART1_REMAP, AFIO_MAPR_USART2_REMAP,
+    AFIO_MAPR_USART3_REMAP, AFIO_MAPR_TIM1_REMAP,   AFIO_MAPR_TIM2_REMAP,   AFIO_MAPR_TIM3_REMAP,
+    AFIO_MAPR_TIM4_REMAP,   AFIO_MAPR_CAN_REMAP,    AFIO_MAPR_PD01_REMAP,   AFIO_MAPR_TIM5CH4_IREMAP,
+    AFIO_MAPR_ADC1_ETRGINJ_REMAP, AFIO_MAPR_ADC1_ETRGREG_REMAP,
+    AFIO_MAPR_ADC2_ETRGINJ_REMAP, AFIO_MAPR_ADC2_ETRGREG_REMAP, AFIO_MAPR_SWJ_CFG
+};
+
+// һд SWJ_CFGֶֻд (ֵȷ)סд MAPR ʱԭд
+static uint32_t gpio_swj_cfg = 0;
+
+//  remap λչֶε
+static uint32_t gpio_mapr_mask(uint32_t remap)
+{
+    uint32_t mask = 0;
+    uint8_t i;
+    for (i = 0; i < sizeof(gpio_mapr_field) / sizeof(gpio_mapr_field[0]); i++)
+    {
+        if (remap & gpio_mapr_field[i]) mask |= gpio_mapr_field[i];
+    }
+    return mask;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       弶űʼ GPIO
+// ˵      table           ű
+// ˵      num             
+// ˵      first_conflict  һͻ± (Ŀɴ NULL)
+// ز      uint16_t        ͻ0 ʾȫɹ
+// ʹʾ      static const RUN_gpio_pinmux_t board_pins[] = {
+//                   {C13, GPO,   1, 0},
+//                   {B6,  AF_PP, 1, AFIO_MAPR_USART1_REMAP},   // USART1_TX ӳ䵽 PB6
+//                   {B7,  GPI_PU,0, AFIO_MAPR_USART1_REMAP},   // USART1_RX
+//                   {A2,  AF_PP, 1, RUN_GPIO_REMAP_DEFAULT(AFIO_MAPR_USART2_REMAP)}, // USART2_TX  PA2
+//                   {A0,  AIN,   0, 0},
+//               };
+//               RUN_gpio_init_table(board_pins, sizeof(board_pins) / sizeof(board_pins[0]), NULL);
+// עϢ      1.  RAM кϳÿ˿ڵãύ
+//                  APB2ENR д 1 Σÿ˿ BSRR д 1  (ȶƽ)CRL/CRH д 1  (ֻиĶʱ)
+//                  AFIO->MAPR д 1 ΡΪ˲Ŀƽë̡
+//               2. ±ΪͻŷǷͬһųεģʽ/ƽͬ
+//                  ӳֶǰҪֵͬȫͬظͻ
+//               3. remap = 0 ıԼκֶΣҪĬӳд RUN_GPIO_REMAP_DEFAULT(ֶ)
+//               4. SWJ_CFG ֻд (ֵȷ)ύ MAPR ʱĶֵ
+//                  Ҫ SWJ_CFG дֵдסһεֵ
+//                  ( RUN_gpio_swj_configλΪ 000  SWJ)
+//-------------------------------------------------------------------------------------------------------------------
+uint16_t RUN_gpio_init_table(const RUN_gpio_pinmux_t* table, uint16_t num, uint16_t* first_conflict)
+{
+    uint32_t cr_mask[7][2] = {{0}}, cr_val[7][2] = {{0}};
+    uint16_t odr_set[7] = {0}, odr_clr[7] = {0};
+    uint32_t apb2enr = 0, mapr_mask = 0, mapr_val = 0;
+    uint16_t conflicts = 0;
+    uint16_t i;
+    uint8_t  p;
+
+    // 1. ϳ
+    for (i = 0; i < num; i++)
+    {
+        RUN_GPIO_enum pin  = table[i].pin;
+        RUN_GPIO_Mode mode = table[i].mode;
+        uint8_t  port_idx, hi, shift;
+        uint16_t bit;
+        uint32_t conf, field, remap, set = 0, clr = 0;
+
+        if (pin >= RUN_GPIO_MAX)
+        {
+            if (conflicts++ == 0 && first_conflict) *first_conflict = i;
+            continue;
+        }
+
+        port_idx = pin / 16;
+        hi       = (pin % 16) >= 8;
+        shift    = ((pin % 16) & 7) * 4;
+        bit      = gpio_cfg[pin].pin;
+        conf     = gpio_mode_conf(mode);
+
+        if (mode == GPI_PU) set = bit;
+        else if (mode == GPI_PD) clr = bit;
+        else if (mode == GPO || mode == GPO_OD || mode == AF_PP || mode == AF_OD)
+        {
+            if (table[i].level) set = bit; else clr = bit;
+        }
+
+        // ӳֶҪֵ (DEFAULT ǣֶαΪ 0)
+        field = gpio_mapr_mask(table[i].remap & ~RUN_GPIO_REMAP_DEFAULT_FLAG);
+        remap = (table[i].remap & RUN_GPIO_REMAP_DEFAULT_FLAG) ? 0 : (table[i].remap & field);
+
+        // ͬһѱǰıռãòͬͻ
+        if (((cr_mask[port_idx][hi] >> shift) & 0xF) &&
+            (((cr_val[port_idx][hi] >> shift) & 0xF) != conf ||
+             (set && (odr_clr[port_idx] & bit)) || (clr && (odr_set[port_idx] & bit))))
+        {
+            if (conflicts++ == 0 && first_conflict) *first_conflict = i;
+            continue;
+        }
+        // ӳֶѱҪɱֵͻ
+        if ((mapr_mask & field & (mapr_val ^ remap)) != 0)
+        {
+            if (conflicts++ == 0 && first_conflict) *first_conflict = i;
+            continue;
+        }
+
+        cr_mask[port_idx][hi] |= (uint32_t)0xF << shift;
+        cr_val[port_idx][hi]  = (cr_val[port_idx][hi] & ~((uint32_t)0xF << shift)) | (conf << shift);
+        odr_set[port_idx] |= set;
+        odr_clr[port_idx] |= clr;
+        apb2enr |= gpio_cfg[pin].rcc;
+        mapr_mask |= field;
+        mapr_val  |= remap;
+    }
+
+    // 2. ύʱ -> ƽ -> ģʽ -> ӳ
+    if (mapr_mask) apb2enr |= RCC_APB2ENR_AFIOEN;
+    if (apb2enr) RCC->APB2ENR |= apb2enr;
+
+    for (p = 0; p < 7; p++)
+    {
+        GPIO_TypeDef* GPIOx = gpio_cfg[p * 16].port;
+
+        if (odr_set[p] | odr_clr[p])
+        {
+            GPIOx->BSRR = odr_set[p] | ((uint32_t)odr_clr[p] << 16);
+        }
+        if (cr_mask[p][0])
+        {
+            GPIOx->CRL = (GPIOx->CRL & ~cr_mask[p][0]) | cr_val[p][0];
+        }
+        if (cr_mask[p][1])
+        {
+            GPIOx->CRH = (GPIOx->CRH & ~cr_mask[p][1]) | cr_val[p][1];
+        }
+    }
+
+    if (mapr_mask)
+    {
+        if (mapr_mask & AFIO_MAPR_SWJ_CFG) gpio_swj_cfg = mapr_val & AFIO_MAPR_SWJ_CFG;
+        AFIO->MAPR = (AFIO->MAPR & ~(mapr_mask | AFIO_MAPR_SWJ_CFG)) | (mapr_val & ~AFIO_MAPR_SWJ_CFG) | gpio_swj_cfg;
+    }
+
+    return conflicts;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       õԿ (AFIO->MAPR  SWJ_CFG ֶ) סֵ
+// ˵      swj             AFIO_MAPR_SWJ_CFG_RESET / _NOJNTRST / _JTAGDISABLE / _DISABLE
+// ز      void
+// ʹʾ      RUN_gpio_swj_config(AFIO_MAPR_SWJ_CFG_JTAGDISABLE); //  JTAG  SWDͷ PB3/PB4/PA15
+// עϢ      SWJ_CFG ֵȷ֮ RUN_gpio_init_table д MAPR ʱдסֵ
+//-------------------------------------------------------------------------------------------------------------------
+void RUN_gpio_swj_config(uint32_t swj)
+{
+    RCC->APB2ENR |= RCC_APB2ENR_AFIOEN;
+    gpio_swj_cfg = swj & AFIO_MAPR_SWJ_CFG;
+    AFIO->MAPR   = (AFIO->MAPR & ~AFIO_MAPR_SWJ_CFG) | gpio_swj_cfg;
+}
+
+// ===============================================================================
+// ˿ڲ
+// ===============================================================================
+
+//  -> λ
+static __INLINE uint32_t gpio_group_pins(const RUN_gpio_group_t* grp, uint16_t value)
+{
+    if (grp->shift != 0xFF)
+    {
+        return ((uint32_t)value << grp->shift) & grp->mask;
+    }
+    return grp->out_lut[0][value & 0xF]         | grp->out_lut[1][(value >> 4) & 0xF] |
+           grp->out_lut[2][(value >> 8) & 0xF]  | grp->out_lut[3][(value >> 12) & 0xF];
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       ˿ڲʼ
+// ˵      grp              (ɵṩ洢)
+// ˵      pins            бpins[0] Ϊλ
+// ˵      num             Ÿ (1~16)
+// ˵      mode            ģʽ (д GPO GPI/GPI_PU ...)
+// ز      uint8_t         1: ɹ  0: ŷǷ / ͬһ˿ / ظ
+// ʹʾ      const RUN_GPIO_enum lcd_db[8] = {B8, B9, B10, B11, B12, B13, B14, B15};
+//               RUN_gpio_group_init(&lcd_bus, lcd_db, 8, GPO);
+// עϢ      Ű gpio_cfg[] ˶Զ˿ں룬ȫϷ RUN_gpio_init
+//-------------------------------------------------------------------------------------------------------------------
+uint8_t RUN_gpio_group_init(RUN_gpio_group_t* grp, const RUN_GPIO_enum* pins, uint8_t num, RUN_GPIO_Mode mode)
+{
+    uint16_t mask = 0;
+    uint8_t  contiguous = 1;
+    uint8_t  i, k, n;
+
+    if (num == 0 || num > 16) return 0;
+
+    // 1. ˶ţϷͬһ˿ڡظ
+    for (i = 0; i < num; i++)
+    {
+        if (pins[i] >= RUN_GPIO_MAX) return 0;
+        if (gpio_cfg[pins[i]].port != gpio_cfg[pins[0]].port) return 0;
+        if (mask & gpio_cfg[pins[i]].pin) return 0;
+
+        mask |= gpio_cfg[pins[i]].pin;
+        if ((pins[i] % 16) != (pins[0] % 16) + i) contiguous = 0;
+    }
+
+    grp->port  = gpio_cfg[pins[0]].port;
+    grp->mask  = mask;
+    grp->width = num;
+    grp->shift = contiguous ? (pins[0] % 16) : 0xFF;
+
+    // 2. ʱԤλű
+    memset(grp->out_lut, 0, sizeof(grp->out_lut));
+    memset(grp->in_lut, 0, sizeof(grp->in_lut));
+    for (k = 0; k < 4; k++)
+    {
+        for (n = 0; n < 16; n++)
+        {
+            for (i = 0; i < 4; i++)
+            {
+                if (!(n & (1 << i))) continue;
+                uint8_t bit = k * 4 + i;      // λ (д) / ź ()
+                if (bit < num) grp->out_lut[k][n] |= gpio_cfg[pins[bit]].pin;
+            }
+        }
+    }
+    for (i = 0; i < num; i++)
+    {
+        uint8_t pin_idx = pins[i] % 16;
+        for (n = 0; n < 16; n++)
+        {
+            if (n & (1 << (pin_idx % 4))) grp->in_lut[pin_idx / 4][n] |= (1 << i);
+        }
+    }
+
+    // 3. 
+    for (i = 0; i < num; i++)
+    {
+        RUN_gpio_init(pins[i], mode, 0);
+    }
+    return 1;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       ˿ڲд
+// ˵      value            (ֻõ width λ)
+// ʹʾ      RUN_gpio_group_write(&lcd_bus, 0xA5);
+// עϢ      һ BSRR д 16 λλҪţ 16 λλҪ 1 ţ
+//               ŲӰ죬ҲҪж
+//-------------------------------------------------------------------------------------------------------------------
+void RUN_gpio_group_write(const RUN_gpio_group_t* grp, uint16_t value)
+{
+    uint32_t bits = gpio_group_pins(grp, value);
+    grp->port->BSRR = bits | ((uint32_t)(grp->mask & ~bits) << 16);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       ˿ڲ
+// ز      uint16_t         (pins[0] Ϊλ)
+// עϢ      һ IDR 
+//-------------------------------------------------------------------------------------------------------------------
+uint16_t RUN_gpio_group_read(const RUN_gpio_group_t* grp)
+{
+    uint16_t idr = grp->port->IDR & grp->mask;
+
+    if (grp->shift != 0xFF)
+    {
+        return idr >> grp->shift;
+    }
+    return grp->in_lut[0][idr & 0xF]        | grp->in_lut[1][(idr >> 4) & 0xF] |
+           grp->in_lut[2][(idr >> 8) & 0xF] | grp->in_lut[3][(idr >> 12) & 0xF];
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       ˿ڲд N ֣ÿִһ͵ƽѡͨ (8080 ӿ WR#)
+// ˵      strobe          ѡͨ (ѳʼΪ GPO Ĭϸߵƽ)
+// ˵      data/len        ݻ
+// ʹʾ      RUN_gpio_group_write_stream(&lcd_bus, B5, frame, 320 * 240);
+// עϢ      ѡͨͬһ˿ʱ" +  WR" ϲΪһ BSRR д
+//               ÿֻ 2 δ洢ر档
+//               72MHz µ͵ƽԼΪһ APB2 д (~28ns)㳣 LCD  tWRL
+//-------------------------------------------------------------------------------------------------------------------
+void RUN_gpio_group_write_stream(const RUN_gpio_group_t* grp, RUN_GPIO_enum strobe, const uint16_t* data, uint32_t len)
+{
+    if (strobe >= RUN_GPIO_MAX) return;
+
+    GPIO_TypeDef* port = grp->port;
+    GPIO_TypeDef* stb_port = gpio_cfg[strobe].port;
+    uint32_t stb = gpio_cfg[strobe].pin;
+    uint32_t mask = grp->mask;
+    uint32_t bits;
+
+    if (stb_port == port && !(mask & stb))
+    {
+        if (grp->shift != 0xFF)
+        {
+            uint8_t shift = grp->shift;
+            while (len--)
+            {
+                bits = ((uint32_t)*data++ << shift) & mask;
+                port->BSRR = bits | ((mask & ~bits) << 16) | (stb << 16);
+                port->BSRR = stb;
+            }
+        }
+        else
+        {
+            while (len--)
+            {
+                bits = gpio_group_pins(grp, *data++);
+                port->BSRR = bits | ((mask & ~bits) << 16) | (stb << 16);
+                port->BSRR = stb;
+            }
+        }
+    }
+    else
+    {
+        while (len--)
+        {
+            bits = gpio_group_pins(grp, *data++);
+            port->BSRR = bits | ((mask & ~bits) << 16);
+            stb_port->BRR  = stb;
+            stb_port->BSRR = stb;
+        }
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       ˿ڲд (ֽڻ汾 8 λ)
+// עϢ       RUN_gpio_group_write_stream ͬ
+//-------------------------------------------------------------------------------------------------------------------
+void RUN_gpio_group_write_stream8(const RUN_gpio_group_t* grp, RUN_GPIO_enum strobe, const uint8_t* data, uint32_t len)
+{
+    if (strobe >= RUN_GPIO_MAX) return;
+
+    GPIO_TypeDef* port = grp->port;
+    GPIO_TypeDef* stb_port = gpio_cfg[strobe].port;
+    uint32_t stb = gpio_cfg[strobe].pin;
+    uint32_t mask = grp->mask;
+    uint32_t bits;
+
+    if (stb_port == port && !(mask & stb))
+    {
+        while (len--)
+        {
+            bits = gpio_group_pins(grp, *data++);
+            port->BSRR = bits | ((mask & ~bits) << 16) | (stb << 16);
+            port->BSRR = stb;
+        }
+    }
+    else
+    {
+        while (len--)
+        {
+            bits = gpio_group_pins(grp, *data++);
+            port->BSRR = bits | ((mask & ~bits) << 16);
+            stb_port->BRR  = stb;
+            stb_port->BSRR = stb;
+        }
+    }
+}
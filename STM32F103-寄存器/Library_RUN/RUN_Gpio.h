@@ -46,7 +46,9 @@ typedef enum {
     GPI_PD,     // 
     GPO,        // 
     GPO_OD,     // ©
-    AIN         // ģ
+    AIN,        // ģ
+    AF_PP,      //  (USART TX / SPI SCK,MOSI / PWM ...)
+    AF_OD       // ÿ© (I2C SCL/SDA ...)
 } RUN_GPIO_Mode;
 
 // ---  ---
@@ -55,4 +57,107 @@ void    RUN_gpio_set (RUN_GPIO_enum pin, uint8_t level);
 void    RUN_gpio_toggle(RUN_GPIO_enum pin);
 uint8_t RUN_gpio_get (RUN_GPIO_enum pin);
 
+// ==========================================================
+// 3.1 弶űʼ
+// ----------------------------------------------------------
+// ӵŷдһűһÿ˿յ
+// CRL/CRH/ODR Լ APB2ENRAFIO->MAPRÿĴֻдһΡ
+// ==========================================================
+typedef struct {
+    RUN_GPIO_enum pin;      // 
+    RUN_GPIO_Mode mode;     // ģʽ
+    uint8_t       level;    // ģʽĬϵƽ (ģʽԣ mode )
+    uint32_t      remap;    // ùҪ AFIO->MAPR λ ( AFIO_MAPR_USART1_REMAP) 0
+} RUN_gpio_pinmux_t;
+
+// remap  0 ֻʾ""ͻ飻ҪĳֶαĬӳʱ꣬
+//  PA9/PA10  USART1RUN_GPIO_REMAP_DEFAULT(AFIO_MAPR_USART1_REMAP)
+// ͬһűһҪ USART1 ӳʱΪͻ(bit31  MAPR бδ)
+#define RUN_GPIO_REMAP_DEFAULT_FLAG     0x80000000u
+#define RUN_GPIO_REMAP_DEFAULT(field)   (RUN_GPIO_REMAP_DEFAULT_FLAG | (uint32_t)(field))
+
+uint16_t RUN_gpio_init_table(const RUN_gpio_pinmux_t* table, uint16_t num, uint16_t* first_conflict);
+
+// Կ (SWJ_CFG ֻдסдֵ֮д MAPR ʱ JTAG ִ)
+void     RUN_gpio_swj_config(uint32_t swj);
+
+// ==========================================================
+// 4. · (Χ)
+// ----------------------------------------------------------
+// GPIOA~GPIOG ַ ( 0x400)öٰ 16 һУ
+// Զ˿ںֱöֵpin Ϊʱ
+// ۵һַ STR/LDRpin ΪʱҲֻǼλ㡣
+// ע⣺pin ǺϷöֵ (< RUN_GPIO_MAX)дϡ
+//
+// ÿεõ DWT  (Host/bench/bench_gpio.cmake -C Host bench ʵ)
+//   RUN_gpio_set / _fast / RUN_PIN_OUT     3   1  APB2 
+//   RUN_gpio_get / _fast                   3   1  APB2 
+//   ODR ^= (ɷת) / toggle / toggle_fast 6   2  APB2 
+// ֻۼڡ CPU ָԲͿ·ͬ
+// ·ʡǲΧͺЩ CPU ָ
+// Ҫⲿֲ bench_gpio() ŵͬ CYCCNT ʱ
+// ==========================================================
+#define RUN_GPIO_PORT(pin)      ((GPIO_TypeDef*)(GPIOA_BASE + ((uint32_t)(pin) >> 4) * 0x400))
+#define RUN_GPIO_MASK(pin)      ((uint16_t)(1u << ((uint32_t)(pin) & 0xF)))
+
+// Cortex-M3 λÿһλӦһ 32 λ
+#define RUN_BITBAND(addr, bit)  (*(volatile uint32_t*)(PERIPH_BB_BASE + ((uint32_t)(addr) - PERIPH_BASE) * 32 + (bit) * 4))
+
+// λд (ֵ)÷RUN_PIN_OUT(C13) = 1;  if (RUN_PIN_IN(A0)) ...
+#define RUN_PIN_OUT(pin)        RUN_BITBAND(&RUN_GPIO_PORT(pin)->ODR, (uint32_t)(pin) & 0xF)
+#define RUN_PIN_IN(pin)         RUN_BITBAND(&RUN_GPIO_PORT(pin)->IDR, (uint32_t)(pin) & 0xF)
+
+//-------------------------------------------------------------------------------------------------------------------
+//       GPIO ƽ (ٰ)
+// ʹʾ      RUN_gpio_set_fast(C13, 1);
+// עϢ      һ BSRR д 16 λλ 16 λλȻԭ
+//-------------------------------------------------------------------------------------------------------------------
+static __INLINE void RUN_gpio_set_fast(RUN_GPIO_enum pin, uint8_t level)
+{
+    RUN_GPIO_PORT(pin)->BSRR = level ? (uint32_t)RUN_GPIO_MASK(pin) : ((uint32_t)RUN_GPIO_MASK(pin) << 16);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       GPIO ƽȡ (ٰ)
+// עϢ      λ IDRֱӵõ 0/1ʡȥͱȽ
+//-------------------------------------------------------------------------------------------------------------------
+static __INLINE uint8_t RUN_gpio_get_fast(RUN_GPIO_enum pin)
+{
+    return (uint8_t)RUN_PIN_IN(pin);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       GPIO ƽת (ٰ)
+// עϢ       ODR һ BSRR дɷתֻţ
+//               жڶд֮޸ͬ˿Ҳᱻ
+//-------------------------------------------------------------------------------------------------------------------
+static __INLINE void RUN_gpio_toggle_fast(RUN_GPIO_enum pin)
+{
+    uint32_t mask = RUN_GPIO_MASK(pin);
+    RUN_GPIO_PORT(pin)->BSRR = (RUN_GPIO_PORT(pin)->ODR & mask) ? (mask << 16) : mask;
+}
+
+// ==========================================================
+// 5. ˿ڲ (8/16 λߣ8080  ADC ...)
+// ----------------------------------------------------------
+// ͬһ˿ϵһ""λ i Ӧ pins[i]
+// дһ BSRR ͬʱλ͸λһ IDR
+//  ( B8~B15) ʱֻλʱóʼʱõ
+// ֽڲұλ (ÿ 4 β)
+// ==========================================================
+typedef struct {
+    GPIO_TypeDef* port;         // ڶ˿
+    uint16_t      mask;         // 
+    uint8_t       width;        // λ (1~16)
+    uint8_t       shift;        // ʱΪźţΪ 0xFF
+    uint16_t      out_lut[4][16]; // ݰֽ -> λ (ʱʹ)
+    uint16_t      in_lut[4][16];  // Űֽ -> λ (ʱʹ)
+} RUN_gpio_group_t;
+
+uint8_t  RUN_gpio_group_init (RUN_gpio_group_t* grp, const RUN_GPIO_enum* pins, uint8_t num, RUN_GPIO_Mode mode);
+void     RUN_gpio_group_write(const RUN_gpio_group_t* grp, uint16_t value);
+uint16_t RUN_gpio_group_read (const RUN_gpio_group_t* grp);
+void     RUN_gpio_group_write_stream  (const RUN_gpio_group_t* grp, RUN_GPIO_enum strobe, const uint16_t* data, uint32_t len);
+void     RUN_gpio_group_write_stream8 (const RUN_gpio_group_t* grp, RUN_GPIO_enum strobe, const uint8_t* data, uint32_t len);
+
 #endif
\ No newline at end of file
@@ -1,314 +1,255 @@
 #include "RUN_header_file.h"
 
 // ===============================================================================
-// ȫֱ
+// ڰ
 // -------------------------------------------------------------------------------
-// ڴ洢ڽյݰɱ־λ
-// Эʽ@ +  + \r\n
+// Эʽ@ +  + \r\n (ıģʽ)  COBS ֡ (֡ģʽ RUN_Frame.h)
+// ÿһ + RUN_RX_SLOTS ۡжֱӰдǰۣ
+// һͽѭ (head++)ѭ黹 (tail++)
+// head ֻждtail ֻѭд߶Ҫжϡ
 // ===============================================================================
 
-// 1 
-char UART1_RxPacket[MAX_RX_LEN]; // ջ
-uint8_t UART1_RxFlag = 0;        // ɱ־ (1:, 0:δ)
+typedef struct {
+    char              slot[RUN_RX_SLOTS][MAX_RX_LEN];
+    uint8_t           len[RUN_RX_SLOTS];
+    volatile uint8_t  head;         // жϣİ (ɼ)
+    volatile uint8_t  tail;         // ѭѹ黹İ (ɼ)
+    uint8_t           mode;         // RUN_packet_mode_t
+    uint8_t           state;        // 0: Ұͷ  1:   2: Ұβ  3: β
+    uint8_t           index;        // ǰдֽ
+    volatile uint32_t dropped;      // ȫ
+    volatile uint32_t overflow;     // 
+    RUN_frame_rx_t    frame;        // ֡ģʽĽ
+} uart_packet_t;
 
-// 2 
-char UART2_RxPacket[MAX_RX_LEN];
-uint8_t UART2_RxFlag = 0;
-
-// 3 
-char UART3_RxPacket[MAX_RX_LEN];
-uint8_t UART3_RxFlag = 0;
-
-// 4 
-char UART4_RxPacket[MAX_RX_LEN];
-uint8_t UART4_RxFlag = 0;
-
-// 5 
-char UART5_RxPacket[MAX_RX_LEN];
-uint8_t UART5_RxFlag = 0;
+static uart_packet_t uart_packet[5];    // USART1 / USART2 / USART3 / UART4 / UART5
 
 //-------------------------------------------------------------------------------------------------------------------
-//       1 ݰ (״̬)
+//       ݰ (״̬ڹ)
+// ˵      p               ڵĽ
 // ˵      data            յĵֽ
 // ز      void
-// ʹʾ      uart1_rx_interrupt(received_byte); // же
-// עϢ      Эʽͷ'@'β'\r\n'ɺλ UART1_RxFlag
+// עϢ      1. յ '@' ʱ (dropped++)ǰѭ
+//               2. ֱд建β '\0'
 //-------------------------------------------------------------------------------------------------------------------
-void uart1_rx_interrupt(uint8_t data)
+static void uart_packet_parse(uart_packet_t* p, uint8_t data)
 {
-    static uint8_t RxState = 0;
-    static uint8_t pRxIndex = 0;
+    char* buf = p->slot[p->head & (RUN_RX_SLOTS - 1)];
 
-    if (RxState == 0) // ״̬0ѰҰͷ
+    switch (p->state)
     {
-        if (data == '@' && UART1_RxFlag == 0)
-        {
-            RxState = 1;
-            pRxIndex = 0;
-            memset(UART1_RxPacket, 0, MAX_RX_LEN); // ջ
-        }
-    }
-    else if (RxState == 1) // ״̬1
-    {
-        if (data == '\r')
-        {
-            RxState = 2;
-        }
-        else
-        {
-            if (pRxIndex < MAX_RX_LEN - 1) // ֹ
+        case 0: // ѰҰͷ
+            if (data == '@')
             {
-                UART1_RxPacket[pRxIndex++] = data;
+                if ((uint8_t)(p->head - p->tail) >= RUN_RX_SLOTS)
+                {
+                    p->dropped++;
+                    p->state = 3;
+                }
+                else
+                {
+                    p->index = 0;
+                    p->state = 1;
+                }
             }
-        }
-    }
-    else if (RxState == 2) // ״̬2ѰҰβ
-    {
-        if (data == '\n')
-        {
-            RxState = 0;
-            UART1_RxPacket[pRxIndex] = '\0'; // ַ
-            UART1_RxFlag = 1;                // ǽ
-        }
-        else
-        {
-            RxState = 0; // ʽ󣬸λ״̬
-        }
+            break;
+
+        case 1: // 
+            if (data == '\r')
+            {
+                p->state = 2;
+            }
+            else if (p->index < MAX_RX_LEN - 1)
+            {
+                buf[p->index++] = (char)data;
+            }
+            else
+            {
+                p->overflow++;
+                p->state = 3;
+            }
+            break;
+
+        case 2: // ѰҰβ
+            p->state = 0;
+            if (data == '\n')
+            {
+                buf[p->index] = '\0';
+                p->len[p->head & (RUN_RX_SLOTS - 1)] = p->index;
+                p->head++;  // дٷ
+            }
+            break;
+
+        default: // β
+            if (data == '\n') p->state = 0;
+            break;
     }
 }
 
 //-------------------------------------------------------------------------------------------------------------------
-//       2 ݰ (״̬)
+//       ֡ (ڹ)
+// ˵      p               ڵĽ
 // ˵      data            յĵֽ
 // ز      void
-// ʹʾ      uart2_rx_interrupt(received_byte);
-// עϢ      Эʽͷ'@'β'\r\n'ɺλ UART2_RxFlag
+// עϢ      ֡ͷʱۣȫ֡ (dropped++)ֱд
 //-------------------------------------------------------------------------------------------------------------------
-void uart2_rx_interrupt(uint8_t data)
+static void uart_frame_parse(uart_packet_t* p, uint8_t data)
 {
-    static uint8_t RxState = 0;
-    static uint8_t pRxIndex = 0;
+    uint16_t n;
 
-    if (RxState == 0)
+    if (p->frame.state == 0 && data != 0x00)
     {
-        if (data == '@' && UART2_RxFlag == 0)
+        if ((uint8_t)(p->head - p->tail) >= RUN_RX_SLOTS)
         {
-            RxState = 1;
-            pRxIndex = 0;
-            memset(UART2_RxPacket, 0, MAX_RX_LEN);
-        }
-    }
-    else if (RxState == 1)
-    {
-        if (data == '\r')
-        {
-            RxState = 2;
+            p->frame.buf = 0;
+            p->dropped++;
         }
         else
         {
-            if (pRxIndex < MAX_RX_LEN - 1)
-            {
-                UART2_RxPacket[pRxIndex++] = data;
-            }
+            p->frame.buf = (uint8_t*)p->slot[p->head & (RUN_RX_SLOTS - 1)];
         }
     }
-    else if (RxState == 2)
+
+    n = RUN_frame_rx_byte(&p->frame, data);
+    if (n)
     {
-        if (data == '\n')
-        {
-            RxState = 0;
-            UART2_RxPacket[pRxIndex] = '\0';
-            UART2_RxFlag = 1;
-        }
-        else
-        {
-            RxState = 0;
-        }
+        p->len[p->head & (RUN_RX_SLOTS - 1)] = (uint8_t)n;
+        p->head++;
     }
 }
 
 //-------------------------------------------------------------------------------------------------------------------
-//       3 ݰ (״̬)
-// ˵      data            յĵֽ
-// ز      void
-// ʹʾ      uart3_rx_interrupt(received_byte);
-// עϢ      Эʽͷ'@'β'\r\n'ɺλ UART3_RxFlag
+// ڲ -> 
 //-------------------------------------------------------------------------------------------------------------------
-void uart3_rx_interrupt(uint8_t data)
+static uart_packet_t* uart_packet_get_ctx(UART_PIN_enum uart_pin)
 {
-    static uint8_t RxState = 0;
-    static uint8_t pRxIndex = 0;
-
-    if (RxState == 0)
-    {
-        if (data == '@' && UART3_RxFlag == 0)
-        {
-            RxState = 1;
-            pRxIndex = 0;
-            memset(UART3_RxPacket, 0, MAX_RX_LEN);
-        }
-    }
-    else if (RxState == 1)
-    {
-        if (data == '\r')
-        {
-            RxState = 2;
-        }
-        else
-        {
-            if (pRxIndex < MAX_RX_LEN - 1)
-            {
-                UART3_RxPacket[pRxIndex++] = data;
-            }
-        }
-    }
-    else if (RxState == 2)
-    {
-        if (data == '\n')
-        {
-            RxState = 0;
-            UART3_RxPacket[pRxIndex] = '\0';
-            UART3_RxFlag = 1;
-        }
-        else
-        {
-            RxState = 0;
-        }
-    }
+    USART_TypeDef* UARTx;
+
+    if (uart_pin >= UART_PIN_MAX) return 0;
+    UARTx = uart_cfg[uart_pin].uart_base;
+    if (UARTx == USART1) return &uart_packet[0];
+    if (UARTx == USART2) return &uart_packet[1];
+    if (UARTx == USART3) return &uart_packet[2];
+    if (UARTx == UART4)  return &uart_packet[3];
+    if (UARTx == UART5)  return &uart_packet[4];
+    return 0;
 }
 
 //-------------------------------------------------------------------------------------------------------------------
-//       4 ݰ (״̬)
-// ˵      data            յĵֽ
+//       лģʽ
+// ˵      uart_pin        ö
+// ˵      mode            RUN_PACKET_TEXT / RUN_PACKET_FRAME
 // ز      void
-// ʹʾ      uart4_rx_interrupt(received_byte);
-// עϢ      Эʽͷ'@'β'\r\n'ɺλ UART4_RxFlag
+// ʹʾ      RUN_uart_packet_mode(UART1_TX_PA9_RX_PA10, RUN_PACKET_FRAME);
+//               uint8_t n; uint8_t* f = (uint8_t*)RUN_uart_packet_get(UART1_TX_PA9_RX_PA10, &n);
+//               if (f && f[0] == 0x01 && n - 1 == sizeof(cmd)) memcpy(&cmd, f + 1, sizeof(cmd));
+// עϢ      ꡢδ黹İ֡ģʽµ֡ type + payload  MAX_RX_LEN - 2 ֽ
 //-------------------------------------------------------------------------------------------------------------------
-void uart4_rx_interrupt(uint8_t data)
+void RUN_uart_packet_mode(UART_PIN_enum uart_pin, RUN_packet_mode_t mode)
 {
-    static uint8_t RxState = 0;
-    static uint8_t pRxIndex = 0;
+    uart_packet_t* p = uart_packet_get_ctx(uart_pin);
+    uint32_t       primask;
+
+    if (p == 0) return;
+    primask = __get_PRIMASK();
+    __set_PRIMASK(1);
+    p->mode  = (uint8_t)mode;
+    p->state = 0;
+    RUN_frame_rx_init(&p->frame, 0, MAX_RX_LEN);
+    __set_PRIMASK(primask);
+}
 
-    if (RxState == 0)
-    {
-        if (data == '@' && UART4_RxFlag == 0)
-        {
-            RxState = 1;
-            pRxIndex = 0;
-            memset(UART4_RxPacket, 0, MAX_RX_LEN);
-        }
-    }
-    else if (RxState == 1)
-    {
-        if (data == '\r')
-        {
-            RxState = 2;
-        }
-        else
-        {
-            if (pRxIndex < MAX_RX_LEN - 1)
-            {
-                UART4_RxPacket[pRxIndex++] = data;
-            }
-        }
-    }
-    else if (RxState == 2)
-    {
-        if (data == '\n')
-        {
-            RxState = 0;
-            UART4_RxPacket[pRxIndex] = '\0';
-            UART4_RxFlag = 1;
-        }
-        else
-        {
-            RxState = 0;
-        }
-    }
+//-------------------------------------------------------------------------------------------------------------------
+//       ȡһ
+// ˵      uart_pin        ö
+// ˵      len             ݳ ( '\0'Ϊ NULL)
+// ز      char*            ( '\0' β)û° NULL
+// ʹʾ      char* cmd; uint8_t n;
+//               while ((cmd = RUN_uart_packet_get(UART1_TX_PA9_RX_PA10, &n)) != NULL) {
+//                   printf("Received: %s\r\n", cmd);
+//                   RUN_uart_packet_release(UART1_TX_PA9_RX_PA10);
+//               }
+//-------------------------------------------------------------------------------------------------------------------
+char* RUN_uart_packet_get(UART_PIN_enum uart_pin, uint8_t* len)
+{
+    uart_packet_t* p = uart_packet_get_ctx(uart_pin);
+    uint8_t        i;
+
+    if (p == 0 || p->tail == p->head) return 0;
+    i = p->tail & (RUN_RX_SLOTS - 1);
+    if (len) *len = p->len[i];
+    return p->slot[i];
 }
 
 //-------------------------------------------------------------------------------------------------------------------
-//       5 ݰ (״̬)
-// ˵      data            յĵֽ
+//       黹 RUN_uart_packet_get ȡİ
+// ˵      uart_pin        ö
 // ز      void
-// ʹʾ      uart5_rx_interrupt(received_byte);
-// עϢ      Эʽͷ'@'β'\r\n'ɺλ UART5_RxFlag
 //-------------------------------------------------------------------------------------------------------------------
-void uart5_rx_interrupt(uint8_t data)
+void RUN_uart_packet_release(UART_PIN_enum uart_pin)
 {
-    static uint8_t RxState = 0;
-    static uint8_t pRxIndex = 0;
+    uart_packet_t* p = uart_packet_get_ctx(uart_pin);
 
-    if (RxState == 0)
-    {
-        if (data == '@' && UART5_RxFlag == 0)
-        {
-            RxState = 1;
-            pRxIndex = 0;
-            memset(UART5_RxPacket, 0, MAX_RX_LEN);
-        }
-    }
-    else if (RxState == 1)
-    {
-        if (data == '\r')
-        {
-            RxState = 2;
-        }
-        else
-        {
-            if (pRxIndex < MAX_RX_LEN - 1)
-            {
-                UART5_RxPacket[pRxIndex++] = data;
-            }
-        }
-    }
-    else if (RxState == 2)
-    {
-        if (data == '\n')
-        {
-            RxState = 0;
-            UART5_RxPacket[pRxIndex] = '\0';
-            UART5_RxFlag = 1;
-        }
-        else
-        {
-            RxState = 0;
-        }
-    }
+    if (p && p->tail != p->head) p->tail++;
 }
 
-// ==========================================================
-//  (Weak) 
-// Щḁ̇̄ main.c ûдЩյġ
-//  main.c дͬЩͻᱻǣá
-// ==========================================================
+//-------------------------------------------------------------------------------------------------------------------
+//       ȡͳ
+// ˵      uart_pin        ö
+// ز      uint32_t        
+//-------------------------------------------------------------------------------------------------------------------
+uint32_t RUN_uart_packet_dropped(UART_PIN_enum uart_pin)
+{
+    uart_packet_t* p = uart_packet_get_ctx(uart_pin);
+    return p ? p->dropped : 0;
+}
 
-//__weak void uart1_rx_interrupt(uint8_t data) {}
-//__weak void uart2_rx_interrupt(uint8_t data) {}
-//__weak void uart3_rx_interrupt(uint8_t data) {}
-//__weak void uart4_rx_interrupt(uint8_t data) {}
-//__weak void uart5_rx_interrupt(uint8_t data) {}
+uint32_t RUN_uart_packet_overflow(UART_PIN_enum uart_pin)
+{
+    uart_packet_t* p = uart_packet_get_ctx(uart_pin);
+    return p ? p->overflow : 0;
+}
+
+uint32_t RUN_uart_packet_errors(UART_PIN_enum uart_pin)
+{
+    uart_packet_t* p = uart_packet_get_ctx(uart_pin);
+    return p ? p->frame.crc_error + p->frame.format_error : 0;
+}
 
 // ==========================================================
 // жϷ (IRQ)
 // ӲԶԶĺ
 // ==========================================================
 
+//-------------------------------------------------------------------------------------------------------------------
+//       жϹ (ڹ)
+// ˵      UARTx           
+// ˵      p               ôڵĽ
+// ز      void
+// עϢ      ȴ DMA ģʽ IDLE ¼ټ RXNE ־λģʽý־λ
+//-------------------------------------------------------------------------------------------------------------------
+static void uart_irq_handler(USART_TypeDef* UARTx, uart_packet_t* p)
+{
+    RUN_uart_rx_dma_irq(UARTx);
+    if(USART_GetITStatus(UARTx, USART_IT_RXNE) != RESET)
+    {
+        uint8_t data = (uint8_t)USART_ReceiveData(UARTx);
+        if (p->mode == RUN_PACKET_FRAME) uart_frame_parse(p, data);
+        else                             uart_packet_parse(p, data);
+        USART_ClearITPendingBit(UARTx, USART_IT_RXNE);
+    }
+}
+
 //-------------------------------------------------------------------------------------------------------------------
 //       USART1 ȫжϷ
 // ˵      void
 // ز      void
 // ʹʾ      (Hardware Triggered)
-// עϢ       RXNE ־λý־λ
+// עϢ       uart_irq_handler
 //-------------------------------------------------------------------------------------------------------------------
 void USART1_IRQHandler(void)
 {
-    if(USART_GetITStatus(USART1, USART_IT_RXNE) != RESET)
-    {
-        // ûĺû˵Ļ
-        uart1_rx_interrupt((uint8_t)USART_ReceiveData(USART1));
-        USART_ClearITPendingBit(USART1, USART_IT_RXNE);
-    }
+    uart_irq_handler(USART1, &uart_packet[0]);
 }
 
 //-------------------------------------------------------------------------------------------------------------------
@@ -316,15 +257,11 @@ void USART1_IRQHandler(void)
 // ˵      void
 // ز      void
 // ʹʾ      (Hardware Triggered)
-// עϢ       RXNE ־λý־λ
+// עϢ       uart_irq_handler
 //-------------------------------------------------------------------------------------------------------------------
 void USART2_IRQHandler(void)
 {
-    if(USART_GetITStatus(USART2, USART_IT_RXNE) != RESET)
-    {
-        uart2_rx_interrupt((uint8_t)USART_ReceiveData(USART2));
-        USART_ClearITPendingBit(USART2, USART_IT_RXNE);
-    }
+    uart_irq_handler(USART2, &uart_packet[1]);
 }
 
 //-------------------------------------------------------------------------------------------------------------------
@@ -332,15 +269,11 @@ void USART2_IRQHandler(void)
 // ˵      void
 // ز      void
 // ʹʾ      (Hardware Triggered)
-// עϢ       RXNE ־λý־λ
+// עϢ       uart_irq_handler
 //-------------------------------------------------------------------------------------------------------------------
 void USART3_IRQHandler(void)
 {
-    if(USART_GetITStatus(USART3, USART_IT_RXNE) != RESET)
-    {
-        uart3_rx_interrupt((uint8_t)USART_ReceiveData(USART3));
-        USART_ClearITPendingBit(USART3, USART_IT_RXNE);
-    }
+    uart_irq_handler(USART3, &uart_packet[2]);
 }
 
 //-------------------------------------------------------------------------------------------------------------------
@@ -348,15 +281,11 @@ void USART3_IRQHandler(void)
 // ˵      void
 // ز      void
 // ʹʾ      (Hardware Triggered)
-// עϢ       RXNE ־λý־λ
+// עϢ       uart_irq_handler
 //-------------------------------------------------------------------------------------------------------------------
 void UART4_IRQHandler(void)
 {
-    if(USART_GetITStatus(UART4, USART_IT_RXNE) != RESET)
-    {
-        uart4_rx_interrupt((uint8_t)USART_ReceiveData(UART4));
-        USART_ClearITPendingBit(UART4, USART_IT_RXNE);
-    }
+    uart_irq_handler(UART4, &uart_packet[3]);
 }
 
 //-------------------------------------------------------------------------------------------------------------------
@@ -364,15 +293,11 @@ void UART4_IRQHandler(void)
 // ˵      void
 // ز      void
 // ʹʾ      (Hardware Triggered)
-// עϢ       RXNE ־λý־λ
+// עϢ       uart_irq_handler
 //-------------------------------------------------------------------------------------------------------------------
 void UART5_IRQHandler(void)
 {
-    if(USART_GetITStatus(UART5, USART_IT_RXNE) != RESET)
-    {
-        uart5_rx_interrupt((uint8_t)USART_ReceiveData(UART5));
-        USART_ClearITPendingBit(UART5, USART_IT_RXNE);
-    }
+    uart_irq_handler(UART5, &uart_packet[4]);
 }
 
 // ==========================================================
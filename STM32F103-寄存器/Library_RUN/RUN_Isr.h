@@ -1,29 +1,38 @@
 #ifndef _RUN_ISR_H_
 #define _RUN_ISR_H_
 
-/* ֹֽ */
+#include "stm32f10x.h"
+#include "RUN_UART.h"
+
+/* ֽ (β '\0')İ */
 #define MAX_RX_LEN  100  
 
-/* --- ȫֱ --- */
-// 1 
-extern char UART1_RxPacket[MAX_RX_LEN];
-extern uint8_t UART1_RxFlag;
+/* ÿڵİ ( 2 )жһ۾ͻһѭٹ黹 */
+#ifndef RUN_RX_SLOTS
+#define RUN_RX_SLOTS  4
+#endif
 
-// 2 
-extern char UART2_RxPacket[MAX_RX_LEN];
-extern uint8_t UART2_RxFlag;
+/* --- ڰ --- */
+// ıģʽ (Ĭ)@ +  + \r\n '\0' β
+// ֡ģʽCOBS + CRC-16 ֡ ( RUN_Frame.h)Ϊ type + payloadCRC ֱ֡Ӷ
+typedef enum {
+    RUN_PACKET_TEXT  = 0,
+    RUN_PACKET_FRAME = 1
+} RUN_packet_mode_t;
 
+// лģʽ (ᶪڽյİ)
+void     RUN_uart_packet_mode(UART_PIN_enum uart_pin, RUN_packet_mode_t mode);
 
-// 3 
-extern char UART3_RxPacket[MAX_RX_LEN];
-extern uint8_t UART3_RxFlag;
+// ȡյһ (㿽ֱָ)ûз NULL
+//  RUN_uart_packet_release 黹黹ǰݲᱻ
+char*    RUN_uart_packet_get(UART_PIN_enum uart_pin, uint8_t* len);
+void     RUN_uart_packet_release(UART_PIN_enum uart_pin);
 
-// 4 
-extern char UART4_RxPacket[MAX_RX_LEN];
-extern uint8_t UART4_RxFlag;
+// ͳƣȫʱİ /  MAX_RX_LEN İ
+uint32_t RUN_uart_packet_dropped(UART_PIN_enum uart_pin);
+uint32_t RUN_uart_packet_overflow(UART_PIN_enum uart_pin);
 
-// 5 
-extern char UART5_RxPacket[MAX_RX_LEN];
-extern uint8_t UART5_RxFlag;
+// ͳƣ֡ģʽ CRC  / ʽ֡
+uint32_t RUN_uart_packet_errors(UART_PIN_enum uart_pin);
 
-#endif
\ No newline at end of file
+#endif
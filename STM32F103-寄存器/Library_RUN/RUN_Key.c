@@ -0,0 +1,255 @@
+#include "RUN_Key.h"
+#include <string.h>
+
+// ==============================================================================
+// ȫֱ
+// ==============================================================================
+
+// ÿ˿һ״̬ (λ i Ӧö˿ڵĵ i ţ1 = )
+typedef struct {
+    GPIO_TypeDef* port;
+    uint16_t      mask;         // Ϊ
+    uint16_t      invert;       // ͵ƽЧ ( IDR ȡ)
+    uint16_t      state;        // ״̬
+    uint16_t      ct0, ct1;     // ֱλ / λ
+    uint16_t      long_sent;    // ΰѾ
+} key_port_t;
+
+static key_port_t key_ports[7];                 // GPIOA ~ GPIOG
+static uint8_t    key_port_num = 0;             // õĶ˿ (key_ports ǰ key_port_num Ч)
+
+static uint8_t    key_pins[RUN_KEY_MAX];        //  (ʱ)
+static uint32_t   key_down_tick[RUN_KEY_MAX];   // ʱ (tick)
+static uint8_t    key_num = 0;
+
+static uint16_t   key_tick_ms  = 1;
+static uint32_t   key_long_tick = 0;            // ֵ (tick)0 = ر
+static volatile uint32_t key_ticks = 0;
+
+//  (ʱж) /  (ѭ) У
+// head ֻждtail ֻѭд߶Ҫж
+static RUN_key_event_t   key_queue[RUN_KEY_QUEUE_LEN];
+static volatile uint8_t  key_head = 0;
+static volatile uint8_t  key_tail = 0;
+static volatile uint32_t key_drop = 0;
+
+// ==============================================================================
+// ڲ
+// ==============================================================================
+
+//-------------------------------------------------------------------------------------------------------------------
+// ڲдһ¼ (же)
+//-------------------------------------------------------------------------------------------------------------------
+static void key_push(uint8_t pin, uint8_t type)
+{
+    uint8_t head = key_head;
+    uint8_t next = (uint8_t)((head + 1) & (RUN_KEY_QUEUE_LEN - 1));
+
+    if (next == key_tail)
+    {
+        key_drop++;
+        return;
+    }
+    key_queue[head].pin     = pin;
+    key_queue[head].type    = type;
+    key_queue[head].time_ms = key_ticks * key_tick_ms;
+    key_head = next;    // дƶ headѭ head ʱһѾ
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// ڲ ->  (δ÷ 0xFF)
+//-------------------------------------------------------------------------------------------------------------------
+static uint8_t key_slot(uint8_t pin)
+{
+    uint8_t i;
+    for (i = 0; i < key_num; i++)
+    {
+        if (key_pins[i] == pin) return i;
+    }
+    return 0xFF;
+}
+
+// ==============================================================================
+// ӿں
+// ==============================================================================
+
+//-------------------------------------------------------------------------------------------------------------------
+//       ʼ
+// ˵      table           ñ
+// ˵      num             
+// ˵      tick_ms         RUN_key_scan ĵ ()
+// ˵      long_ms         ʱ ()0 = 
+// ز      uint8_t         1: ɹ  0: 
+// ʹʾ      static const RUN_key_cfg_t keys[] = {
+//                   {A0, GPI_PD, 1},    // KEY_UPΪ
+//                   {E3, GPI_PU, 0},    // KEY1½ӵ
+//                   {E4, GPI_PU, 0},    // KEY0
+//               };
+//               RUN_key_init(keys, 3, 5, 1000);
+//               RUN_timer_init(RUN_TIM6, 5);
+// עϢ      ʼʱԵǰƽΪ״̬ϵʱѰסļᱨ PRESS
+//-------------------------------------------------------------------------------------------------------------------
+uint8_t RUN_key_init(const RUN_key_cfg_t* table, uint8_t num, uint16_t tick_ms, uint16_t long_ms)
+{
+    uint8_t i, j;
+
+    if (table == 0 || num == 0 || num > RUN_KEY_MAX || tick_ms == 0) return 0;
+    for (i = 0; i < num; i++)
+    {
+        if (table[i].pin >= RUN_GPIO_MAX) return 0;
+    }
+
+    memset(key_ports, 0, sizeof(key_ports));
+    key_port_num  = 0;
+    key_num       = num;
+    key_tick_ms   = tick_ms;
+    key_long_tick = (long_ms + tick_ms - 1) / tick_ms;
+    key_ticks     = 0;
+    key_head = key_tail = 0;
+    key_drop = 0;
+
+    // 1. ţ˿ڹ
+    for (i = 0; i < num; i++)
+    {
+        GPIO_TypeDef* port = RUN_GPIO_PORT(table[i].pin);
+        uint16_t      bit  = RUN_GPIO_MASK(table[i].pin);
+
+        RUN_gpio_init(table[i].pin, table[i].mode, 0);
+        key_pins[i]      = (uint8_t)table[i].pin;
+        key_down_tick[i] = 0;
+
+        for (j = 0; j < key_port_num; j++)
+        {
+            if (key_ports[j].port == port) break;
+        }
+        if (j == key_port_num) key_ports[key_port_num++].port = port;
+
+        key_ports[j].mask |= bit;
+        if (table[i].active_level == 0) key_ports[j].invert |= bit;
+    }
+
+    // 2. ǰƽΪʼ״̬Ϊ (ȫ 1)
+    for (j = 0; j < key_port_num; j++)
+    {
+        key_port_t* p = &key_ports[j];
+        p->state     = (uint16_t)((p->port->IDR ^ p->invert) & p->mask);
+        p->ct0       = 0xFFFF;
+        p->ct1       = 0xFFFF;
+        p->long_sent = p->state;
+    }
+    return 1;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       ɨһ
+// ˵      void
+// ز      void
+// ʹʾ      void TIM6_Callback(void) { RUN_key_scan(); }
+// עϢ      1. ÿ˿ֻһ IDR16 ͬʱû״̬仯ʱκѭ
+//               2. ֱÿλһ 2 λ״̬ͬͼһ
+//                  ͬͻص 3 ( 4 βͬ) ŷת״̬
+//-------------------------------------------------------------------------------------------------------------------
+void RUN_key_scan(void)
+{
+    uint8_t  j, i;
+    uint32_t now = ++key_ticks;
+
+    for (j = 0; j < key_port_num; j++)
+    {
+        key_port_t* p = &key_ports[j];
+        uint16_t raw     = (uint16_t)((p->port->IDR ^ p->invert) & p->mask);
+        uint16_t changed = p->state ^ raw;
+        uint16_t base    = (uint16_t)(((uint32_t)p->port - GPIOA_BASE) / 0x400 * 16);
+
+        // 2 λֱ
+        p->ct0 = ~(p->ct0 & changed);
+        p->ct1 = p->ct0 ^ (p->ct1 & changed);
+        changed &= p->ct0 & p->ct1;
+        p->state ^= changed;
+
+        // ״̬ת¼ (ͨһֻһ)
+        while (changed)
+        {
+            uint8_t bit  = 0;
+            uint16_t m;
+            while (!(changed & (1u << bit))) bit++;
+            m = (uint16_t)(1u << bit);
+            changed &= ~m;
+
+            if (p->state & m)
+            {
+                key_push((uint8_t)(base + bit), RUN_KEY_PRESS);
+                i = key_slot((uint8_t)(base + bit));
+                if (i != 0xFF) key_down_tick[i] = now;
+                p->long_sent &= ~m;
+            }
+            else
+            {
+                key_push((uint8_t)(base + bit), RUN_KEY_RELEASE);
+                p->long_sent |= m;
+            }
+        }
+
+        // ֻ԰סһûļ
+        if (key_long_tick && (p->state & ~p->long_sent))
+        {
+            uint16_t pending = p->state & ~p->long_sent;
+            for (i = 0; i < key_num; i++)
+            {
+                uint8_t pin = key_pins[i];
+                if (pin < base || pin >= base + 16) continue;
+                if (!(pending & (1u << (pin - base)))) continue;
+                if (now - key_down_tick[i] >= key_long_tick)
+                {
+                    key_push(pin, RUN_KEY_LONG);
+                    p->long_sent |= (uint16_t)(1u << (pin - base));
+                }
+            }
+        }
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       ȡһ¼
+// ˵      event           ¼
+// ز      uint8_t         1: ȡ  0: п
+// ʹʾ      RUN_key_event_t ev;
+//               while (RUN_key_get_event(&ev)) {
+//                   if (ev.pin == E3 && ev.type == RUN_KEY_PRESS) ...
+//               }
+//-------------------------------------------------------------------------------------------------------------------
+uint8_t RUN_key_get_event(RUN_key_event_t* event)
+{
+    uint8_t tail = key_tail;
+
+    if (tail == key_head) return 0;
+    *event   = key_queue[tail];
+    key_tail = (uint8_t)((tail + 1) & (RUN_KEY_QUEUE_LEN - 1));   // ͷŲλ
+    return 1;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       ѯ״̬
+// ˵      pin             
+// ز      uint8_t         1:   0: ɿ / δ
+//-------------------------------------------------------------------------------------------------------------------
+uint8_t RUN_key_is_down(RUN_GPIO_enum pin)
+{
+    uint8_t j;
+    if (pin >= RUN_GPIO_MAX) return 0;
+
+    for (j = 0; j < key_port_num; j++)
+    {
+        if (key_ports[j].port == RUN_GPIO_PORT(pin)) return (key_ports[j].state & RUN_GPIO_MASK(pin)) ? 1 : 0;
+    }
+    return 0;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       ȡ¼
+// ز      uint32_t        
+//-------------------------------------------------------------------------------------------------------------------
+uint32_t RUN_key_dropped(void)
+{
+    return key_drop;
+}
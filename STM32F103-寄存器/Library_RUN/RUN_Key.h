@@ -0,0 +1,73 @@
+#ifndef _RUN_KEY_H_
+#define _RUN_KEY_H_
+
+#include "stm32f10x.h"
+#include "RUN_Gpio.h"
+
+// ==========================================================
+//  / λ ¼
+// ----------------------------------------------------------
+// һʱж RUN_key_scan()ÿõĶ˿ֻһ IDR
+// "ֱ" 16 ͬʱ (ÿһ 2 λ
+//  ct0/ct1  16 λ֣λм) 4 βһ²Žܡ
+// ״̬仯 /ɿ/ ¼ + ʱ дУѭȡ
+// ==========================================================
+
+#define RUN_KEY_MAX         16      // ఴ
+#define RUN_KEY_QUEUE_LEN   32      // ¼г ( 2 )
+
+// ¼
+typedef enum {
+    RUN_KEY_PRESS   = 0,    //  ()
+    RUN_KEY_RELEASE = 1,    // ɿ ()
+    RUN_KEY_LONG    = 2     // סʱ (ÿΰֻһ)
+} RUN_key_event_type_t;
+
+// ¼
+typedef struct {
+    uint8_t  pin;           //  (RUN_GPIO_enum)
+    uint8_t  type;          // RUN_key_event_type_t
+    uint32_t time_ms;       // ʱ ( RUN_key_init ĺ)
+} RUN_key_event_t;
+
+// 
+typedef struct {
+    RUN_GPIO_enum pin;          // 
+    RUN_GPIO_Mode mode;         // ģʽ (GPI / GPI_PU / GPI_PD)
+    uint8_t       active_level; // ʱĵƽ (ӵΪ 0)
+} RUN_key_cfg_t;
+
+// ==========================================================
+// 
+// ==========================================================
+
+/**
+ * @brief  ʼ
+ * @param  table:   ñ
+ * @param  num:      (1 ~ RUN_KEY_MAX)
+ * @param  tick_ms: RUN_key_scan ĵ ()ʱ = 4 * tick_ms
+ * @param  long_ms: жʱ ()0 ʾⳤ
+ * @return 1: ɹ  0: 
+ */
+uint8_t RUN_key_init(const RUN_key_cfg_t* table, uint8_t num, uint16_t tick_ms, uint16_t long_ms);
+
+/**
+ * @brief  ɨһ (ڶʱصе)
+ * ʹʾRUN_timer_init(RUN_TIM6, 5);
+ *          void TIM6_Callback(void) { RUN_key_scan(); }
+ */
+void RUN_key_scan(void);
+
+/**
+ * @brief  ȡһ¼ (ѭ)
+ * @return 1: ȡ  0: п
+ */
+uint8_t RUN_key_get_event(RUN_key_event_t* event);
+
+// ѯ״̬ (1: )
+uint8_t RUN_key_is_down(RUN_GPIO_enum pin);
+
+// ¼
+uint32_t RUN_key_dropped(void);
+
+#endif
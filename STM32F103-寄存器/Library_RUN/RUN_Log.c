@@ -0,0 +1,128 @@
+#include "RUN_Log.h"
+
+// ==============================================================================
+// ȫֱ
+// ==============================================================================
+
+// ¼ʽͷ = ( << 24) | (ʽַ 24 λ)
+// (Flash  0x08000000  16MB ڣ 24 λ֣˲ظ 8 λ)
+static uint32_t          log_ring[RUN_LOG_RING];
+static volatile uint32_t log_wr = 0;        // д (֣ɼ)
+static volatile uint32_t log_rd = 0;        //  (ֻ֣ RUN_log_poll )
+static volatile uint32_t log_drop = 0;
+static uint32_t          log_drop_sent = 0; // ѾԶ˵Ķ
+static UART_PIN_enum     log_uart = (UART_PIN_enum)0;
+
+// ֡ǰ෢һ 0x00ͬһ printf ıûнβ 0x00ָ
+// Զ˻ǰı־֡ͬһΣ COBS ⲻ
+#define LOG_FRAME_MAX(n)    (1 + RUN_FRAME_ENCODED_MAX(n))
+
+//-------------------------------------------------------------------------------------------------------------------
+// ڲָ֡һ룬һд뷢ͻ
+//-------------------------------------------------------------------------------------------------------------------
+static void log_frame_send(uint8_t type, const void* payload, uint16_t len)
+{
+    uint8_t buf[LOG_FRAME_MAX((RUN_LOG_MAX_ARGS + 1) * 4)];
+
+    buf[0] = 0x00;
+    RUN_uart_write_buffered(log_uart, buf, (uint16_t)(1 + RUN_frame_encode(type, payload, len, buf + 1)));
+}
+
+// ==============================================================================
+// ӿں
+// ==============================================================================
+
+//-------------------------------------------------------------------------------------------------------------------
+//       ָ־
+// ˵      uart_pin        ö ( RUN_uart_init)
+// ز      void
+// ʹʾ      RUN_uart_init(UART1_TX_PA9_RX_PA10, 921600, 0);
+//               RUN_uart_tx_dma_init(UART1_TX_PA9_RX_PA10, NULL);
+//               RUN_log_init(UART1_TX_PA9_RX_PA10);
+//-------------------------------------------------------------------------------------------------------------------
+void RUN_log_init(UART_PIN_enum uart_pin)
+{
+    log_uart = uart_pin;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       дһ־¼
+// ˵      rec             rec[0] ΪʽַΪ 32 λ
+// ˵      n               
+// ز      uint8_t         1: ɹ  0: 
+// ʹʾ      RUN_LOG("adc=%u t=%f\r\n", adc, RUN_LOG_F(temp));
+// עϢ      ֻֿжϺѭͬʱʹ
+//-------------------------------------------------------------------------------------------------------------------
+uint8_t RUN_log_write(const uint32_t* rec, uint8_t n)
+{
+    uint32_t primask, wr;
+    uint8_t  i;
+
+    if (n == 0 || n > RUN_LOG_MAX_ARGS + 1) return 0;
+
+    primask = __get_PRIMASK();
+    __set_PRIMASK(1);
+    wr = log_wr;
+    if (RUN_LOG_RING - (wr - log_rd) < n)
+    {
+        log_drop++;
+        __set_PRIMASK(primask);
+        return 0;
+    }
+    log_ring[wr & (RUN_LOG_RING - 1)] = ((uint32_t)(n - 1) << 24) | (rec[0] & 0x00FFFFFF);
+    for (i = 1; i < n; i++)
+    {
+        log_ring[(wr + i) & (RUN_LOG_RING - 1)] = rec[i];
+    }
+    log_wr = wr + n;
+    __set_PRIMASK(primask);
+    return 1;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       ־
+// ˵      void
+// ز      uint16_t        ηļ¼
+// ʹʾ      while (1) { ...; RUN_log_poll(); }
+// עϢ      ÿ¼һ֡ (RUN_Frameǰһ 0x00 ָ)ͻռ䲻ͣ£´ٷ
+//-------------------------------------------------------------------------------------------------------------------
+uint16_t RUN_log_poll(void)
+{
+    uint32_t rec[RUN_LOG_MAX_ARGS + 1];
+    uint16_t sent = 0;
+    uint32_t rd   = log_rd;
+
+    // 1. ȱĶ
+    if (log_drop != log_drop_sent && RUN_uart_tx_room(log_uart) >= LOG_FRAME_MAX(4))
+    {
+        log_drop_sent = log_drop;
+        log_frame_send(RUN_LOG_DROP_TYPE, &log_drop_sent, 4);
+    }
+
+    // 2. ֡
+    while (rd != log_wr)
+    {
+        uint8_t n = (uint8_t)((log_ring[rd & (RUN_LOG_RING - 1)] >> 24) + 1);
+        uint8_t i;
+
+        if (RUN_uart_tx_room(log_uart) < LOG_FRAME_MAX(n * 4)) break;
+        for (i = 0; i < n; i++)
+        {
+            rec[i] = log_ring[(rd + i) & (RUN_LOG_RING - 1)];
+        }
+        rd    += n;
+        log_rd = rd;    // ڳռٷ
+        log_frame_send(RUN_LOG_FRAME_TYPE, rec, (uint16_t)(n * 4));
+        sent++;
+    }
+    return sent;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       ȡļ¼
+// ز      uint32_t        
+//-------------------------------------------------------------------------------------------------------------------
+uint32_t RUN_log_dropped(void)
+{
+    return log_drop;
+}
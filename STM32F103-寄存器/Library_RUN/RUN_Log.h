@@ -0,0 +1,71 @@
+#ifndef _RUN_LOG_H_
+#define _RUN_LOG_H_
+
+#include "stm32f10x.h"
+#include "RUN_UART.h"
+#include "RUN_Frame.h"
+
+// ==========================================================
+// ӳٸʽ־
+// ----------------------------------------------------------
+// RUN_LOG("speed=%d err=%f\r\n", v, RUN_LOG_F(e)) ڵƬϸʽ
+// ֻ ʽַ + ԭʼ (ÿ 32 λ) д RAM  (жϼʮڣж)
+// ѭ RUN_log_poll() Ѽ¼ɶ֡ (RUN_Frametype = RUN_LOG_FRAME_TYPE֡ǰ 0x00) Ӵڷ
+// Զ Host/RUN_log_decode.py ݹ̼ .axf (ELF) ĸʽԭı
+//
+// 
+//    / ַ / ָ      ֱӴ (%d %u %x %c %p)
+//   float                    RUN_LOG_F(x) һ (%f %e %g)ᱻضϳ
+//   const ַ ( Flash)  %s˴ ELF RAM ַ޷ԭ
+// ==========================================================
+
+#ifndef RUN_LOG_RING
+#define RUN_LOG_RING        256         // ־С (32 λ֣ 2 )
+#endif
+#define RUN_LOG_MAX_ARGS    8           // ÿ
+#define RUN_LOG_FRAME_TYPE  0x7F        // ־¼֡
+#define RUN_LOG_DROP_TYPE   0x7E        // ֡ (payload: uint32_t ۼƶ)
+
+// float λ (κθ)
+static __INLINE uint32_t RUN_LOG_F(float x)
+{
+    union { float f; uint32_t u; } v;
+    v.f = x;
+    return v.u;
+}
+
+// ¼һ־ (ʽַ)
+#define RUN_LOG(fmt, ...)                                                               \
+    do {                                                                                \
+        static const char run_log_fmt[] = fmt;                                          \
+        const uint32_t run_log_rec[] = {(uint32_t)run_log_fmt, __VA_ARGS__};            \
+        RUN_log_write(run_log_rec, (uint8_t)(sizeof(run_log_rec) / sizeof(uint32_t)));  \
+    } while (0)
+
+// ==========================================================
+// 
+// ==========================================================
+
+/**
+ * @brief  ָ־ ( RUN_uart_tx_dma_init;Ͳռ CPU)
+ */
+void     RUN_log_init(UART_PIN_enum uart_pin);
+
+/**
+ * @brief  дһ¼ (һͨ RUN_LOG )
+ * @param  rec: rec[0] ΪʽַΪ
+ * @param  n:   rec  (1 ~ RUN_LOG_MAX_ARGS + 1)
+ * @return 1: ɹ  0: 
+ */
+uint8_t  RUN_log_write(const uint32_t* rec, uint8_t n);
+
+/**
+ * @brief  ѻļ¼ (ѭ)ͻŲʱ´Σ
+ * @return ηļ¼
+ */
+uint16_t RUN_log_poll(void);
+
+// ļ¼
+uint32_t RUN_log_dropped(void);
+
+#endif
@@ -0,0 +1,375 @@
+#include "RUN_Logic.h"
+#include <string.h>
+
+//
+// ͨ·TIMx ¼ --(DMA )--> DMA ͨ --(APB2)--> GPIOx->IDR --> buf[]
+//
+// λ""ʾlaps * depth + (depth - CNDTR)
+// ȴʱ DMA Ϊѭģʽ stop_pos
+// һڵǰһȦڣ DMA رյļͨĳ
+// ģʽӵǰλðᵽ stop_pos TC жβ
+// ʱ DMA һֱֵͨӦԸдڼ䲻
+// (ֻҪرմڶһ)
+
+// ==============================================================================
+// ȫֱ
+// ==============================================================================
+static RUN_logic_t* logic_active = 0;  // EXTI صסǰڵȴĶ
+
+// ==============================================================================
+// ڲ
+// ==============================================================================
+
+//-------------------------------------------------------------------------------------------------------------------
+// ڲȡǰдλ
+// ѾƵ TC жϻûüֱӰѱ־ԵȦ֮ظ
+//-------------------------------------------------------------------------------------------------------------------
+static uint32_t logic_position(RUN_logic_t* la)
+{
+    uint16_t left = (uint16_t)la->dma->CNDTR;
+
+    if ((la->dma->CCR & DMA_CCR1_CIRC) && (RUN_DMA_GetFlags(la->dma) & RUN_DMA_IT_TC))
+    {
+        RUN_DMA_ClearFlags(la->dma, RUN_DMA_IT_TC);
+        if (la->state != RUN_LOGIC_ARMED || la->laps == 0) la->laps++;
+        left = (uint16_t)la->dma->CNDTR;   // ֵ֮
+    }
+
+    return (uint32_t)la->laps * la->depth + (la->depth - left);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// ڲֹͣɼ
+//-------------------------------------------------------------------------------------------------------------------
+static void logic_finish(RUN_logic_t* la, uint32_t end)
+{
+    TIM_TypeDef* TIMx = timer_cfg[la->tim].tim_base;
+    uint32_t base;
+    uint16_t k, n;
+
+    RUN_timer_cmd(la->tim, DISABLE);
+    TIMx->DIER &= ~TIM_DIER_UDE;
+    RUN_DMA_Disable(la->dma);
+    if (la->trig_line) EXTI->IMR &= ~la->trig_line;
+    if (logic_active == la) logic_active = 0;
+
+    la->stop_pos = end;
+    la->count    = (end >= la->depth) ? la->depth : (uint16_t)end;
+    la->first    = (end >= la->depth) ? (uint16_t)(end % la->depth) : 0;
+
+    base = end - la->count;
+    la->trig = (la->trig_pos > base) ? (uint16_t)(la->trig_pos - base) : 0;
+    if (la->trig >= la->count) la->trig = la->count - 1;
+
+    // жӦҪڣ߲ trig_pos ʵ 1~2 
+    // ڱ˿ʱһȷ
+    if (la->trig_mask)
+    {
+        for (k = la->trig, n = 0; k > 0 && n < RUN_LOGIC_TRIG_SEARCH; k--, n++)
+        {
+            uint16_t now  = RUN_logic_sample(la, k) & la->trig_mask;
+            uint16_t prev = RUN_logic_sample(la, k - 1) & la->trig_mask;
+
+            if (now == prev) continue;
+            if (la->trig_edge == EXTI_Trigger_Rising  && !now) continue;
+            if (la->trig_edge == EXTI_Trigger_Falling &&  now) continue;
+            la->trig = k;
+            break;
+        }
+    }
+
+    la->state = RUN_LOGIC_DONE;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// ڲڵǰһȦʱѭ DMA ĳɵ DMA ͣ stop_pos
+//-------------------------------------------------------------------------------------------------------------------
+static void logic_retarget(RUN_logic_t* la)
+{
+    DMA_Channel_TypeDef* dma = la->dma;
+    uint32_t pos;
+    uint16_t idx;
+
+    pos = logic_position(la);
+    if (la->stop_pos > (uint32_t)(la->laps + 1) * la->depth) return;   // һȦȻ
+
+    dma->CCR &= ~DMA_CCR1_EN;                  // дλ (Ķʱ豣)
+    pos = logic_position(la);
+    if (pos >= la->stop_pos)
+    {
+        logic_finish(la, pos);                 // ж̫Ѿˣֱӽ
+        return;
+    }
+
+    idx = (uint16_t)(pos - (uint32_t)la->laps * la->depth);
+    dma->CCR  &= ~DMA_CCR1_CIRC;
+    dma->CMAR  = (uint32_t)&la->buf[idx];
+    dma->CNDTR = la->stop_pos - pos;
+    dma->CCR  |= DMA_CCR1_EN;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// ڲDMA жϻص (ctx Ϊ߼Ƕ)
+//-------------------------------------------------------------------------------------------------------------------
+static void logic_dma_callback(uint8_t flags, void* ctx)
+{
+    RUN_logic_t* la = (RUN_logic_t*)ctx;
+
+    if (la->dma == 0) return;
+    if (flags & RUN_DMA_IT_TE)
+    {
+        RUN_logic_abort(la);
+        return;
+    }
+    if (!(flags & RUN_DMA_IT_TC)) return;
+
+    if (!(la->dma->CCR & DMA_CCR1_CIRC))
+    {
+        logic_finish(la, la->stop_pos);        // ζΰ꣬ͣڽ
+        return;
+    }
+
+    if (la->state != RUN_LOGIC_ARMED || la->laps == 0) la->laps++;
+    if (la->state == RUN_LOGIC_POST) logic_retarget(la);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// ڲEXTI ص
+//-------------------------------------------------------------------------------------------------------------------
+static void logic_trigger_isr(void)
+{
+    RUN_logic_t* la = logic_active;
+
+    if (la == 0 || la->dma == 0 || la->state != RUN_LOGIC_ARMED) return;
+
+    EXTI->IMR &= ~la->trig_line;               // ֻһ
+    la->trig_pos = logic_position(la);
+    la->stop_pos = la->trig_pos + (la->depth - la->pre);
+    la->state    = RUN_LOGIC_POST;
+    logic_retarget(la);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// ڲʮ / ʮл
+//-------------------------------------------------------------------------------------------------------------------
+static uint8_t logic_put_hex4(char* p, uint16_t v)
+{
+    static const char hex[] = "0123456789ABCDEF";
+    p[0] = hex[(v >> 12) & 0xF];
+    p[1] = hex[(v >> 8) & 0xF];
+    p[2] = hex[(v >> 4) & 0xF];
+    p[3] = hex[v & 0xF];
+    return 4;
+}
+
+static uint8_t logic_put_dec(char* p, uint32_t v)
+{
+    char tmp[10];
+    uint8_t n = 0, i;
+
+    do { tmp[n++] = (char)('0' + v % 10); v /= 10; } while (v);
+    for (i = 0; i < n; i++) p[i] = tmp[n - 1 - i];
+    return n;
+}
+
+// ==============================================================================
+// ӿں
+// ==============================================================================
+
+//-------------------------------------------------------------------------------------------------------------------
+//       ʼ߼
+// ˵      la              ߼Ƕ
+// ˵      tim_n           ʱ
+// ˵      port            ˿ (GPIOA ~ GPIOG)
+// ˵      rate_hz          (Hz)
+// ˵      buf             
+// ˵      depth            ()
+// ز      uint32_t        ʵʲ (Hz)ʧ ( / DMA ͨռ)  0
+// ʹʾ      static uint16_t la_buf[4096];
+//               RUN_logic_init(&la, RUN_TIM6, GPIOB, 2000000, la_buf, 4096); // 2MS/s  PB 
+// עϢ      1. ʱ¼ DMA  timer_cfg[]ʼʱ RUN_DMA_Alloc ռøͨ
+//               2. 72MHz  DMA  APB2 Լ 5~6 һΣʵԼ 4~6MS/s
+//                  Խߣ CPU  DMA ߴԽ
+//               3. ʧʱ la->dma Ϊ NULL֮ arm / abort / deinit ֱӷ
+//-------------------------------------------------------------------------------------------------------------------
+uint32_t RUN_logic_init(RUN_logic_t* la, RUN_TIM_enum tim_n, GPIO_TypeDef* port,
+                        uint32_t rate_hz, uint16_t* buf, uint16_t depth)
+{
+    memset(la, 0, sizeof(RUN_logic_t));
+    if (tim_n >= RUN_TIM_MAX || port == 0 || buf == 0 || depth < 2) return 0;
+
+    la->tim     = tim_n;
+    la->dma     = RUN_DMA_Alloc(timer_cfg[tim_n].up_req);
+    if (la->dma == 0) return 0;
+
+    la->port    = port;
+    la->buf     = buf;
+    la->depth   = depth;
+    la->state   = RUN_LOGIC_IDLE;
+    la->rate_hz = RUN_timer_init_freq(tim_n, rate_hz);
+    if (la->rate_hz == 0)
+    {
+        RUN_DMA_Free(la->dma, timer_cfg[tim_n].up_req);     // ʶͨȥ
+        la->dma = 0;
+    }
+
+    return la->rate_hz;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       ʼɼ
+// ˵      la              ߼Ƕ
+// ˵      trig_pin        ţRUN_LOGIC_NO_TRIGGER ʾȴ
+// ˵      edge            
+// ˵      pre             ǰ
+// ز      void
+// ʹʾ      RUN_logic_arm(&la, EXTI_Line6_PB6, EXTI_Trigger_Falling, 512); // PB6 ½ǰ 512 
+//               while (!RUN_logic_done(&la));
+//               RUN_logic_dump(&la, UART1_TX_PA9_RX_PA10, GPIO_Pin_6 | GPIO_Pin_7);
+// עϢ      1. ž RUN_exti_init Ϊ룬Ҫѡ
+//               2.  DMA ж϶ռȼ 0֤дͨĴھ
+//               3. ñ pre ʱǰЧ pre
+//-------------------------------------------------------------------------------------------------------------------
+void RUN_logic_arm(RUN_logic_t* la, RUN_EXTI_Pin_enum trig_pin, EXTITrigger_TypeDef edge, uint16_t pre)
+{
+    TIM_TypeDef*   TIMx;
+    uint8_t        use_trig = ((uint16_t)trig_pin != RUN_LOGIC_NO_TRIGGER) && ((uint16_t)trig_pin < RUN_GPIO_MAX);
+    RUN_DMA_Mode_t mode;
+
+    if (la->dma == 0) return;
+    TIMx = timer_cfg[la->tim].tim_base;
+
+    // 1. ͣһβɼ
+    RUN_logic_abort(la);
+
+    if (pre >= la->depth) pre = la->depth - 1;
+    la->pre       = use_trig ? pre : 0;
+    la->laps      = 0;
+    la->trig_pos  = 0;
+    la->stop_pos  = la->depth;
+    la->trig_line = 0;
+    la->trig_mask = 0;
+    la->trig_edge = (uint8_t)edge;
+    la->first = la->count = la->trig = 0;
+
+    // 2. ޴βͣдѭȴ
+    mode      = use_trig ? RUN_DMA_MODE_CIRCULAR : RUN_DMA_MODE_NORMAL;
+    la->state = use_trig ? RUN_LOGIC_ARMED : RUN_LOGIC_POST;
+
+    RUN_DMA_Config(la->dma, (uint32_t)&la->port->IDR, (uint32_t)la->buf, la->depth,
+                   RUN_DMA_DIR_P2M, RUN_DMA_WIDTH_16BIT, mode);
+    RUN_DMA_SetCallback(la->dma, RUN_DMA_IT_TC | RUN_DMA_IT_TE, logic_dma_callback, la, 0, 0);
+
+    // 3. ʱ㣬򿪸¼ DMA 
+    TIMx->CNT   = 0;
+    TIMx->SR   &= ~TIM_SR_UIF;
+    TIMx->DIER |= TIM_DIER_UDE;
+    RUN_DMA_Enable(la->dma);
+    RUN_timer_cmd(la->tim, ENABLE);
+
+    // 4. ѾܣٹҴ (Ĺλ)
+    if (use_trig)
+    {
+        la->trig_line = gpio_cfg[trig_pin].pin;
+        la->trig_mask = (gpio_cfg[trig_pin].port == la->port) ? la->trig_line : 0;
+        logic_active  = la;
+
+        EXTI->PR = la->trig_line;
+        RUN_exti_init(trig_pin, edge, 0, 0, logic_trigger_isr);
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       ֹɼ
+// ˵      la              ߼Ƕ
+// ز      void
+//-------------------------------------------------------------------------------------------------------------------
+void RUN_logic_abort(RUN_logic_t* la)
+{
+    TIM_TypeDef* TIMx;
+
+    if (la->dma == 0) return;
+    TIMx = timer_cfg[la->tim].tim_base;
+
+    if (la->trig_line) EXTI->IMR &= ~la->trig_line;
+    if (logic_active == la) logic_active = 0;
+
+    RUN_timer_cmd(la->tim, DISABLE);
+    TIMx->DIER &= ~TIM_DIER_UDE;
+    RUN_DMA_Disable(la->dma);
+    la->state = RUN_LOGIC_IDLE;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       ֹɼͷ DMA ͨ
+// ˵      la              ߼Ƕ
+// ز      void
+// עϢ      ֮ RUN_logic_init
+//-------------------------------------------------------------------------------------------------------------------
+void RUN_logic_deinit(RUN_logic_t* la)
+{
+    if (la->dma == 0) return;
+    RUN_logic_abort(la);
+    RUN_DMA_Free(la->dma, timer_cfg[la->tim].up_req);
+    la->dma = 0;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       γ̱Ӵɼ
+// ˵      la              ߼Ƕ (Ѳɼ)
+// ˵      uart_pin         (ѳʼ)
+// ˵      mask            Ƚϵλ
+// ز      void
+// ʹʾ      RUN_logic_dump(&la, UART1_TX_PA9_RX_PA10, 0x00C0);
+// עϢ      ʽ (ıÿ \r\n β)
+//                  @LA,<>,<>,<>,<>
+//                  <ֵ>:<>,<ֵ>:<>,...      ÿ 8 ΣֵΪ 4 λʮ
+//                  @END,<>
+//                UART иߵƽϵһֻֽʮΣС
+//-------------------------------------------------------------------------------------------------------------------
+void RUN_logic_dump(const RUN_logic_t* la, UART_PIN_enum uart_pin, uint16_t mask)
+{
+    char     line[96];
+    uint8_t  n = 0, runs_in_line = 0;
+    uint32_t runs = 0;
+    uint16_t i, value, run;
+
+    if (la->state != RUN_LOGIC_DONE) return;
+
+    line[n++] = '@'; line[n++] = 'L'; line[n++] = 'A'; line[n++] = ',';
+    n += logic_put_dec(&line[n], la->rate_hz);   line[n++] = ',';
+    n += logic_put_dec(&line[n], la->count);     line[n++] = ',';
+    n += logic_put_dec(&line[n], la->trig);      line[n++] = ',';
+    n += logic_put_hex4(&line[n], mask);
+    line[n++] = '\r'; line[n++] = '\n';
+    RUN_uart_putbuff(uart_pin, (uint8_t*)line, n);
+    n = 0;
+
+    i = 0;
+    while (i < la->count)
+    {
+        value = RUN_logic_sample(la, i) & mask;
+        run   = 1;
+        while ((uint32_t)i + run < la->count && (RUN_logic_sample(la, i + run) & mask) == value) run++;
+        i += run;
+
+        if (runs_in_line) line[n++] = ',';
+        n += logic_put_hex4(&line[n], value);
+        line[n++] = ':';
+        n += logic_put_dec(&line[n], run);
+        runs++;
+
+        if (++runs_in_line == 8 || i >= la->count)
+        {
+            line[n++] = '\r'; line[n++] = '\n';
+            RUN_uart_putbuff(uart_pin, (uint8_t*)line, n);
+            n = 0;
+            runs_in_line = 0;
+        }
+    }
+
+    line[n++] = '@'; line[n++] = 'E'; line[n++] = 'N'; line[n++] = 'D'; line[n++] = ',';
+    n += logic_put_dec(&line[n], runs);
+    line[n++] = '\r'; line[n++] = '\n';
+    RUN_uart_putbuff(uart_pin, (uint8_t*)line, n);
+}
@@ -0,0 +1,102 @@
+#ifndef _RUN_LOGIC_H_
+#define _RUN_LOGIC_H_
+
+#include "stm32f10x.h"
+#include "RUN_Timer.h"
+#include "RUN_DMA.h"
+#include "RUN_Exti.h"
+#include "RUN_UART.h"
+
+// ==========================================================
+// Ƭ߼
+// ----------------------------------------------------------
+// ʱÿһθ¼DMA Ͱ GPIOx->IDR һ uint16_t
+// λ (˿ 16 ͬʱ)CPU 
+// ѡ EXTI űǰ pre 
+// ٲ (depth - pre) Զֹͣ
+// ==========================================================
+
+#define RUN_LOGIC_NO_TRIGGER    0xFFFF      // ôһ
+#define RUN_LOGIC_TRIG_SEARCH   32          //  (жӳ)
+
+// ɼ״̬
+typedef enum {
+    RUN_LOGIC_IDLE  = 0,    // δ / ֹ
+    RUN_LOGIC_ARMED = 1,    // ѭУȴ
+    RUN_LOGIC_POST  = 2,    // Ѵڲɴ
+    RUN_LOGIC_DONE  = 3     // ɼɣԶ
+} RUN_logic_state_t;
+
+// ߼Ƕ (ɵṩ洢ֶֻ)
+typedef struct {
+    RUN_TIM_enum         tim;        // ʱ
+    DMA_Channel_TypeDef* dma;        // öʱ¼Ӧ DMA ͨ
+    GPIO_TypeDef*        port;       // ˿
+    uint16_t*            buf;        // 
+    uint16_t             depth;      //  ()
+    uint16_t             pre;        // ǰ
+    uint32_t             rate_hz;    // ʵʲ
+    uint16_t             trig_line;  // õ EXTI  (λ)0 ʾ޴
+    uint16_t             trig_mask;  // ڱ˿еλ (ͬһ˿ʱΪ 0)
+    uint8_t              trig_edge;  //  (EXTITrigger_TypeDef)
+    volatile uint8_t     state;      // RUN_logic_state_t
+    volatile uint16_t    laps;       // DMA дȦ (ȴڼǵ 1)
+    volatile uint32_t    trig_pos;   // ʱ̵ľ
+    volatile uint32_t    stop_pos;   // ʱ̵ľ
+    // ڲɼɺЧ
+    uint16_t             first;      //  buf е±
+    uint16_t             count;      // Ч
+    uint16_t             trig;       //  ()
+} RUN_logic_t;
+
+// ==========================================================
+// 
+// ==========================================================
+
+/**
+ * @brief  ʼ߼ (ֻöʱ)
+ * @param  tim_n:   ʱ (Ƽ RUN_TIM6 / RUN_TIM7 DMA ͨ봮/ADC ͻ)
+ * @param  port:    ˿ ( GPIOB)
+ * @param  rate_hz: 
+ * @param  buf:      (uint16_t )
+ * @param  depth:    (2 ~ 65535)
+ * @return ʵʲ (Hz)ʧܷ 0 (la->dma Ϊ NULLarm / abort κ)
+ */
+uint32_t RUN_logic_init(RUN_logic_t* la, RUN_TIM_enum tim_n, GPIO_TypeDef* port,
+                        uint32_t rate_hz, uint16_t* buf, uint16_t depth);
+
+/**
+ * @brief  ʼɼ
+ * @param  trig_pin:  (RUN_EXTI_Pin_enum)RUN_LOGIC_NO_TRIGGER ʾɼ
+ * @param  edge:      (EXTI_Trigger_Rising / Falling / Rising_Falling)
+ * @param  pre:      ǰ (0 ~ depth-1)
+ */
+void RUN_logic_arm(RUN_logic_t* la, RUN_EXTI_Pin_enum trig_pin, EXTITrigger_TypeDef edge, uint16_t pre);
+
+// ֹɼ (Ѳɵݶ)
+void RUN_logic_abort(RUN_logic_t* la);
+
+// ֹɼͷ DMA ͨ
+void RUN_logic_deinit(RUN_logic_t* la);
+
+// ɼǷ
+static __INLINE uint8_t RUN_logic_done(const RUN_logic_t* la)
+{
+    return la->state == RUN_LOGIC_DONE;
+}
+
+// ʱ˳ȡ i  (0 = ϣla->trig Ϊ)
+static __INLINE uint16_t RUN_logic_sample(const RUN_logic_t* la, uint16_t i)
+{
+    uint32_t idx = (uint32_t)la->first + i;
+    if (idx >= la->depth) idx -= la->depth;
+    return la->buf[idx];
+}
+
+/**
+ * @brief  γ̱ (RLE) ʽӴɼ
+ * @param  mask: ֻĵλ (λٱȽ)0xFFFF ʾ˿
+ */
+void RUN_logic_dump(const RUN_logic_t* la, UART_PIN_enum uart_pin, uint16_t mask);
+
+#endif
@@ -2,7 +2,7 @@
 #define _RUN_ONEWIRE_H_
 
 #include "stm32f10x.h"
-#include "RUN_delay.h" // ֮ǰд΢ʱ delay_us()
+#include "RUN_Delay.h" // ֮ǰд΢ʱ delay_us()
 
 // ==========================================================
 // 
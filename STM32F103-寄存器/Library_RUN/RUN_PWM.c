@@ -111,7 +111,7 @@ void RUN_pwm_init(RUN_PWM_enum pwm_ch, uint32_t freq, uint32_t duty)
     // =========================================================
     // 1. ƵӦ㷨
     // =========================================================
-    uint32_t period_cycles = 72000000 / freq; 
+    uint32_t period_cycles = RUN_clock_timer(pwm_cfg[pwm_ch].is_apb2) / freq; 
     uint16_t psc_val = 0;
     uint16_t arr_val = 0;
 
@@ -230,6 +230,9 @@ void RUN_pwm_init(RUN_PWM_enum pwm_ch, uint32_t freq, uint32_t duty)
     if (pwm_cfg[pwm_ch].tim_base == TIM1 || pwm_cfg[pwm_ch].tim_base == TIM8) {
         pwm_cfg[pwm_ch].tim_base->BDTR |= TIM_BDTR_MOE;
     }
+
+    // лƵʱɶʱͳһ PSC / ARR / CCR
+    RUN_clock_hook_add(RUN_timer_retime);
 }
 
 //-------------------------------------------------------------------------------------------------------------------
@@ -264,7 +267,7 @@ void RUN_pwm_freq(RUN_PWM_enum pwm_ch, uint32_t freq)
     if (freq == 0) return;
 
     // 
-    uint32_t period_cycles = 72000000 / freq; 
+    uint32_t period_cycles = RUN_clock_timer(pwm_cfg[pwm_ch].is_apb2) / freq; 
     uint16_t psc_val = 0;
     uint16_t arr_val = 0;
 
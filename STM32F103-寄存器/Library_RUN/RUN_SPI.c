@@ -1,4 +1,13 @@
 #include "RUN_SPI.h"
+#include "RUN_Clock.h"
+#include "RUN_Gpio.h"
+
+// ==============================================================================
+// ȫֱ
+// ==============================================================================
+
+// SPI1 / SPI2 / SPI3 һ趨 SCK Ƶ (0 = δʼ)лƵѡƵ
+static uint32_t spi_sck_hz[3];
 
 // ==============================================================================
 // ڲ
@@ -55,6 +64,41 @@ static void RUN_SPI_GPIO_Config(GPIO_TypeDef* GPIOx, uint8_t Pin, uint8_t Mode)
     *cr_reg |= ((uint32_t)Mode << shift);
 }
 
+/**
+ * @brief  µǰ SCK Ƶ (ʼ / ٺ)
+ */
+static void spi_save_sck(SPI_TypeDef* SPIx)
+{
+    uint8_t  idx  = (SPIx == SPI1) ? 0 : (SPIx == SPI2) ? 1 : 2;
+    uint32_t pclk = RUN_clock_pclk(SPIx == SPI1);
+
+    spi_sck_hz[idx] = pclk / (2u << ((SPIx->CR1 >> 3) & 7));
+}
+
+/**
+ * @brief  ʱӸı乳ӣѡԭ SCK ƵʵСƵ (Ƶֻ 2 ݣƵ SCK ܱᳬ)
+ */
+static void spi_clock_hook(const RUN_clock_t* old_clk, const RUN_clock_t* new_clk)
+{
+    static SPI_TypeDef* const spi_base[3] = {SPI1, SPI2, SPI3};
+    uint8_t i;
+    (void)old_clk;
+
+    for (i = 0; i < 3; i++)
+    {
+        SPI_TypeDef* SPIx = spi_base[i];
+        uint32_t     pclk = (i == 0) ? new_clk->pclk2 : new_clk->pclk1;
+        uint32_t     br   = 0;
+
+        if (spi_sck_hz[i] == 0 || !(SPIx->CR1 & (1 << 6))) continue;
+        while (br < 7 && pclk / (2u << br) > spi_sck_hz[i]) br++;
+
+        SPIx->CR1 &= ~(1 << 6);
+        SPIx->CR1  = (SPIx->CR1 & ~(7 << 3)) | (br << 3);
+        SPIx->CR1 |= (1 << 6);
+    }
+}
+
 // ==============================================================================
 // ʼ (Ĵ汾)
 // ==============================================================================
@@ -85,8 +129,7 @@ void RUN_SPI_Init(RUN_SPI_Port_t port_group)
         RCC->APB2ENR |= (1 << 12) | (1 << 3) | (1 << 0);
 
         //  JTAG SWD (AFIO->MAPR [26:24] = 010)
-        AFIO->MAPR &= ~(7 << 24);
-        AFIO->MAPR |=  (2 << 24);
+        RUN_gpio_swj_config(AFIO_MAPR_SWJ_CFG_JTAGDISABLE);
 
         //  SPI1 ӳ (Bit 0)
         AFIO->MAPR |= (1 << 0);
@@ -118,8 +161,7 @@ void RUN_SPI_Init(RUN_SPI_Port_t port_group)
         RCC->APB2ENR |= (1 << 3) | (1 << 0);
 
         //  JTAG
-        AFIO->MAPR &= ~(7 << 24);
-        AFIO->MAPR |=  (2 << 24);
+        RUN_gpio_swj_config(AFIO_MAPR_SWJ_CFG_JTAGDISABLE);
 
         // PB3 (SCK), PB5 (MOSI) -> AF_PP
         RUN_SPI_GPIO_Config(GPIOB, 3, 0xB);
@@ -182,6 +224,9 @@ void RUN_SPI_Init(RUN_SPI_Port_t port_group)
     // 3. ʹ SPI
     SPIx->CR1 |= (1 << 6); // SPE = 1
 
+    spi_save_sck(SPIx);
+    RUN_clock_hook_add(spi_clock_hook);
+
     // 4. 䣺 Dummy Byte
     RUN_SPI_ReadWriteByte(port_group, 0xFF);
 }
@@ -258,4 +303,6 @@ void RUN_SPI_SetSpeed(RUN_SPI_Port_t port_group, uint8_t speed)
 
     // ¿ SPE
     SPIx->CR1 |= (1 << 6);
+
+    spi_save_sck(SPIx);
 }
\ No newline at end of file
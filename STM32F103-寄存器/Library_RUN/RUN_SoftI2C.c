@@ -10,11 +10,12 @@
 // ˽к궨 (򻯵ײƽ)
 // -----------------------------------------------------------
 // װ GPIO ֲͬƽ̨
-#define I2C_SCL_H(bus)  RUN_gpio_set((bus)->SCL_Pin, 1) // ͷ SCL ()
-#define I2C_SCL_L(bus)  RUN_gpio_set((bus)->SCL_Pin, 0) //  SCL
-#define I2C_SDA_H(bus)  RUN_gpio_set((bus)->SDA_Pin, 1) // ͷ SDA ()
-#define I2C_SDA_L(bus)  RUN_gpio_set((bus)->SDA_Pin, 0) //  SDA
-#define I2C_SDA_READ(bus) RUN_gpio_get((bus)->SDA_Pin)  // ȡ SDA ƽ
+//  RUN_I2C_Init гʼ߿· (ͷΧ)
+#define I2C_SCL_H(bus)  RUN_gpio_set_fast((bus)->SCL_Pin, 1) // ͷ SCL ()
+#define I2C_SCL_L(bus)  RUN_gpio_set_fast((bus)->SCL_Pin, 0) //  SCL
+#define I2C_SDA_H(bus)  RUN_gpio_set_fast((bus)->SDA_Pin, 1) // ͷ SDA ()
+#define I2C_SDA_L(bus)  RUN_gpio_set_fast((bus)->SDA_Pin, 0) //  SDA
+#define I2C_SDA_READ(bus) RUN_gpio_get_fast((bus)->SDA_Pin)  // ȡ SDA ƽ
 
 // I2C ʿ
 // 4us ʱӦڣԼ 8us -> 125kHz (׼ I2C Ϊ 100kHz)
@@ -0,0 +1,181 @@
+#include "RUN_Stream.h"
+
+//
+// ͨ· <--(DMA ѭģʽ)--> buf[0 .. count/2-1 | count/2 .. count-1]
+//
+// İ鲻 HT / TC ĸ־ǿ CNDTRDMA ڰһһǾġ
+// жˡHT  TC ͬʱţ˵һûüȥֱ DMA תȥˣͬ
+
+// ==============================================================================
+// ڲ
+// ==============================================================================
+
+//-------------------------------------------------------------------------------------------------------------------
+// ڲ׵ַ
+//-------------------------------------------------------------------------------------------------------------------
+static __INLINE void* stream_half(const RUN_stream_t* s, uint8_t half)
+{
+    return s->buf + ((uint32_t)half * (s->count >> 1) << s->shift);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// ڲDMA жϻص (ctx Ϊ)
+//-------------------------------------------------------------------------------------------------------------------
+static void stream_dma_callback(uint8_t flags, void* ctx)
+{
+    RUN_stream_t* s = (RUN_stream_t*)ctx;
+    uint8_t ready, busy;
+
+    if (flags & RUN_DMA_IT_TE)
+    {
+        RUN_stream_stop(s);                    // ַDMA ѾԼͣ
+        return;
+    }
+    if (!(flags & (RUN_DMA_IT_HT | RUN_DMA_IT_TC))) return;
+
+    busy  = (s->dma->CNDTR > (s->count >> 1)) ? 0 : 1;     // CNDTR ʣһ˵ǰ
+    ready = busy ^ 1;
+
+    if ((flags & (RUN_DMA_IT_HT | RUN_DMA_IT_TC)) == (RUN_DMA_IT_HT | RUN_DMA_IT_TC)) s->overruns++;
+    if (s->held & (1u << busy)) s->overruns++;              // DMA ת˻û黹İ
+
+    s->held |= (uint8_t)(1u << ready);
+    s->last  = ready;
+    s->blocks++;
+
+    if (s->callback && s->callback(stream_half(s, ready), s->count >> 1, s->ctx))
+    {
+        s->held &= (uint8_t)~(1u << ready);
+    }
+}
+
+// ==============================================================================
+// ӿں
+// ==============================================================================
+
+//-------------------------------------------------------------------------------------------------------------------
+//       ʼ
+// ˵      s               
+// ˵      req             DMA 
+// ˵      periph_addr     ݼĴַ
+// ˵      buf / count     뵥λ (ż)
+// ˵      dir             RUN_DMA_DIR_P2M / RUN_DMA_DIR_M2P
+// ˵      width           λ
+// ˵      callback / ctx  صNULL ʾѯ
+// ˵      pre_priority / sub_priority  DMA жȼ
+// ز      uint8_t         1: ɹ  0: ʧ
+// ʹʾ      static uint16_t adc_buf[512];
+//               static uint8_t on_block(void* half, uint16_t n, void* ctx) { fir_process((uint16_t*)half, n); return 1; }
+//               RUN_stream_init(&st, RUN_DMA_REQ_ADC1, (uint32_t)&ADC1->DR, adc_buf, 512,
+//                               RUN_DMA_DIR_P2M, RUN_DMA_WIDTH_16BIT, on_block, 0, 1, 0);
+//               RUN_stream_start(&st);
+//               ADC1->CR2 |= ADC_CR2_DMA;
+// עϢ      ͬһظʼḴѷͨ
+//-------------------------------------------------------------------------------------------------------------------
+uint8_t RUN_stream_init(RUN_stream_t* s, RUN_DMA_Req_t req, uint32_t periph_addr,
+                        void* buf, uint16_t count, RUN_DMA_Dir_t dir, RUN_DMA_Width_t width,
+                        RUN_stream_cb_t callback, void* ctx,
+                        uint8_t pre_priority, uint8_t sub_priority)
+{
+    DMA_Channel_TypeDef* dma;
+
+    if (s == 0 || buf == 0 || count < 2 || (count & 1) || dir == RUN_DMA_DIR_M2M) return 0;
+    if ((uint32_t)buf & ((1u << width) - 1)) return 0;
+
+    dma = RUN_DMA_Alloc(req);
+    if (dma == 0) return 0;
+
+    s->dma      = dma;
+    s->req      = req;
+    s->buf      = (uint8_t*)buf;
+    s->count    = count;
+    s->shift    = (uint8_t)width;
+    s->callback = callback;
+    s->ctx      = ctx;
+    s->held     = 0;
+    s->last     = 1;
+    s->blocks   = 0;
+    s->overruns = 0;
+
+    RUN_DMA_Config(dma, periph_addr, (uint32_t)buf, count, dir, width, RUN_DMA_MODE_CIRCULAR);
+    RUN_DMA_SetCallback(dma, RUN_DMA_IT_HT | RUN_DMA_IT_TC | RUN_DMA_IT_TE,
+                        stream_dma_callback, s, pre_priority, sub_priority);
+    return 1;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       
+// ˵      s               
+// ز      void
+// עϢ      Ǵӻͷʼ֮ǰռõİΪѹ黹
+//-------------------------------------------------------------------------------------------------------------------
+void RUN_stream_start(RUN_stream_t* s)
+{
+    RUN_DMA_Disable(s->dma);
+    RUN_DMA_ClearFlags(s->dma, RUN_DMA_IT_HT | RUN_DMA_IT_TC | RUN_DMA_IT_TE);
+    s->dma->CMAR  = (uint32_t)s->buf;
+    s->dma->CNDTR = s->count;
+    s->held = 0;
+    s->last = 1;
+    RUN_DMA_Enable(s->dma);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       ֹͣ
+// ˵      s               
+// ز      void
+//-------------------------------------------------------------------------------------------------------------------
+void RUN_stream_stop(RUN_stream_t* s)
+{
+    RUN_DMA_Disable(s->dma);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       ֹͣͷ DMA ͨ
+// ˵      s               
+// ز      void
+//-------------------------------------------------------------------------------------------------------------------
+void RUN_stream_deinit(RUN_stream_t* s)
+{
+    if (s->dma == 0) return;
+    RUN_DMA_Free(s->dma, s->req);
+    s->dma = 0;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       ѯʽȡһİ
+// ˵      s               
+// ˵      count           鵥λΪ NULL
+// ز      void*           ϵľ飬ûз NULL
+// ʹʾ      uint16_t n; uint16_t* p = RUN_stream_get(&st, &n);
+//               if (p) { process(p, n); RUN_stream_release(&st, p); }
+//-------------------------------------------------------------------------------------------------------------------
+void* RUN_stream_get(RUN_stream_t* s, uint16_t* count)
+{
+    uint8_t held = s->held;
+    uint8_t half;
+
+    if (held == 0) return 0;
+    if (held == 3) half = s->last ^ 1;         // 鶼ϣȸɵ
+    else           half = (held == 2) ? 1 : 0;
+
+    if (count) *count = s->count >> 1;
+    return stream_half(s, half);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       黹
+// ˵      s               
+// ˵      half            ص / RUN_stream_get ָ
+// ز      void
+// עϢ      же
+//-------------------------------------------------------------------------------------------------------------------
+void RUN_stream_release(RUN_stream_t* s, const void* half)
+{
+    uint8_t  bit = ((const uint8_t*)half == s->buf) ? 0x01 : 0x02;
+    uint32_t primask = __get_PRIMASK();
+
+    __set_PRIMASK(1);
+    s->held &= (uint8_t)~bit;
+    __set_PRIMASK(primask);
+}
@@ -0,0 +1,84 @@
+#ifndef _RUN_STREAM_H_
+#define _RUN_STREAM_H_
+
+#include "stm32f10x.h"
+#include "RUN_DMA.h"
+
+// ==========================================================
+// ƹ˫ (ѭ DMA)
+// ----------------------------------------------------------
+// һѭ DMA ͨ + һ黺мֳ룺
+// HT жʱǰTC жʱDMA ʱڰһ롣
+//   ɼ (P2MADC / ڽ) = дߴ
+//    (M2PDAC / ڷ) = ղ꣬
+// صõָ DMA ָ (㿽)ӳǰʱ
+//
+// ûİڹ黹 (ص 1  RUN_stream_release) ֮ǰ"ռ"
+// DMA תһԱռõİʱһ (overrun)ɼʱǰݻᱻǣ
+// ʱѾٲһ顣
+// һ DMA ʹλ (ADC_CR2_DMA / USART_CR3_DMAR / DAC_CR_DMAEN ) 
+// ==========================================================
+
+// صhalf ָİ飬count Ϊĵλ
+//  1: Ѵ (黹)  0: ţ֮ RUN_stream_release 黹
+typedef uint8_t (*RUN_stream_cb_t)(void* half, uint16_t count, void* ctx);
+
+//  (ɵṩ洢ֶֻ)
+typedef struct {
+    DMA_Channel_TypeDef* dma;       // ͨ (RUN_stream_init )
+    RUN_DMA_Req_t        req;       // ͨõ (ͷʱ˶)
+    uint8_t*             buf;       // 
+    uint16_t             count;     // λ (ż)
+    uint8_t              shift;     // λֽ = 1 << shift
+    RUN_stream_cb_t      callback;  // NULL ʾѯ (RUN_stream_get)
+    void*                ctx;
+    volatile uint8_t     held;      // ռõİ (bit0: ǰ  bit1: )
+    volatile uint8_t     last;      // һξİ (0 / 1)
+    volatile uint32_t    blocks;    // ۼƾİ
+    volatile uint32_t    overruns;  // ۼ
+} RUN_stream_t;
+
+// ==========================================================
+// 
+// ==========================================================
+
+/**
+ * @brief  ʼ (ѭ DMA)
+ * @param  req:         DMA  ( RUN_DMA_REQ_ADC1)ͨ
+ * @param  periph_addr: ݼĴַ ( (uint32_t)&ADC1->DR)
+ * @param  buf / count: 뵥λ (ż2 ~ 65534)
+ * @param  dir:         RUN_DMA_DIR_P2M (ɼ) / RUN_DMA_DIR_M2P ()
+ * @param  callback:    ص (жִ)NULL ʾѯ
+ * @return 1: ɹ  0: ͨռ / 
+ */
+uint8_t RUN_stream_init(RUN_stream_t* s, RUN_DMA_Req_t req, uint32_t periph_addr,
+                        void* buf, uint16_t count, RUN_DMA_Dir_t dir, RUN_DMA_Width_t width,
+                        RUN_stream_cb_t callback, void* ctx,
+                        uint8_t pre_priority, uint8_t sub_priority);
+
+//  (ӻͷʼռ״̬ʱ)
+void RUN_stream_start(RUN_stream_t* s);
+
+// ֹͣ (ͨٴ start)
+void RUN_stream_stop(RUN_stream_t* s);
+
+// ֹͣͷ DMA ͨ
+void RUN_stream_deinit(RUN_stream_t* s);
+
+/**
+ * @brief  ѯʽȡһİ (ϵǸ)
+ * @param  count: ĵλΪ NULL
+ * @return ָ룬ûоķ NULL RUN_stream_release
+ */
+void* RUN_stream_get(RUN_stream_t* s, uint16_t* count);
+
+// 黹 (half Ϊص / RUN_stream_get ָ)
+void RUN_stream_release(RUN_stream_t* s, const void* half);
+
+// ۼ
+static __INLINE uint32_t RUN_stream_overruns(const RUN_stream_t* s)
+{
+    return s->overruns;
+}
+
+#endif
@@ -1,41 +1,47 @@
 #include "RUN_Timer.h" // ͷļΪ
 //  stm32f10x.h ʹüĴ ( TIM2->CR1)
 #include "stm32f10x.h" 
-
-// --- ڲӲýṹ (ֲ) ---
-typedef struct {
-    TIM_TypeDef* tim_base;   // ʱӲַ
-    uint32_t     rcc;        // ʱλ ( RCC_APB1ENR_TIM2EN)
-    uint8_t      is_apb2;    // ߱־λ 1:APB2, 0:APB1
-    IRQn_Type    irqn;       // жͨ
-} timer_info_t;
+#include "RUN_Clock.h"
 
 // ============================================================================
-// Ӳӳ (ֲ)
+// Ӳӳ
+// up_req: ¼ (UDE)  DMA  RUN_DMA_Alloc ͨ
 // ============================================================================
 const timer_info_t timer_cfg[RUN_TIM_MAX] = {
     // --- 1. ߼ʱ (APB2) ---
-    {TIM1, RCC_APB2Periph_TIM1, 1, TIM1_UP_IRQn}, 
-    {TIM8, RCC_APB2Periph_TIM8, 1, TIM8_UP_IRQn}, 
+    {TIM1, RCC_APB2Periph_TIM1, 1, TIM1_UP_IRQn, RUN_DMA_REQ_TIM1_UP}, 
+    {TIM8, RCC_APB2Periph_TIM8, 1, TIM8_UP_IRQn, RUN_DMA_REQ_TIM8_UP}, 
 
     // --- 2. ͨöʱ (APB1) ---
-    {TIM2, RCC_APB1Periph_TIM2, 0, TIM2_IRQn},
-    {TIM3, RCC_APB1Periph_TIM3, 0, TIM3_IRQn},
-    {TIM4, RCC_APB1Periph_TIM4, 0, TIM4_IRQn},
-    {TIM5, RCC_APB1Periph_TIM5, 0, TIM5_IRQn}, 
+    {TIM2, RCC_APB1Periph_TIM2, 0, TIM2_IRQn, RUN_DMA_REQ_TIM2_UP},
+    {TIM3, RCC_APB1Periph_TIM3, 0, TIM3_IRQn, RUN_DMA_REQ_TIM3_UP},
+    {TIM4, RCC_APB1Periph_TIM4, 0, TIM4_IRQn, RUN_DMA_REQ_TIM4_UP},
+    {TIM5, RCC_APB1Periph_TIM5, 0, TIM5_IRQn, RUN_DMA_REQ_TIM5_UP}, 
 
     // --- 3. ʱ (APB1) ---
-    {TIM6, RCC_APB1Periph_TIM6, 0, TIM6_IRQn},
-    {TIM7, RCC_APB1Periph_TIM7, 0, TIM7_IRQn}
+    {TIM6, RCC_APB1Periph_TIM6, 0, TIM6_IRQn, RUN_DMA_REQ_TIM6_UP},
+    {TIM7, RCC_APB1Periph_TIM7, 0, TIM7_IRQn, RUN_DMA_REQ_TIM7_UP}
 };
 
+// лƵʱĻ׼PSC / ARR / CCR ڶʱʱ clk õġ
+// Ƶӻ׼㣬ص׼ʱʱԭָ 72M -> 8M -> 72M ȡۻ
+// ּĴϴдֵ (ûù) ԵǰֵΪ»׼
+typedef struct {
+    uint32_t clk;           // 0 ʾûл׼
+    uint16_t psc, arr;      // ׼ֵ
+    uint16_t ccr[4];        // ׼Ƚֵ
+    uint16_t last_psc, last_arr;
+    uint16_t last_ccr[4];   // ϴдֵ
+} timer_ref_t;
+static timer_ref_t timer_ref[RUN_TIM_MAX];
+
 /*
  * : ʼͨ/߼ʱ (Ĵֱٰ)
  * : tim_n   - ʱöٺ (RUN_TIM1 ~ RUN_TIM8)
  * time_ms - ʱ (λ: msֵ 6553)
  * ֵ  : 
  * ʾ    : RUN_timer_init(RUN_TIM2, 500); // ʼTIM2500msжһ
- * ע    : 1. 72MHzƵ̶Ƶ7200 (Ƶ10KHz)
+ * ע    : 1. ʵʶʱʱ (RUN_Clock) Ƶ 10KHz 
  * 2. ڲԶNVIC (ȼ2: ռ2, 1)
  */
 void RUN_timer_init(RUN_TIM_enum tim_n, uint16_t time_ms)
@@ -65,8 +71,8 @@ void RUN_timer_init(RUN_TIM_enum tim_n, uint16_t time_ms)
     // =========================================================
     
     // PSC: ԤƵ (16λ)
-    // дֵ = Ƶϵ - 1
-    TIMx->PSC = 7199; 
+    // дֵ = Ƶϵ - 1Ƶʹ̶ 10KHz (72MHz ʱΪ 7199)
+    TIMx->PSC = (uint16_t)(RUN_clock_timer(cfg->is_apb2) / 10000 - 1); 
 
     // ARR: ԶװؼĴ (16λ)
     // ʱ
@@ -121,6 +127,8 @@ void RUN_timer_init(RUN_TIM_enum tim_n, uint16_t time_ms)
     // CR1: ƼĴ
     // Bit 0 (CEN): Counter Enable
     TIMx->CR1 |= TIM_CR1_CEN;
+
+    RUN_clock_hook_add(RUN_timer_retime);
 }
 
 /*
@@ -145,4 +153,127 @@ void RUN_timer_cmd(RUN_TIM_enum tim_n, FunctionalState state)
         //  CEN (Bit 0)
         timer_cfg[tim_n].tim_base->CR1 &= ~TIM_CR1_CEN;
     }
-}
\ No newline at end of file
+}
+
+/*
+ * : Ƶʳʼʱʱ (жϡ)
+ * : tim_n   - ʱöٺ
+ * freq_hz - ¼Ƶ (Hz)ʱʱ 72MHz ʱΧԼ 2Hz ~ 36MHz
+ * ֵ  : ʵʵõĸƵ (Hz)Ƿ 0
+ * ʾ    : RUN_timer_init_freq(RUN_TIM6, 1000000); // 1MHz ¼ DMA ʹ
+ * ע    : 1.  DMA  (UDE) ȳʹãд DIER  RUN_timer_cmd 
+ * 2. ʱʱȡ RUN_Clock (APB ƵΪ 1 ʱΪ PCLK x2)ȡСԤƵʹ ARR  16 λ
+ *    ƵԽ߷ֱԽ֣ʵֵԷֵΪ׼
+ */
+uint32_t RUN_timer_init_freq(RUN_TIM_enum tim_n, uint32_t freq_hz)
+{
+    if (tim_n >= RUN_TIM_MAX || freq_hz == 0) return 0;
+
+    const timer_info_t *cfg = &timer_cfg[tim_n];
+    TIM_TypeDef *TIMx = cfg->tim_base;
+    uint32_t tim_clk = RUN_clock_timer(cfg->is_apb2);
+    uint32_t ticks = tim_clk / freq_hz;      // ÿڵܼ = (PSC+1) * (ARR+1)
+    uint32_t psc, arr;
+
+    if (ticks < 2) ticks = 2;
+
+    // 1. ʱ
+    if (cfg->is_apb2) RCC->APB2ENR |= cfg->rcc;
+    else              RCC->APB1ENR |= cfg->rcc;
+
+    // 2.  PSC / ARR
+    psc = (ticks - 1) / 0x10000;             // ʹ ARR <= 0xFFFF СԤƵ
+    arr = ticks / (psc + 1) - 1;
+
+    TIMx->CR1 &= ~(TIM_CR1_CEN | TIM_CR1_DIR | TIM_CR1_CMS | TIM_CR1_CKD);
+    TIMx->PSC = (uint16_t)psc;
+    TIMx->ARR = (uint16_t)arr;
+
+    // 3. װӰӼĴɴ˲ UIF
+    TIMx->EGR = TIM_EGR_UG;
+    TIMx->SR &= ~TIM_SR_UIF;
+
+    RUN_clock_hook_add(RUN_timer_retime);
+    return tim_clk / ((psc + 1) * (arr + 1));
+}
+
+/*
+ * : ʱӸı㶨ʱʱ (RUN_clock_set Ĺ)
+ * : old_clk / new_clk - лǰʱ
+ * ֵ  : 
+ * ע    : 1. ֻʱѴ򿪡Ҷʱʱȷʵ˵ TIMx˭õ
+ *              (ʱжϡPWMDMA Ķһ)
+ * 2. ָڲ䣺ܼʱӱ² PSC / ARRȽֵ CCR1~4  ARR ͬţ
+ *    ռձȲ
+ * 3.  URS  UG װӰӼĴһθж / DMA 󣻼㣬ǰڻԳ
+ */
+void RUN_timer_retime(const RUN_clock_t* old_clk, const RUN_clock_t* new_clk)
+{
+    uint8_t n, k;
+
+    for (n = 0; n < RUN_TIM_MAX; n++)
+    {
+        const timer_info_t *cfg = &timer_cfg[n];
+        TIM_TypeDef *TIMx = cfg->tim_base;
+        timer_ref_t *ref = &timer_ref[n];
+        volatile uint16_t *ccr = (volatile uint16_t *)&TIMx->CCR1;   // CCR1~4  4 ֽ
+        uint32_t old_tc = cfg->is_apb2 ? old_clk->apb2_timclk : old_clk->apb1_timclk;
+        uint32_t new_tc = cfg->is_apb2 ? new_clk->apb2_timclk : new_clk->apb1_timclk;
+        uint32_t enr    = cfg->is_apb2 ? RCC->APB2ENR : RCC->APB1ENR;
+        uint8_t  ch_num = (n < RUN_TIM6) ? 4 : 0;                   // ʱ TIM6/7 ûбȽͨ
+        uint32_t psc, arr;
+
+        if (!(enr & cfg->rcc) || old_tc == new_tc) continue;
+
+        // 1. ĴĹȡ׼
+        if (ref->clk == 0 || TIMx->PSC != ref->last_psc || TIMx->ARR != ref->last_arr)
+        {
+            ref->clk = old_tc;
+            ref->psc = TIMx->PSC;
+            ref->arr = TIMx->ARR;
+            for (k = 0; k < ch_num; k++) ref->ccr[k] = ref->last_ccr[k] = ccr[k * 2];
+        }
+
+        // 2. µ PSC / ARRص׼ʱʱԭָ򰴱ܼ
+        //    ȡʹ ARR <= 0xFFFF СԤƵԤƵ (ھȷ)
+        if (new_tc == ref->clk)
+        {
+            psc = ref->psc;
+            arr = ref->arr;
+        }
+        else
+        {
+            uint64_t ticks = ((uint64_t)(ref->psc + 1) * (ref->arr + 1) * new_tc + ref->clk / 2) / ref->clk;
+            uint32_t div, i;
+
+            if (ticks < 2) ticks = 2;
+            if (ticks > 0x100000000ULL) ticks = 0x100000000ULL;
+            div = (uint32_t)((ticks - 1) / 0x10000) + 1;
+            for (i = 0; i < 64 && div + i <= 0x10000; i++)
+            {
+                if (ticks % (div + i) == 0) { div += i; break; }
+            }
+            psc = div - 1;
+            arr = (uint32_t)(ticks / div) - 1;
+        }
+
+        // 3. Ƚֵ ARR ͬ (ûĹͨԵǰֵΪ׼)ռձȲ
+        for (k = 0; k < ch_num; k++)
+        {
+            if (ccr[k * 2] != ref->last_ccr[k])
+                ref->ccr[k] = (uint16_t)(((uint32_t)ccr[k * 2] * (ref->arr + 1) + (TIMx->ARR + 1) / 2) / (TIMx->ARR + 1));
+            ref->last_ccr[k] = (uint16_t)(((uint32_t)ref->ccr[k] * (arr + 1) + (ref->arr + 1) / 2) / (ref->arr + 1));
+            ccr[k * 2] = ref->last_ccr[k];
+        }
+        TIMx->PSC = (uint16_t)psc;
+        TIMx->ARR = (uint16_t)arr;
+
+        // 4. װӰӼĴURS = 1 ʱ UG  UIF DMA 
+        TIMx->CR1 |= TIM_CR1_URS;
+        TIMx->EGR  = TIM_EGR_UG;
+        TIMx->CR1 &= ~TIM_CR1_URS;
+
+        ref->last_psc = (uint16_t)psc;
+        ref->last_arr = (uint16_t)arr;
+    }
+}
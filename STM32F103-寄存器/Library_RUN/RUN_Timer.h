@@ -2,6 +2,8 @@
 #define _RUN_TIMER_H_
 
 #include "stm32f10x.h"
+#include "RUN_Clock.h"
+#include "RUN_DMA.h"
 
 // ==========================================================
 // ʱö (ZET6 ȫ)
@@ -25,6 +27,19 @@ typedef enum {
     RUN_TIM_MAX
 } RUN_TIM_enum;
 
+// ==========================================================
+// Ӳýṹ ( DMA ģʹ)
+// ==========================================================
+typedef struct {
+    TIM_TypeDef*         tim_base;   // ʱӲַ
+    uint32_t             rcc;        // ʱλ ( RCC_APB1ENR_TIM2EN)
+    uint8_t              is_apb2;    // ߱־λ 1:APB2, 0:APB1
+    IRQn_Type            irqn;       // жͨ
+    RUN_DMA_Req_t        up_req;     // ¼ DMA  (ͨ RUN_DMA_Channel )
+} timer_info_t;
+
+extern const timer_info_t timer_cfg[RUN_TIM_MAX];
+
 // ==========================================================
 // 
 // ==========================================================
@@ -42,4 +57,15 @@ void RUN_timer_init(RUN_TIM_enum tim_n, uint16_t time_ms);
  */
 void RUN_timer_cmd(RUN_TIM_enum tim_n, FunctionalState state);
 
+/**
+ * @brief  Ƶʳʼʱ (жϡ)ʵƵ
+ */
+uint32_t RUN_timer_init_freq(RUN_TIM_enum tim_n, uint32_t freq_hz);
+
+/**
+ * @brief  ʱӸı乳ӣ¶ʱʱѿʱӵ TIMx  PSC / ARR / CCR
+ *  RUN_timer_init / RUN_timer_init_freq / RUN_pwm_init ԶǼǣһֶ
+ */
+void RUN_timer_retime(const RUN_clock_t* old_clk, const RUN_clock_t* new_clk);
+
 #endif
\ No newline at end of file
@@ -1,8 +1,10 @@
 #include "RUN_UART.h" 
+#include "RUN_DMA.h"
+#include "RUN_Clock.h"
+#include <string.h>
 #include <stdio.h>  // <--- ͷļʶ FILE 
 
 // ϵͳʱӱ (ͨ system_stm32f10x.c ж)
-extern uint32_t SystemCoreClock;
 
 // ===============================================================================
 // ñ (ȫԭ壬еĻַ)
@@ -26,6 +28,27 @@ const uart_info_t uart_cfg[UART_PIN_MAX] = {
     {UART5,  RCC_APB1Periph_UART5,  0, GPIOC, GPIO_Pin_12, RCC_APB2Periph_GPIOC, GPIOD, GPIO_Pin_2,  RCC_APB2Periph_GPIOD, 0}
 };
 
+// һγʼĲ (0 = δʼ)лƵݴ BRR
+static uint32_t uart_baud[UART_PIN_MAX];
+
+//-------------------------------------------------------------------------------------------------------------------
+// ڲʱӸı乳ӣ PCLK ôڵ BRR
+//-------------------------------------------------------------------------------------------------------------------
+static void uart_clock_hook(const RUN_clock_t* old_clk, const RUN_clock_t* new_clk)
+{
+    uint8_t i;
+    (void)old_clk;
+
+    for (i = 0; i < UART_PIN_MAX; i++)
+    {
+        USART_TypeDef* UARTx = uart_cfg[i].uart_base;
+        uint32_t       pclk  = uart_cfg[i].is_apb2 ? new_clk->pclk2 : new_clk->pclk1;
+
+        if (uart_baud[i] == 0 || !(UARTx->CR1 & USART_CR1_UE)) continue;
+        UARTx->BRR = (pclk + uart_baud[i] / 2) / uart_baud[i];
+    }
+}
+
 //-------------------------------------------------------------------------------------------------------------------
 // ڲȡжͨ
 //-------------------------------------------------------------------------------------------------------------------
@@ -91,9 +114,17 @@ void RUN_uart_init(UART_PIN_enum uart_pin, uint32_t baud_rate, uint8_t enable_it
     uart_gpio_config(uart_cfg[uart_pin].rx_port, uart_cfg[uart_pin].rx_pin, 0x4);
 
     // 4. USART 
-    uint32_t pclk = (uart_cfg[uart_pin].is_apb2) ? SystemCoreClock : (SystemCoreClock / 2);
+    uint32_t pclk = RUN_clock_pclk(uart_cfg[uart_pin].is_apb2);
     UARTx->BRR = (pclk + baud_rate / 2) / baud_rate;
 
+    // ͬһ USART ֻʼ
+    for (uint8_t i = 0; i < UART_PIN_MAX; i++)
+    {
+        if (uart_cfg[i].uart_base == UARTx) uart_baud[i] = 0;
+    }
+    uart_baud[uart_pin] = baud_rate;
+    RUN_clock_hook_add(uart_clock_hook);
+
     uint32_t cr1_val = 0x200C; // UE, TE, RE
     
     // 5. ж
@@ -140,10 +171,541 @@ uint8_t RUN_uart_query(UART_PIN_enum uart_pin) {
     return (UARTx->SR & (1<<5)) ? 1 : 0;
 }
 
+// -----------------------------------------------------------
+// DMA 첽
+// -----------------------------------------------------------
+// ÿһͶУҪôָû (write_async㿽)
+// Ҫôָ򱾴ڷͻеһ (write_buffered / printf)ݰ˳򷢳
+//  DMA ͣTC жӡصһ
+// ѭж϶ĶУĶں̵ܶ PRIMASK ٽ
+
+typedef struct {
+    const uint8_t* buff;
+    uint16_t       len;
+    uint8_t        ring;        // 1: ڷͻͷŻռ
+} uart_tx_item_t;
+
+typedef struct {
+    DMA_Channel_TypeDef*   dma;
+    UART_PIN_enum          pin;
+    RUN_uart_tx_callback_t callback;
+    uart_tx_item_t         queue[RUN_UART_TX_QUEUE];
+    volatile uint8_t       head, tail, count;   //  (count ڷ͵һ)
+    volatile uint8_t       busy;                // DMA ڷͶ
+    uint8_t                ready;               // ѵ RUN_uart_tx_dma_init
+    uint8_t                ring[RUN_UART_TX_RING];
+    uint16_t               ring_wr;             // һдλ
+    volatile uint16_t      ring_used;           // д뵫ûֽ
+} uart_tx_t;
+
+static uart_tx_t uart_tx[4];    // USART1 / USART2 / USART3 / UART4
+
+//-------------------------------------------------------------------------------------------------------------------
+// ڲ -> ͨ (֧ DMA  NULL)
+//-------------------------------------------------------------------------------------------------------------------
+static uart_tx_t* uart_tx_get(UART_PIN_enum uart_pin)
+{
+    USART_TypeDef* UARTx;
+
+    if (uart_pin >= UART_PIN_MAX) return 0;
+    UARTx = uart_cfg[uart_pin].uart_base;
+    if (UARTx == USART1) return &uart_tx[0];
+    if (UARTx == USART2) return &uart_tx[1];
+    if (UARTx == USART3) return &uart_tx[2];
+    if (UARTx == UART4)  return &uart_tx[3];
+    return 0;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// ڲ DMA (֤߱ٽж)
+//-------------------------------------------------------------------------------------------------------------------
+static void uart_tx_kick(uart_tx_t* tx)
+{
+    uart_tx_item_t* item;
+
+    if (tx->busy || tx->count == 0) return;
+
+    item = &tx->queue[tx->tail];
+    tx->dma->CCR  &= ~DMA_CCR1_EN;
+    tx->dma->CMAR  = (uint32_t)item->buff;
+    tx->dma->CNDTR = item->len;
+    tx->busy = 1;
+    tx->dma->CCR  |= DMA_CCR1_EN;     // TXE λDMA ̿ʼ
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// ڲ (TC жϣȴΪ)
+//-------------------------------------------------------------------------------------------------------------------
+static void uart_tx_complete(uart_tx_t* tx)
+{
+    uart_tx_item_t item = tx->queue[tx->tail];
+
+    tx->tail = (uint8_t)((tx->tail + 1) % RUN_UART_TX_QUEUE);
+    tx->count--;
+    tx->busy = 0;
+
+    if (item.ring) tx->ring_used -= item.len;
+    uart_tx_kick(tx);
+
+    if (!item.ring && tx->callback) tx->callback(tx->pin, item.buff, item.len);
+}
+
+static void uart_tx_dma_callback(uint8_t flags, void* ctx)
+{
+    uart_tx_t* tx = (uart_tx_t*)ctx;
+
+    (void)flags;
+    if (tx->busy) uart_tx_complete(tx);     // TC  TE ǰ (TE ʱöݶʧ)
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// ڲæʱжƽ
+// ڹжϻȼж printf ʱDMA жϽֱӲ TC ־
+//-------------------------------------------------------------------------------------------------------------------
+static void uart_tx_poll(uart_tx_t* tx)
+{
+    uint32_t primask = __get_PRIMASK();
+
+    __set_PRIMASK(1);
+    if (tx->busy && (RUN_DMA_GetFlags(tx->dma) & (RUN_DMA_IT_TC | RUN_DMA_IT_TE)))
+    {
+        RUN_DMA_ClearFlags(tx->dma, RUN_DMA_IT_TC | RUN_DMA_IT_TE);
+        uart_tx_complete(tx);
+    }
+    __set_PRIMASK(primask);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       򿪴 DMA 
+// ˵      uart_pin        ö
+// ˵      callback        write_async Ļص (Ϊ NULL)
+// ز      uint8_t         1: ɹ  0: ôû DMA (UART5)DMA ͨռû
+// ʹʾ      RUN_uart_init(UART1_TX_PA9_RX_PA10, 115200, 0);
+//               RUN_uart_tx_dma_init(UART1_TX_PA9_RX_PA10, NULL);
+// עϢ      1. ռõ DMA ͨUSART1 -> DMA1_CH4USART2 -> DMA1_CH7USART3 -> DMA1_CH2UART4 -> DMA2_CH5
+//               2. 򿪺Ҫٻ RUN_uart_putchar͵ֽڻ DMA м
+//-------------------------------------------------------------------------------------------------------------------
+uint8_t RUN_uart_tx_dma_init(UART_PIN_enum uart_pin, RUN_uart_tx_callback_t callback)
+{
+    static const RUN_DMA_Req_t tx_req[4] = {RUN_DMA_REQ_USART1_TX, RUN_DMA_REQ_USART2_TX, RUN_DMA_REQ_USART3_TX, RUN_DMA_REQ_UART4_TX};
+    uart_tx_t*           tx = uart_tx_get(uart_pin);
+    USART_TypeDef*       UARTx;
+    DMA_Channel_TypeDef* dma;
+
+    if (tx == 0) return 0;
+    UARTx = uart_cfg[uart_pin].uart_base;
+    dma   = RUN_DMA_Alloc(tx_req[tx - uart_tx]);
+    if (dma == 0) return 0;
+
+    memset(tx, 0, sizeof(uart_tx_t));
+    tx->dma      = dma;
+    tx->pin      = uart_pin;
+    tx->callback = callback;
+
+    // ڴ -> USARTx->DR8 λΣַͳÿηǰ
+    RUN_DMA_Config(tx->dma, (uint32_t)&UARTx->DR, (uint32_t)tx->ring, 0,
+                   RUN_DMA_DIR_M2P, RUN_DMA_WIDTH_8BIT, RUN_DMA_MODE_NORMAL);
+    RUN_DMA_SetCallback(tx->dma, RUN_DMA_IT_TC | RUN_DMA_IT_TE, uart_tx_dma_callback, tx, 1, 0);
+
+    UARTx->CR3 |= USART_CR3_DMAT;
+    tx->ready = 1;
+    return 1;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       㿽첽
+// ˵      uart_pin        ö
+// ˵      buff             (ص֮ǰ޸Ļͷ)
+// ˵      len              (1 ~ 65535)
+// ز      uint8_t         1: Ŷ  0:  / δ DMA 
+// ʹʾ      static uint8_t frame[64];
+//               if (!RUN_uart_write_async(UART1_TX_PA9_RX_PA10, frame, 64)) { ... Ժ ... }
+//-------------------------------------------------------------------------------------------------------------------
+uint8_t RUN_uart_write_async(UART_PIN_enum uart_pin, const uint8_t* buff, uint16_t len)
+{
+    uart_tx_t* tx = uart_tx_get(uart_pin);
+    uint32_t   primask;
+    uint8_t    ok = 0;
+
+    if (tx == 0 || !tx->ready) return 0;
+    if (len == 0) return 1;
+
+    primask = __get_PRIMASK();
+    __set_PRIMASK(1);
+    if (tx->count < RUN_UART_TX_QUEUE)
+    {
+        uart_tx_item_t* item = &tx->queue[tx->head];
+        item->buff = buff;
+        item->len  = len;
+        item->ring = 0;
+        tx->head = (uint8_t)((tx->head + 1) % RUN_UART_TX_QUEUE);
+        tx->count++;
+        uart_tx_kick(tx);
+        ok = 1;
+    }
+    __set_PRIMASK(primask);
+    return ok;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       巢 ()
+// ˵      uart_pin        ö
+// ˵      buff            
+// ˵      len             
+// ز      void
+// ʹʾ      RUN_uart_write_buffered(UART1_TX_PA9_RX_PA10, (uint8_t*)"hello\r\n", 7);
+// עϢ      1. ׷ӵͻβǻûʼһλβӣֱӲȥ
+//                  ֽڵ (printf) Ҳܳһ DMA 
+//               2. ʱԭصȴƽʳʱŻ
+//               3. ѭжϿͬʱ (printf Ҳ)ռռ䡢Ҷжͬһ
+//                  ٽɣÿ࿽ RUN_UART_TX_CHUNK ֽڣжʱ
+//-------------------------------------------------------------------------------------------------------------------
+void RUN_uart_write_buffered(UART_PIN_enum uart_pin, const uint8_t* buff, uint16_t len)
+{
+    uart_tx_t* tx = uart_tx_get(uart_pin);
+
+    if (tx == 0 || !tx->ready)
+    {
+        RUN_uart_putbuff(uart_pin, (uint8_t*)buff, len);
+        return;
+    }
+
+    while (len)
+    {
+        uint32_t primask;
+        uint16_t room, n, wr;
+        uint8_t  last;
+
+        primask = __get_PRIMASK();
+        __set_PRIMASK(1);
+
+        // 1. дβҲпռ͵ο
+        wr   = tx->ring_wr;
+        room = RUN_UART_TX_RING - tx->ring_used;
+        if (room > RUN_UART_TX_RING - wr) room = RUN_UART_TX_RING - wr;
+        n = (len < room) ? len : room;
+        if (n > RUN_UART_TX_CHUNK) n = RUN_UART_TX_CHUNK;
+
+        // 2. ҽУδһβӾͺϲռһ¶
+        last = (uint8_t)((tx->head + RUN_UART_TX_QUEUE - 1) % RUN_UART_TX_QUEUE);
+        if (n != 0 && tx->count > (tx->busy ? 1 : 0) && tx->queue[last].ring &&
+            tx->queue[last].buff + tx->queue[last].len == &tx->ring[wr])
+        {
+            tx->queue[last].len += n;
+        }
+        else if (n != 0 && tx->count < RUN_UART_TX_QUEUE)
+        {
+            tx->queue[tx->head].buff = &tx->ring[wr];
+            tx->queue[tx->head].len  = n;
+            tx->queue[tx->head].ring = 1;
+            tx->head = (uint8_t)((tx->head + 1) % RUN_UART_TX_QUEUE);
+            tx->count++;
+        }
+        else
+        {
+            __set_PRIMASK(primask);
+            uart_tx_poll(tx);                           // һ
+            continue;
+        }
+
+        // 3. Ҫ kick ֮ǰһοϾͽ DMA
+        memcpy(&tx->ring[wr], buff, n);
+        tx->ring_used += n;
+        tx->ring_wr = (uint16_t)((wr + n) % RUN_UART_TX_RING);
+        uart_tx_kick(tx);
+        __set_PRIMASK(primask);
+
+        buff += n;
+        len  -= n;
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       ѯ DMA Ƿæ
+// ˵      uart_pin        ö
+// ز      uint8_t         1: ﻹ  0: ȫ
+//-------------------------------------------------------------------------------------------------------------------
+uint8_t RUN_uart_tx_busy(UART_PIN_enum uart_pin)
+{
+    uart_tx_t* tx = uart_tx_get(uart_pin);
+    return (tx && tx->count) ? 1 : 0;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       ѯͻʣռ
+// ˵      uart_pin        ö
+// ز      uint16_t        ֽδ DMA ʱ 0xFFFF
+// עϢ      RUN_uart_write_buffered д벻ֵݲȴ (㹻ʱ)
+//-------------------------------------------------------------------------------------------------------------------
+uint16_t RUN_uart_tx_room(UART_PIN_enum uart_pin)
+{
+    uart_tx_t* tx = uart_tx_get(uart_pin);
+
+    if (tx == 0 || !tx->ready) return 0xFFFF;
+    return (uint16_t)(RUN_UART_TX_RING - tx->ring_used);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       ȴȫ
+// ˵      uart_pin        ö
+// ز      void
+// עϢ      ȶպٵ USART  TC֤һֽڵֹͣλѾƳ (͹ġвǰ)
+//-------------------------------------------------------------------------------------------------------------------
+void RUN_uart_tx_flush(UART_PIN_enum uart_pin)
+{
+    uart_tx_t* tx = uart_tx_get(uart_pin);
+
+    if (uart_pin >= UART_PIN_MAX) return;
+    while (tx && tx->count) uart_tx_poll(tx);
+    while ((uart_cfg[uart_pin].uart_base->SR & USART_SR_TC) == 0);
+}
+
+// -----------------------------------------------------------
+// DMA ѭ
+// -----------------------------------------------------------
+// дָ = size - CNDTR DMA Ӳƽжֻ"ۼдֽ" total ȥ
+// ѭά consumedtotal - consumed ǿɶֽ size ˵ ()
+// HT/TC ֤η֮ size/2 ֽڣ total ©һȦ
+
+typedef struct {
+    DMA_Channel_TypeDef*   dma;
+    UART_PIN_enum          pin;
+    RUN_uart_rx_callback_t callback;
+    uint8_t*               ring;
+    uint16_t               size;
+    uint16_t               last_pos;    // жϣϴηʱдλ
+    volatile uint32_t      total;       // жϣۼƷֽ
+    uint32_t               consumed;    // ѭۼƶߵֽ
+    uint16_t               rd;          // ѭλ (= consumed % size)
+    volatile uint32_t      overrun;     // ѭǶֽ
+    uint8_t                ready;
+} uart_rx_t;
+
+static uart_rx_t uart_rx[4];    // USART1 / USART2 / USART3 / UART4
+
+//-------------------------------------------------------------------------------------------------------------------
+// ڲ -> ͨ (֧ DMA  NULL)
+//-------------------------------------------------------------------------------------------------------------------
+static uart_rx_t* uart_rx_get(USART_TypeDef* UARTx)
+{
+    if (UARTx == USART1) return &uart_rx[0];
+    if (UARTx == USART2) return &uart_rx[1];
+    if (UARTx == USART3) return &uart_rx[2];
+    if (UARTx == UART4)  return &uart_rx[3];
+    return 0;
+}
+
+static uart_rx_t* uart_rx_get_pin(UART_PIN_enum uart_pin)
+{
+    uart_rx_t* rx;
+    if (uart_pin >= UART_PIN_MAX) return 0;
+    rx = uart_rx_get(uart_cfg[uart_pin].uart_base);
+    return (rx && rx->ready) ? rx : 0;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// ڲ DMA ǰдλ (HT / TC / IDLE жãͬһȼ)
+//-------------------------------------------------------------------------------------------------------------------
+static void uart_rx_publish(uart_rx_t* rx)
+{
+    uint16_t pos = rx->size - (uint16_t)rx->dma->CNDTR;
+    uint16_t delta;
+
+    if (pos >= rx->size) pos = 0;
+    delta = (pos >= rx->last_pos) ? (pos - rx->last_pos) : (uint16_t)(rx->size - rx->last_pos + pos);
+    if (delta == 0) return;
+
+    rx->last_pos = pos;
+    rx->total   += delta;
+    if (rx->callback)
+    {
+        uint32_t avail = rx->total - rx->consumed;
+        rx->callback(rx->pin, (uint16_t)(avail > rx->size ? rx->size : avail));
+    }
+}
+
+static void uart_rx_dma_callback(uint8_t flags, void* ctx)
+{
+    (void)flags;
+    uart_rx_publish((uart_rx_t*)ctx);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       򿪴 DMA ѭ
+// ˵      uart_pin        ö
+// ˵      ring            λ
+// ˵      size            С ( >= ѭ֮յֽ 2 )
+// ˵      callback        ʱ֪ͨ (жִУΪ NULL)
+// ز      uint8_t         1: ɹ  0: ôû DMA (UART5)DMA ͨռû
+// ʹʾ      static uint8_t rx_ring[1024];
+//               RUN_uart_init(UART1_TX_PA9_RX_PA10, 2000000, 0);
+//               RUN_uart_rx_dma_init(UART1_TX_PA9_RX_PA10, rx_ring, sizeof(rx_ring), NULL);
+// עϢ      1. 򿪺ٲ RXNE ж (RUN_Isr.c ֽڽٱ)
+//               2. жϴʱÿ size/2 ֽһΣһ֡ (·һַʱ) һ
+//-------------------------------------------------------------------------------------------------------------------
+uint8_t RUN_uart_rx_dma_init(UART_PIN_enum uart_pin, uint8_t* ring, uint16_t size, RUN_uart_rx_callback_t callback)
+{
+    static const RUN_DMA_Req_t rx_req[4] = {RUN_DMA_REQ_USART1_RX, RUN_DMA_REQ_USART2_RX, RUN_DMA_REQ_USART3_RX, RUN_DMA_REQ_UART4_RX};
+    USART_TypeDef*       UARTx;
+    uart_rx_t*           rx;
+    IRQn_Type            irqn;
+    DMA_Channel_TypeDef* dma;
+
+    if (uart_pin >= UART_PIN_MAX || ring == 0 || size < 2) return 0;
+    UARTx = uart_cfg[uart_pin].uart_base;
+    rx    = uart_rx_get(UARTx);
+    if (rx == 0) return 0;
+    dma   = RUN_DMA_Alloc(rx_req[rx - uart_rx]);
+    if (dma == 0) return 0;
+
+    memset(rx, 0, sizeof(uart_rx_t));
+    rx->dma      = dma;
+    rx->pin      = uart_pin;
+    rx->callback = callback;
+    rx->ring     = ring;
+    rx->size     = size;
+
+    // 1. DMAUSARTx->DR -> ring8 λѭ HT/TC ж
+    RUN_DMA_Config(rx->dma, (uint32_t)&UARTx->DR, (uint32_t)ring, size,
+                   RUN_DMA_DIR_P2M, RUN_DMA_WIDTH_8BIT, RUN_DMA_MODE_CIRCULAR);
+    RUN_DMA_SetCallback(rx->dma, RUN_DMA_IT_HT | RUN_DMA_IT_TC, uart_rx_dma_callback, rx, 1, 0);
+    rx->ready = 1;
+    RUN_DMA_Enable(rx->dma);
+
+    // 2. USART RXNE жϣ DMA պ IDLE ж ( DMA жͬһȼ)
+    (void)UARTx->SR;
+    (void)UARTx->DR;                            //  IDLE / ORE
+    UARTx->CR3 |= USART_CR3_DMAR;
+    UARTx->CR1  = (UARTx->CR1 & ~USART_CR1_RXNEIE) | USART_CR1_IDLEIE;
+
+    irqn = (IRQn_Type)get_uart_irqn(UARTx);
+    NVIC_SetPriority(irqn, NVIC_EncodePriority(NVIC_GetPriorityGrouping(), 1, 0));
+    NVIC_EnableIRQ(irqn);
+    return 1;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//        IDLE жϴ
+// ˵      UARTx           
+// ز      void
+// ʹʾ      void USART1_IRQHandler(void) { RUN_uart_rx_dma_irq(USART1); ... }
+// עϢ      IDLE ־"ȶ SR ٶ DR"
+//-------------------------------------------------------------------------------------------------------------------
+void RUN_uart_rx_dma_irq(USART_TypeDef* UARTx)
+{
+    uart_rx_t* rx = uart_rx_get(UARTx);
+
+    if (!(UARTx->CR1 & USART_CR1_IDLEIE) || !(UARTx->SR & USART_SR_IDLE)) return;
+    (void)UARTx->DR;
+    if (rx && rx->ready) uart_rx_publish(rx);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// ڲɶֱֽʱֱλ
+//-------------------------------------------------------------------------------------------------------------------
+static uint16_t uart_rx_pending(uart_rx_t* rx)
+{
+    uint32_t total = rx->total;
+    uint32_t avail = total - rx->consumed;
+
+    if (avail > rx->size)
+    {
+        rx->overrun += avail;
+        rx->consumed = total;
+        rx->rd       = (uint16_t)(total % rx->size);
+        return 0;
+    }
+    return (uint16_t)avail;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       ѯɶֽ
+// ˵      uart_pin        ö
+// ز      uint16_t        ѷδߵֽ
+//-------------------------------------------------------------------------------------------------------------------
+uint16_t RUN_uart_rx_available(UART_PIN_enum uart_pin)
+{
+    uart_rx_t* rx = uart_rx_get_pin(uart_pin);
+    return rx ? uart_rx_pending(rx) : 0;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       㿽ȡȡһ
+// ˵      uart_pin        ö
+// ˵      data            ʼַ
+// ز      uint16_t        ɶ (ݿβʱȡ)
+// ʹʾ      const uint8_t* p;
+//               uint16_t n = RUN_uart_rx_peek(UART1_TX_PA9_RX_PA10, &p);
+//               parse(p, n);
+//               RUN_uart_rx_consume(UART1_TX_PA9_RX_PA10, n);
+//-------------------------------------------------------------------------------------------------------------------
+uint16_t RUN_uart_rx_peek(UART_PIN_enum uart_pin, const uint8_t** data)
+{
+    uart_rx_t* rx = uart_rx_get_pin(uart_pin);
+    uint16_t   n;
+
+    if (rx == 0) return 0;
+    n = uart_rx_pending(rx);
+    if (n > rx->size - rx->rd) n = rx->size - rx->rd;
+    *data = &rx->ring[rx->rd];
+    return n;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       ͷѴ
+// ˵      uart_pin        ö
+// ˵      len             ֽ ( peek/available ķֵ)
+// ز      void
+//-------------------------------------------------------------------------------------------------------------------
+void RUN_uart_rx_consume(UART_PIN_enum uart_pin, uint16_t len)
+{
+    uart_rx_t* rx = uart_rx_get_pin(uart_pin);
+
+    if (rx == 0) return;
+    rx->consumed += len;
+    rx->rd = (uint16_t)((rx->rd + len) % rx->size);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       ȡ
+// ˵      uart_pin        ö
+// ˵      buff            
+// ˵      max             ֽ
+// ز      uint16_t        ʵʶֽ
+//-------------------------------------------------------------------------------------------------------------------
+uint16_t RUN_uart_rx_read(UART_PIN_enum uart_pin, uint8_t* buff, uint16_t max)
+{
+    uint16_t done = 0;
+
+    while (done < max)
+    {
+        const uint8_t* p;
+        uint16_t n = RUN_uart_rx_peek(uart_pin, &p);
+
+        if (n == 0) break;
+        if (n > max - done) n = max - done;
+        memcpy(&buff[done], p, n);
+        RUN_uart_rx_consume(uart_pin, n);
+        done += n;
+    }
+    return done;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       ȡֽ
+// ˵      uart_pin        ö
+// ز      uint32_t        ֽ
+//-------------------------------------------------------------------------------------------------------------------
+uint32_t RUN_uart_rx_overrun(UART_PIN_enum uart_pin)
+{
+    uart_rx_t* rx = uart_rx_get_pin(uart_pin);
+    return rx ? rx->overrun : 0;
+}
+
 // -----------------------------------------------------------
 // Printf ض
 // -----------------------------------------------------------
-#if 1
+#if defined(__CC_ARM)    // Keil ARMCC: رհض fputc (ֱʹ libc  stdio)
 #pragma import(__use_no_semihosting)
 struct __FILE { int handle; };
 FILE __stdout;       // Ҫ <stdio.h>
@@ -151,7 +713,9 @@ void _sys_exit(int x) { x = x; }
 
 int fputc(int ch, FILE *f) {  // Ҫ <stdio.h>
     // ĬʹöֵΪ 0 Ĵ (ͨ UART1)
-    RUN_uart_putchar((UART_PIN_enum)0, (uint8_t)ch);
+    //  DMA  (RUN_uart_tx_dma_init) ߻巢ͣprintf 
+    uint8_t c = (uint8_t)ch;
+    RUN_uart_write_buffered((UART_PIN_enum)0, &c, 1);
     return ch;
 }
 #endif
\ No newline at end of file
@@ -55,4 +55,59 @@ void RUN_uart_putbuff(UART_PIN_enum uart_pin, uint8_t *buff, uint32_t len);
 uint8_t RUN_uart_getchar(UART_PIN_enum uart_pin);
 uint8_t RUN_uart_query(UART_PIN_enum uart_pin);
 
+// --- 4. DMA 첽 ---
+// USART1_TX = DMA1 ͨ4USART2_TX = DMA1 ͨ7USART3_TX = DMA1 ͨ2UART4_TX = DMA2 ͨ5
+// (UART5 û DMAֻ)
+#ifndef RUN_UART_TX_QUEUE
+#define RUN_UART_TX_QUEUE   8       // ÿŶӵĻ
+#endif
+#ifndef RUN_UART_TX_RING
+#define RUN_UART_TX_RING    256     // ÿڵĻ巢ͻ (printf ) ֽ
+#endif
+#ifndef RUN_UART_TX_CHUNK
+#define RUN_UART_TX_CHUNK   32      // 巢ÿιж࿽ֽ
+#endif
+
+// һ RUN_uart_write_async  (жִ)˺ûԸ
+typedef void (*RUN_uart_tx_callback_t)(UART_PIN_enum uart_pin, const uint8_t* buff, uint16_t len);
+
+//  DMA  ( RUN_uart_init ֮) 1 ɹ / 0 ôڲ֧
+uint8_t  RUN_uart_tx_dma_init(UART_PIN_enum uart_pin, RUN_uart_tx_callback_t callback);
+
+// 㿽Ŷӷͣأbuff ڻص֮ǰ뱣Ч 1 Ŷ / 0 δʼ
+uint8_t  RUN_uart_write_async(UART_PIN_enum uart_pin, const uint8_t* buff, uint16_t len);
+
+// ͻ (ʱȴڳռ)δ DMA ʱ˻Ϊ
+void     RUN_uart_write_buffered(UART_PIN_enum uart_pin, const uint8_t* buff, uint16_t len);
+
+// ѯ / ȴbusy=1 ʾû DMA ꣻflush ȵһλƳ TX 
+uint8_t  RUN_uart_tx_busy(UART_PIN_enum uart_pin);
+// ͻʣռ (ֽ)δ DMA ʱ 0xFFFF (ͣд)
+uint16_t RUN_uart_tx_room(UART_PIN_enum uart_pin);
+void     RUN_uart_tx_flush(UART_PIN_enum uart_pin);
+
+// --- 5. DMA ѭ (IDLE ֡) ---
+// USART1_RX = DMA1 ͨ5USART2_RX = DMA1 ͨ6USART3_RX = DMA1 ͨ3UART4_RX = DMA2 ͨ3
+// DMA һֱλдֻ (HT) / дһȦ(TC) / ·(IDLE) ʱŽһжϣ
+// ""ѭѭ
+// ע⣺DMA1 ͨ5  TIM1_UPDMA2 ͨ3  TIM6_UP ã߲ͬʱ DMA
+
+// ݷʱ (жִУΪ NULL)available Ϊǰɶֽ
+typedef void (*RUN_uart_rx_callback_t)(UART_PIN_enum uart_pin, uint16_t available);
+
+//  DMA  ( RUN_uart_init ֮)ring ɵṩ 1 ɹ / 0 ôڲ֧
+uint8_t  RUN_uart_rx_dma_init(UART_PIN_enum uart_pin, uint8_t* ring, uint16_t size, RUN_uart_rx_callback_t callback);
+
+// ѭȡavailable ɶֽread peek/consume 㿽 (peek ػһ)
+uint16_t RUN_uart_rx_available(UART_PIN_enum uart_pin);
+uint16_t RUN_uart_rx_read(UART_PIN_enum uart_pin, uint8_t* buff, uint16_t max);
+uint16_t RUN_uart_rx_peek(UART_PIN_enum uart_pin, const uint8_t** data);
+void     RUN_uart_rx_consume(UART_PIN_enum uart_pin, uint16_t len);
+
+// ѭ DMA Ƕֽ
+uint32_t RUN_uart_rx_overrun(UART_PIN_enum uart_pin);
+
+// USARTx_IRQHandler еã IDLE ¼ (δ DMA ʱʲôҲ)
+void     RUN_uart_rx_dma_irq(USART_TypeDef* UARTx);
+
 #endif
\ No newline at end of file
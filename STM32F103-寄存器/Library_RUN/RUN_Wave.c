@@ -0,0 +1,154 @@
+#include "RUN_Wave.h"
+
+//
+// ͨ·TIMx ¼ --(DMA )--> DMA ͨ --(AHB/APB2)--> GPIOx->BSRR
+// ÿֵʱֻȡڶʱ CPU ǷæжǷ޹ء
+
+// ==============================================================================
+// ڲ
+// ==============================================================================
+
+//-------------------------------------------------------------------------------------------------------------------
+// ڲDMA жϻص (ctx Ϊζ)
+//-------------------------------------------------------------------------------------------------------------------
+static void wave_dma_callback(uint8_t flags, void* ctx)
+{
+    RUN_wave_t* wave = (RUN_wave_t*)ctx;
+
+    if (flags & RUN_DMA_IT_HT)
+    {
+        if (wave->callback) wave->callback(wave, RUN_WAVE_HALF);
+    }
+
+    if (flags & (RUN_DMA_IT_TC | RUN_DMA_IT_TE))
+    {
+        if (wave->mode == RUN_DMA_MODE_NORMAL || (flags & RUN_DMA_IT_TE))
+        {
+            // ģʽ (ߴ)ͣĺ DMAͨԹ鱾 (RUN_wave_deinit ͷ)
+            RUN_wave_stop(wave);
+        }
+        if (wave->callback) wave->callback(wave, RUN_WAVE_DONE);
+    }
+}
+
+// ==============================================================================
+// ӿں
+// ==============================================================================
+
+//-------------------------------------------------------------------------------------------------------------------
+//       ʼ DMA η
+// ˵      wave            ζ
+// ˵      tim_n           Ķʱ
+// ˵      port            ˿ (GPIOA ~ GPIOG)
+// ˵      rate_hz          (/)
+// ز      uint32_t        ʵ (Hz)ʧ ( / DMA ͨռ)  0
+// ʹʾ      RUN_wave_init(&wave, RUN_TIM6, GPIOB, 1000000); // 1MHz  PB 
+// עϢ      1. ʱ¼ DMA ͨĶӦϵ timer_cfg[]
+//                  TIM1->DMA1_CH5  TIM2->DMA1_CH2  TIM3->DMA1_CH3  TIM4->DMA1_CH7
+//                  TIM5->DMA2_CH2  TIM6->DMA2_CH3  TIM7->DMA2_CH4  TIM8->DMA2_CH1
+//               2. ʼʱ RUN_DMA_Alloc ռø DMA ͨѱ/ADC ռʧ
+//               3. 72MHz  DMA д APB2 Լ 5~6 һΣʵԼ 6~8MHz
+//               4. ʧʱ wave->dma Ϊ NULL֮ start / stop / deinit ֱӷ
+//-------------------------------------------------------------------------------------------------------------------
+uint32_t RUN_wave_init(RUN_wave_t* wave, RUN_TIM_enum tim_n, GPIO_TypeDef* port, uint32_t rate_hz)
+{
+    wave->dma      = 0;
+    wave->busy     = 0;
+    wave->rate_hz  = 0;
+    if (tim_n >= RUN_TIM_MAX || port == 0) return 0;
+
+    wave->tim      = tim_n;
+    wave->dma      = RUN_DMA_Alloc(timer_cfg[tim_n].up_req);
+    if (wave->dma == 0) return 0;
+
+    wave->port     = port;
+    wave->mode     = RUN_DMA_MODE_NORMAL;
+    wave->callback = 0;
+    wave->rate_hz  = RUN_timer_init_freq(tim_n, rate_hz);
+    if (wave->rate_hz == 0)
+    {
+        RUN_DMA_Free(wave->dma, timer_cfg[tim_n].up_req);   // ʲɴҪһֱռͨ
+        wave->dma = 0;
+    }
+
+    return wave->rate_hz;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       ʼ
+// ˵      wave            ζ
+// ˵      bsrr_buf        BSRR 
+// ˵      len             
+// ˵      mode             / ѭ
+// ˵      callback        /ɻص (Ϊ NULL)
+// ز      void
+// ʹʾ      static const uint32_t pulse[4] = {
+//                   RUN_WAVE_WORD(GPIO_Pin_0, 0), RUN_WAVE_WORD(0, GPIO_Pin_0),
+//                   RUN_WAVE_WORD(GPIO_Pin_1, 0), RUN_WAVE_WORD(0, GPIO_Pin_1)};
+//               RUN_wave_start(&wave, pulse, 4, RUN_DMA_MODE_CIRCULAR, NULL);
+// עϢ      1. һĵһ¼ (һ֮) 
+//               2. ѭģʽ¿ RUN_WAVE_HALF ʱдǰΡRUN_WAVE_DONE ʱдΣʵ޷
+//-------------------------------------------------------------------------------------------------------------------
+void RUN_wave_start(RUN_wave_t* wave, const uint32_t* bsrr_buf, uint16_t len,
+                    RUN_DMA_Mode_t mode, RUN_wave_callback_t callback)
+{
+    TIM_TypeDef* TIMx;
+
+    if (wave->dma == 0 || len == 0) return;
+    TIMx = timer_cfg[wave->tim].tim_base;
+
+    // 1. ͣ¿ڽе
+    RUN_wave_stop(wave);
+
+    wave->mode     = mode;
+    wave->callback = callback;
+
+    // 2. DMAڴ -> BSRR32 λλѭ
+    RUN_DMA_Config(wave->dma, (uint32_t)&wave->port->BSRR, (uint32_t)bsrr_buf, len,
+                   RUN_DMA_DIR_M2P, RUN_DMA_WIDTH_32BIT, mode);
+    RUN_DMA_SetCallback(wave->dma,
+                        (callback ? RUN_DMA_IT_HT : 0) | RUN_DMA_IT_TC | RUN_DMA_IT_TE,
+                        wave_dma_callback, wave, 1, 0);
+
+    // 3. ʱ㣬򿪸¼ DMA 
+    TIMx->CNT   = 0;
+    TIMx->SR   &= ~TIM_SR_UIF;
+    TIMx->DIER |= TIM_DIER_UDE;
+
+    wave->busy = 1;
+    RUN_DMA_Enable(wave->dma);
+    RUN_timer_cmd(wave->tim, ENABLE);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       ֹͣ
+// ˵      wave            ζ
+// ز      void
+// עϢ      űһдĵƽ
+//-------------------------------------------------------------------------------------------------------------------
+void RUN_wave_stop(RUN_wave_t* wave)
+{
+    TIM_TypeDef* TIMx;
+
+    if (wave->dma == 0) return;
+    TIMx = timer_cfg[wave->tim].tim_base;
+
+    RUN_timer_cmd(wave->tim, DISABLE);
+    TIMx->DIER &= ~TIM_DIER_UDE;
+    RUN_DMA_Disable(wave->dma);
+    wave->busy = 0;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       ֹͣͷ DMA ͨ
+// ˵      wave            ζ
+// ز      void
+// עϢ      ֮ RUN_wave_init
+//-------------------------------------------------------------------------------------------------------------------
+void RUN_wave_deinit(RUN_wave_t* wave)
+{
+    if (wave->dma == 0) return;
+    RUN_wave_stop(wave);
+    RUN_DMA_Free(wave->dma, timer_cfg[wave->tim].up_req);
+    wave->dma = 0;
+}
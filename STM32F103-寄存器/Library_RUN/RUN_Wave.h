@@ -0,0 +1,68 @@
+#ifndef _RUN_WAVE_H_
+#define _RUN_WAVE_H_
+
+#include "stm32f10x.h"
+#include "RUN_Timer.h"
+#include "RUN_DMA.h"
+
+// ==========================================================
+// DMA ֲη
+// ----------------------------------------------------------
+// ʱÿһθ¼DMA Ͱѻһ 32 λ
+// д GPIOx->BSRR 16 λλ 16 λλ
+// ˿ڵ϶̶ܰķתCPU ÿء
+// ==========================================================
+
+// ƴһ BSRR ֣set еøߣreset еõͣ಻
+#define RUN_WAVE_WORD(set, reset)   (((uint32_t)(uint16_t)(reset) << 16) | (uint16_t)(set))
+
+// ص¼
+typedef enum {
+    RUN_WAVE_HALF = 0,   // ǰѲ (Ըдǰ)
+    RUN_WAVE_DONE = 1    // Ѳ (ģʽֹͣѭģʽԸд)
+} RUN_wave_event_t;
+
+typedef struct RUN_wave_s RUN_wave_t;
+typedef void (*RUN_wave_callback_t)(RUN_wave_t* wave, RUN_wave_event_t event);
+
+// η (ɵṩ洢ֶֻ)
+struct RUN_wave_s {
+    RUN_TIM_enum         tim;        // Ķʱ
+    DMA_Channel_TypeDef* dma;        // öʱ¼Ӧ DMA ͨ
+    GPIO_TypeDef*        port;       // ˿
+    uint32_t             rate_hz;    // ʵ (/)
+    RUN_DMA_Mode_t       mode;       //  / ѭ
+    RUN_wave_callback_t  callback;   // /ɻص (жִУΪ NULL)
+    volatile uint8_t     busy;       // 1: 
+};
+
+// ==========================================================
+// 
+// ==========================================================
+
+/**
+ * @brief  ʼη (ֻöʱ)
+ * @param  tim_n:   Ķʱ ( DMA ûͻͨƼ RUN_TIM6 / RUN_TIM7)
+ * @param  port:    ˿ ( GPIOB)Ϊ
+ * @param  rate_hz: ÿٸ
+ * @return ʵ (Hz)ʧܷ 0 (wave->dma Ϊ NULLstart / stop κ)
+ */
+uint32_t RUN_wave_init(RUN_wave_t* wave, RUN_TIM_enum tim_n, GPIO_TypeDef* port, uint32_t rate_hz);
+
+/**
+ * @brief  ʼ
+ * @param  bsrr_buf: BSRR  ( RUN_WAVE_WORD )ڼ뱣Ч
+ * @param  len:       (1 ~ 65535)
+ * @param  mode:     RUN_DMA_MODE_NORMAL  / RUN_DMA_MODE_CIRCULAR ѭ
+ * @param  callback: /ɻصΪ NULL
+ */
+void RUN_wave_start(RUN_wave_t* wave, const uint32_t* bsrr_buf, uint16_t len,
+                    RUN_DMA_Mode_t mode, RUN_wave_callback_t callback);
+
+// ֹͣ (űһֵ״̬)
+void RUN_wave_stop(RUN_wave_t* wave);
+
+// ֹͣͷ DMA ͨ
+void RUN_wave_deinit(RUN_wave_t* wave);
+
+#endif
@@ -9,7 +9,13 @@
 #include "misc.h" // NVICñ
 #include "math.h"
 
+/*  gcc  (Host/ ) ʱ Keil  __weak ؼ */
+#if defined(__GNUC__) && !defined(__CC_ARM) && !defined(__weak)
+#define __weak __attribute__((weak))
+#endif
+
 /* 2. ٰԼģ */
+#include "RUN_Clock.h"
 #include "RUN_Gpio.h"
 #include "RUN_UART.h"
 #include "RUN_Isr.h" 
@@ -19,11 +25,20 @@
 #include "RUN_Exti.h"
 #include "RUN_SoftI2C.h"
 #include "RUN_ADC.h"
+#include "RUN_ADC_Cal.h"
 #include "RUN_DAC.h"
 #include "RUN_Flash.h"
 #include "RUN_SPI.h"
 #include "RUN_OneWire.h"
 #include "RUN_DMA.h"
+#include "RUN_Copy.h"
+#include "RUN_Stream.h"
+#include "RUN_Wave.h"
+#include "RUN_Logic.h"
+#include "RUN_Key.h"
+#include "RUN_Frame.h"
+#include "RUN_Log.h"
+#include "RUN_Fmt.h"
 #include "RUN_CAN.h"
 
 #include "RUN_MPU6050.h"
@@ -36,4 +51,5 @@
 
 #include "RUN_IMU_GetAngle.h"
 #include "RUN_PID.h"
+#include "RUN_Oversample.h"
 #endif
\ No newline at end of file
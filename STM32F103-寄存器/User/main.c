@@ -21,17 +21,18 @@ a=RUN_W25Q_ReadID();
 		RUN_delay_ms(1);
 		if(b>=10000)b=0;
 		RUN_pwm_set(PWM_TIM3_CH3_PB0,b);
-    if (UART1_RxFlag == 1)
+    char* cmd = RUN_uart_packet_get(UART1_TX_PA9_RX_PA10, NULL);
+    if (cmd != NULL)
         {
 					
             // --- յ ---
 
             // 1. ͻ (ԭȥ)
-            printf("Received: %s\r\n", UART1_RxPacket);
+            printf("Received: %s\r\n", cmd);
             
             
-            // --- ϣ־λһ ---
-            UART1_RxFlag = 0; 
+            // --- ϣ黹ۣһ ---
+            RUN_uart_packet_release(UART1_TX_PA9_RX_PA10); 
         }
 				 printf("%d\r\n", a);
 	}